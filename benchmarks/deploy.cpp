@@ -0,0 +1,123 @@
+#include <deployr/deployr.hpp>
+#include <hicr/backends/mpi/instanceManager.hpp>
+#include <hicr/backends/mpi/communicationManager.hpp>
+#include <hicr/backends/mpi/memoryManager.hpp>
+#include <hicr/frontends/RPCEngine/RPCEngine.hpp>
+#include <hicr/backends/hwloc/topologyManager.hpp>
+#include <hicr/backends/pthreads/computeManager.hpp>
+#include "generator.hpp"
+#include "reporter.hpp"
+
+// Number of times each topology gathering mode is measured
+constexpr size_t gatherRepetitions = 10;
+
+// Parses the launch mode given on the command line
+deployr::DeployR::launchMode_t parseLaunchMode(const std::string &launchModeName)
+{
+  if (launchModeName == "serial") return deployr::DeployR::launchMode_t::serialLaunch;
+  if (launchModeName == "batched") return deployr::DeployR::launchMode_t::batchedLaunch;
+  if (launchModeName == "tree") return deployr::DeployR::launchMode_t::treeLaunch;
+
+  fprintf(stderr, "Error: unknown launch mode '%s'. Use serial, batched or tree.\n", launchModeName.c_str());
+  exit(-1);
+}
+
+int main(int argc, char *argv[])
+{
+  // Getting MPI managers
+  auto instanceManager      = HiCR::backend::mpi::InstanceManager::createDefault(&argc, &argv);
+  auto communicationManager = std::make_shared<HiCR::backend::mpi::CommunicationManager>();
+  auto memoryManager        = std::make_shared<HiCR::backend::mpi::MemoryManager>();
+
+  // Getting the launch mode to measure
+  const auto launchModeName = std::string(argc > 1 ? argv[1] : "serial");
+  const auto launchMode     = parseLaunchMode(launchModeName);
+
+  // Using the first compute resource and memory space of the actual host for the RPC engine
+  hwloc_topology_t hwlocTopology;
+  hwloc_topology_init(&hwlocTopology);
+  HiCR::backend::hwloc::TopologyManager tm(&hwlocTopology);
+  const auto                            hostTopology      = tm.queryTopology();
+  auto                                  device            = *hostTopology.getDevices().begin();
+  auto                                  bufferMemorySpace = *device->getMemorySpaceList().begin();
+  auto                                  computeResource   = *device->getComputeResourceList().begin();
+
+  HiCR::backend::pthreads::ComputeManager computeManager;
+  HiCR::frontend::RPCEngine               rpcEngine(*communicationManager, *instanceManager, *memoryManager, computeManager, bufferMemorySpace, computeResource);
+  rpcEngine.initialize();
+
+  // Getting the participating instances, in the order the gathered topologies are returned in
+  std::vector<HiCR::Instance::instanceId_t> instanceIds;
+  for (const auto &instance : instanceManager->getInstances()) instanceIds.push_back(instance->getId());
+  const auto instanceCount = instanceIds.size();
+  const auto currentIdx    = std::find(instanceIds.begin(), instanceIds.end(), instanceManager->getCurrentInstance()->getId()) - instanceIds.begin();
+
+  // Every instance poses as a synthetic host. The cluster only depends on its size, so that the root can generate the matching runner requests
+  deployr::benchmark::TopologyGenerator generator(instanceCount);
+  const auto                            hostSkus      = generator.generateHostSkus(instanceCount);
+  const auto                            localTopology = HiCR::Topology(deployr::benchmark::TopologyGenerator::makeTopology(generator.getSkus()[hostSkus[currentIdx]]));
+
+  // Creating deployr object
+  deployr::DeployR deployr(instanceManager.get(), &rpcEngine, localTopology);
+  deployr.initialize();
+  deployr.registerFunction("Bench", []() {});
+
+  const bool     isRootInstance = instanceManager->getCurrentInstance()->isRootInstance();
+  const auto     rootInstanceId = instanceManager->getRootInstanceId();
+  nlohmann::json parameters     = {{"Instances", instanceCount}};
+
+  // Gathering the global topology in every mode
+  std::vector<HiCR::Topology> globalTopology;
+  for (const auto &[mode, modeName] : {std::pair{deployr::DeployR::topologyGatherMode_t::serial, "serial"},
+                                       std::pair{deployr::DeployR::topologyGatherMode_t::pipelined, "pipelined"},
+                                       std::pair{deployr::DeployR::topologyGatherMode_t::tree, "tree"}})
+  {
+    const auto timing = deployr::benchmark::measureRepetitions([&]() { globalTopology = deployr.gatherGlobalTopology(rootInstanceId, instanceIds, mode); }, gatherRepetitions);
+    parameters["Mode"] = modeName;
+    if (isRootInstance) deployr::benchmark::report("Gather Topology", parameters, timing);
+  }
+
+  // Matching and building the deployment at the coordinator
+  deployr::Deployment deployment;
+  if (isRootInstance)
+  {
+    const auto          requested = deployr::benchmark::TopologyGenerator::toTopologies(generator.generateRequests(hostSkus));
+    std::vector<size_t> matching;
+    const auto          matchingTiming = deployr::benchmark::measure([&]() { matching = deployr::DeployR::doWeightedMatching(requested, globalTopology); });
+    parameters.erase("Mode");
+    deployr::benchmark::report("Match", parameters, matchingTiming);
+
+    if (matching.size() != requested.size())
+    {
+      fprintf(stderr, "Error: no matching found for the synthetic runners.\n");
+      instanceManager->abort(-1);
+    }
+
+    deployment.reserve(requested.size());
+    for (size_t i = 0; i < matching.size(); i++) deployment.emplaceRunner(i, "Bench", instanceIds[matching[i]]);
+  }
+
+  // Deploying and waiting for all runners to complete
+  const auto deployTiming = deployr::benchmark::measureRepetitions(
+    [&]() {
+      deployr.deploy(deployment, rootInstanceId, launchMode);
+      deployr.finalize();
+    },
+    1);
+
+  if (isRootInstance)
+  {
+    const auto &statistics = deployr.getLaunchStatistics();
+
+    parameters["Launch Mode"]          = launchModeName;
+    parameters["Runners"]              = statistics.runnerCount;
+    parameters["Tree Depth"]           = statistics.treeDepth;
+    parameters["Coordinator Messages"] = statistics.coordinatorMessageCount;
+    parameters["Dispatch Time"]        = statistics.coordinatorDispatchTime;
+    parameters["Estimated Skew"]       = statistics.estimatedLaunchSkew;
+    deployr::benchmark::report("Deploy", parameters, deployTiming);
+  }
+
+  // Finalizing instance manager
+  instanceManager->finalize();
+}
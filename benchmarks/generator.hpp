@@ -0,0 +1,203 @@
+#pragma once
+
+#include <hicr/core/topology.hpp>
+#include <nlohmann_json/json.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace deployr::benchmark
+{
+
+/**
+ * Describes a kind of node found in a cluster (a stock-keeping unit), from which synthetic host topologies are generated
+ */
+struct sku_t
+{
+  /// Name of the node kind
+  std::string name;
+
+  /// Number of NUMA domains
+  size_t numaDomainCount;
+
+  /// Number of processing units per NUMA domain
+  size_t coresPerDomain;
+
+  /// RAM size (in bytes) per NUMA domain
+  size_t ramPerDomain;
+
+  /// Number of GPUs
+  size_t gpuCount;
+
+  /// HBM size (in bytes) per GPU
+  size_t hbmPerGpu;
+
+  /// Relative frequency of this node kind in the cluster
+  double weight;
+};
+
+/**
+ * Gets a heterogeneous mix of node kinds, loosely modelled after a typical HPC / cloud cluster
+ *
+ * @return The node kinds
+ */
+inline std::vector<sku_t> getDefaultSkus()
+{
+  constexpr size_t GiB = 1024ul * 1024ul * 1024ul;
+  return {
+    {"cpu-small", 1, 16, 64 * GiB, 0, 0, 4.0},
+    {"cpu-large", 2, 32, 256 * GiB, 0, 0, 3.0},
+    {"memory", 4, 16, 1024 * GiB, 0, 0, 1.0},
+    {"gpu", 2, 24, 256 * GiB, 4, 80 * GiB, 2.0},
+  };
+}
+
+/**
+ * Generates synthetic host topologies, and runner requests that are guaranteed to fit them. The output only depends on the seed
+ */
+class TopologyGenerator final
+{
+  public:
+
+  /**
+   * Constructor for the generator
+   *
+   * @param[in] seed The seed of the pseudo-random generator
+   * @param[in] skus The node kinds to draw hosts from
+   */
+  TopologyGenerator(const uint64_t seed, std::vector<sku_t> skus = getDefaultSkus())
+    : _random(seed),
+      _skus(std::move(skus))
+  {}
+
+  /**
+   * Serializes a topology with the given shape
+   *
+   * @param[in] numaDomainCount Number of NUMA domains
+   * @param[in] coresPerDomain Number of processing units per NUMA domain
+   * @param[in] ramPerDomain RAM size (in bytes) per NUMA domain
+   * @param[in] gpuCount Number of GPUs
+   * @param[in] hbmPerGpu HBM size (in bytes) per GPU
+   *
+   * @return The JSON-encoded topology
+   */
+  static nlohmann::json makeTopology(const size_t numaDomainCount, const size_t coresPerDomain, const size_t ramPerDomain, const size_t gpuCount, const size_t hbmPerGpu)
+  {
+    auto devices = nlohmann::json::array();
+    for (size_t d = 0; d < numaDomainCount; d++)
+    {
+      auto computeResources = nlohmann::json::array();
+      for (size_t c = 0; c < coresPerDomain; c++) computeResources.push_back({{"Type", "Processing Unit"}});
+      devices.push_back({{"Type", "NUMA Domain"}, {"Compute Resources", computeResources}, {"Memory Spaces", nlohmann::json::array({{{"Type", "RAM"}, {"Size", ramPerDomain}}})}});
+    }
+    for (size_t g = 0; g < gpuCount; g++)
+      devices.push_back({{"Type", "GPU"},
+                         {"Compute Resources", nlohmann::json::array({{{"Type", "GPU Processing Unit"}}})},
+                         {"Memory Spaces", nlohmann::json::array({{{"Type", "HBM"}, {"Size", hbmPerGpu}}})}});
+    return {{"Devices", devices}};
+  }
+
+  /**
+   * Serializes the topology of a node kind
+   *
+   * @param[in] sku The node kind
+   *
+   * @return The JSON-encoded topology
+   */
+  static nlohmann::json makeTopology(const sku_t &sku) { return makeTopology(sku.numaDomainCount, sku.coresPerDomain, sku.ramPerDomain, sku.gpuCount, sku.hbmPerGpu); }
+
+  /**
+   * Draws a node kind at random, according to their weights
+   *
+   * @return The index of the node kind
+   */
+  size_t drawSku()
+  {
+    std::vector<double> weights;
+    for (const auto &sku : _skus) weights.push_back(sku.weight);
+    return std::discrete_distribution<size_t>(weights.begin(), weights.end())(_random);
+  }
+
+  /**
+   * Generates the node kinds of a cluster of hosts
+   *
+   * @param[in] hostCount The number of hosts
+   *
+   * @return The index of the node kind of each host
+   */
+  std::vector<size_t> generateHostSkus(const size_t hostCount)
+  {
+    std::vector<size_t> hostSkus;
+    for (size_t i = 0; i < hostCount; i++) hostSkus.push_back(drawSku());
+    return hostSkus;
+  }
+
+  /**
+   * Generates one runner request per host, each of which fits (is a subset of) a different host, so that a perfect matching exists.
+   * Requests shrink their host's shape by powers of two, so that they fall into a limited number of distinct shapes, as in real workloads.
+   *
+   * @param[in] hostSkus The node kind of each host
+   *
+   * @return The JSON-encoded topology of each request, in random order with respect to the hosts
+   */
+  std::vector<nlohmann::json> generateRequests(const std::vector<size_t> &hostSkus)
+  {
+    std::vector<size_t> order(hostSkus.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::shuffle(order.begin(), order.end(), _random);
+
+    std::vector<nlohmann::json> requests;
+    for (const auto hostIdx : order)
+    {
+      const auto &sku         = _skus[hostSkus[hostIdx]];
+      const auto  domainCount = std::max<size_t>(1, sku.numaDomainCount >> drawShift(2));
+      const auto  coreCount   = std::max<size_t>(1, sku.coresPerDomain >> drawShift(4));
+      const auto  ramSize     = sku.ramPerDomain >> drawShift(3);
+      const auto  gpuCount    = sku.gpuCount >> drawShift(2);
+      requests.push_back(makeTopology(domainCount, coreCount, ramSize, gpuCount, sku.hbmPerGpu));
+    }
+    return requests;
+  }
+
+  /**
+   * Converts serialized topologies into HiCR topologies
+   *
+   * @param[in] serializedTopologies The JSON-encoded topologies
+   *
+   * @return The topologies
+   */
+  static std::vector<HiCR::Topology> toTopologies(const std::vector<nlohmann::json> &serializedTopologies)
+  {
+    std::vector<HiCR::Topology> topologies;
+    for (const auto &serializedTopology : serializedTopologies) topologies.push_back(HiCR::Topology(serializedTopology));
+    return topologies;
+  }
+
+  /**
+   * Gets the node kinds hosts are drawn from
+   *
+   * @return The node kinds
+   */
+  const std::vector<sku_t> &getSkus() const { return _skus; }
+
+  private:
+
+  /**
+   * Draws a shift amount, uniformly between 0 and maxShift
+   *
+   * @param[in] maxShift The largest shift
+   *
+   * @return The shift amount
+   */
+  size_t drawShift(const size_t maxShift) { return std::uniform_int_distribution<size_t>(0, maxShift)(_random); }
+
+  /// The pseudo-random generator
+  std::mt19937_64 _random;
+
+  /// The node kinds hosts are drawn from
+  const std::vector<sku_t> _skus;
+
+}; // class TopologyGenerator
+
+} // namespace deployr::benchmark
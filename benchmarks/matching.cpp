@@ -0,0 +1,51 @@
+#include <deployr/deployr.hpp>
+#include "generator.hpp"
+#include "reporter.hpp"
+
+// Largest problem the Hopcroft-Karp matcher is measured on, since its compatibility graph grows quadratically with the number of runners and hosts
+constexpr size_t maxBipartiteSize = 10000;
+
+// Measures a matching algorithm on a problem, checking that it finds the perfect matching the generator guarantees
+void measureMatching(const std::string                                                                                  &benchmark,
+                     const std::function<std::vector<size_t>(const std::vector<HiCR::Topology> &, const std::vector<HiCR::Topology> &)> &matcher,
+                     const std::vector<HiCR::Topology>                                                                  &requested,
+                     const std::vector<HiCR::Topology>                                                                  &given,
+                     const size_t                                                                                        size)
+{
+  std::vector<size_t> matching;
+  const auto          timing = deployr::benchmark::measure([&]() { matching = matcher(requested, given); }, 0.5, 100);
+
+  if (matching.size() != requested.size())
+  {
+    fprintf(stderr, "Error: %s did not find a matching for %lu runners\n", benchmark.c_str(), size);
+    exit(-1);
+  }
+
+  deployr::benchmark::report(benchmark, {{"Hosts", given.size()}, {"Runners", requested.size()}}, timing);
+}
+
+int main(int argc, char *argv[])
+{
+  // Problem sizes (number of hosts, and of runners) can be given on the command line
+  const auto sizes = deployr::benchmark::parseSizes(argc, argv, {10, 100, 1000, 10000, 100000});
+
+  for (const auto size : sizes)
+  {
+    // Generating a heterogeneous cluster, and a set of runners that fits it exactly
+    deployr::benchmark::TopologyGenerator generator(size);
+    const auto                            hostSkus  = generator.generateHostSkus(size);
+    const auto                            requested = deployr::benchmark::TopologyGenerator::toTopologies(generator.generateRequests(hostSkus));
+
+    std::vector<nlohmann::json> serializedHosts;
+    for (const auto skuIdx : hostSkus) serializedHosts.push_back(deployr::benchmark::TopologyGenerator::makeTopology(generator.getSkus()[skuIdx]));
+    const auto given = deployr::benchmark::TopologyGenerator::toTopologies(serializedHosts);
+
+    if (size <= maxBipartiteSize)
+      measureMatching("Bipartite Matching", [](const auto &r, const auto &g) { return deployr::DeployR::doBipartiteMatching(r, g); }, requested, given, size);
+    measureMatching("Equivalence Class Matching", &deployr::DeployR::doEquivalenceClassMatching, requested, given, size);
+    measureMatching("Weighted Matching", &deployr::DeployR::doWeightedMatching, requested, given, size);
+    measureMatching("Packing Matching", &deployr::DeployR::doPackingMatching, requested, given, size);
+  }
+
+  return 0;
+}
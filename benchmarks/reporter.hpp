@@ -0,0 +1,107 @@
+#pragma once
+
+#include <nlohmann_json/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace deployr::benchmark
+{
+
+/**
+ * Timing of a repeatedly measured operation
+ */
+struct timing_t
+{
+  /// Number of repetitions measured
+  size_t repetitions;
+
+  /// Fastest repetition (in seconds)
+  double minTime;
+
+  /// Median repetition (in seconds)
+  double medianTime;
+
+  /// Average repetition (in seconds)
+  double meanTime;
+};
+
+/**
+ * Measures an operation repeatedly, until it has run for at least a minimum total time or a maximum number of repetitions.
+ *
+ * @param[in] operation The operation to measure
+ * @param[in] minTotalTime The minimum total time (in seconds) to run for
+ * @param[in] maxRepetitions The maximum number of repetitions
+ *
+ * @return The timing of the operation
+ */
+inline timing_t measure(const std::function<void()> &operation, const double minTotalTime = 0.5, const size_t maxRepetitions = 1000)
+{
+  std::vector<double> times;
+  double              totalTime = 0.0;
+  while (times.empty() || (totalTime < minTotalTime && times.size() < maxRepetitions))
+  {
+    const auto startTime = std::chrono::steady_clock::now();
+    operation();
+    times.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+    totalTime += times.back();
+  }
+
+  std::sort(times.begin(), times.end());
+  return {times.size(), times.front(), times[times.size() / 2], totalTime / (double)times.size()};
+}
+
+/**
+ * Measures an operation a fixed number of times. This is required for collective operations, which all instances must run the same number of times
+ *
+ * @param[in] operation The operation to measure
+ * @param[in] repetitions The number of repetitions
+ *
+ * @return The timing of the operation
+ */
+inline timing_t measureRepetitions(const std::function<void()> &operation, const size_t repetitions)
+{
+  return measure(operation, std::numeric_limits<double>::infinity(), repetitions);
+}
+
+/**
+ * Writes a benchmark result as a single JSON line on the standard output, so that results can be collected and compared by scripts
+ *
+ * @param[in] benchmark The name of the benchmark
+ * @param[in] parameters The parameters of the measurement (e.g., input sizes), which are copied into the result
+ * @param[in] timing The timing of the measurement
+ */
+inline void report(const std::string &benchmark, const nlohmann::json &parameters, const timing_t &timing)
+{
+  nlohmann::json result = parameters;
+  result["Benchmark"]   = benchmark;
+  result["Repetitions"] = timing.repetitions;
+  result["Min Time"]    = timing.minTime;
+  result["Median Time"] = timing.medianTime;
+  result["Mean Time"]   = timing.meanTime;
+  printf("%s\n", result.dump().c_str());
+  fflush(stdout);
+}
+
+/**
+ * Parses input sizes from the command line, or returns a default set of sizes if none are given
+ *
+ * @param[in] argc The number of command line arguments
+ * @param[in] argv The command line arguments
+ * @param[in] defaultSizes The sizes to use if none are given
+ *
+ * @return The sizes
+ */
+inline std::vector<size_t> parseSizes(const int argc, char *argv[], const std::vector<size_t> &defaultSizes)
+{
+  if (argc < 2) return defaultSizes;
+  std::vector<size_t> sizes;
+  for (int i = 1; i < argc; i++) sizes.push_back(std::stoul(argv[i]));
+  return sizes;
+}
+
+} // namespace deployr::benchmark
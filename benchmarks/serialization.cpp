@@ -0,0 +1,72 @@
+#include <deployr/deployr.hpp>
+#include <deployr/deploymentLoader.hpp>
+#include <deployr/wireFormat.hpp>
+#include <sstream>
+#include "generator.hpp"
+#include "reporter.hpp"
+
+// Measures encoding and decoding a set of host topologies in the given wire format, as exchanged during the topology gathering
+void measureTopologyExchange(const std::vector<nlohmann::json> &serializedHosts, const deployr::WireFormat::encoding_t encoding, const std::string &encodingName)
+{
+  // Wrapping the topologies as a subtree reply, which is the largest message exchanged
+  const nlohmann::json message = {{"Topologies", serializedHosts}};
+
+  std::string encodedMessage;
+  const auto  encodeTiming = deployr::benchmark::measure([&]() { encodedMessage = deployr::WireFormat::encode(message, encoding); });
+  deployr::benchmark::report("Topology Encode", {{"Hosts", serializedHosts.size()}, {"Encoding", encodingName}, {"Bytes", encodedMessage.size()}}, encodeTiming);
+
+  const auto decodeTiming = deployr::benchmark::measure([&]() {
+    const auto decodedMessage = deployr::WireFormat::decode(encodedMessage.data(), encodedMessage.size(), encoding);
+    if (decodedMessage["Topologies"].size() != serializedHosts.size()) exit(-1);
+  });
+  deployr::benchmark::report("Topology Decode", {{"Hosts", serializedHosts.size()}, {"Encoding", encodingName}, {"Bytes", encodedMessage.size()}}, decodeTiming);
+}
+
+int main(int argc, char *argv[])
+{
+  // Problem sizes (number of hosts, and of runners) can be given on the command line
+  const auto sizes = deployr::benchmark::parseSizes(argc, argv, {10, 100, 1000, 10000, 100000});
+
+  for (const auto size : sizes)
+  {
+    deployr::benchmark::TopologyGenerator generator(size);
+    const auto                            hostSkus = generator.generateHostSkus(size);
+
+    // Host topologies, through the wire formats and into HiCR topologies
+    std::vector<nlohmann::json> serializedHosts;
+    for (const auto skuIdx : hostSkus) serializedHosts.push_back(deployr::benchmark::TopologyGenerator::makeTopology(generator.getSkus()[skuIdx]));
+
+    measureTopologyExchange(serializedHosts, deployr::WireFormat::encoding_t::json, "json");
+    measureTopologyExchange(serializedHosts, deployr::WireFormat::encoding_t::cbor, "cbor");
+
+    const auto topologyTiming = deployr::benchmark::measure([&]() {
+      const auto topologies = deployr::benchmark::TopologyGenerator::toTopologies(serializedHosts);
+      if (topologies.size() != size) exit(-1);
+    });
+    deployr::benchmark::report("Topology Deserialize", {{"Hosts", size}}, topologyTiming);
+
+    // Deployment file with one runner per host, loaded by the coordinator
+    auto runners = nlohmann::json::array();
+    for (const auto &request : generator.generateRequests(hostSkus)) runners.push_back({{"Function", "Worker"}, {"Topology", request}});
+    const auto manifest = nlohmann::json({{"Runners", std::move(runners)}}).dump();
+
+    const auto loaderTiming = deployr::benchmark::measure([&]() {
+      std::istringstream        stream(manifest);
+      deployr::DeploymentLoader loader;
+      loader.parse(stream);
+      if (loader.getRunnerRequests().size() != size) exit(-1);
+    });
+    deployr::benchmark::report("Manifest Load (Streaming)", {{"Runners", size}, {"Bytes", manifest.size()}}, loaderTiming);
+
+    // Baseline: materializing the whole deployment file and every runner topology
+    const auto domTiming = deployr::benchmark::measure([&]() {
+      const auto                  document = nlohmann::json::parse(manifest);
+      std::vector<HiCR::Topology> topologies;
+      for (const auto &runner : document["Runners"]) topologies.push_back(HiCR::Topology(runner["Topology"]));
+      if (topologies.size() != size) exit(-1);
+    });
+    deployr::benchmark::report("Manifest Load (Document)", {{"Runners", size}, {"Bytes", manifest.size()}}, domTiming);
+  }
+
+  return 0;
+}
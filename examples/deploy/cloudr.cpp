@@ -1,5 +1,6 @@
 #include <fstream>
 #include <deployr/deployr.hpp>
+#include <deployr/deploymentLoader.hpp>
 #include <nlohmann_json/json.hpp>
 #include <hicr/backends/cloudr/instanceManager.hpp>
 #include <hicr/backends/cloudr/communicationManager.hpp>
@@ -7,7 +8,6 @@
 #include <hicr/backends/mpi/memoryManager.hpp>
 #include <hicr/backends/mpi/instanceManager.hpp>
 #include <hicr/backends/hwloc/topologyManager.hpp>
-#include <deployr/deployr.hpp>
 #include "deploy.hpp"
 
 int main(int argc, char *argv[])
@@ -93,56 +93,46 @@ int main(int argc, char *argv[])
   // Initializing CloudR -- this is a bifurcation point. Only the root instance advances now
   cloudrInstanceManager.initialize();
 
-  // For cleanup purposes, remember the newly created instances
-  std::vector<std::shared_ptr<HiCR::Instance>> newInstances;
-
   // Gathering deployment information from json file. This only needs to be done by the deployment coordinator (root, in this case)
   if (instanceManager->getCurrentInstance()->isRootInstance())
   {
     // Reading deployment file
     std::string deploymentFilePath = std::string(argv[1]);
 
-    // Parsing deployment file contents to a JSON object
-    std::ifstream ifs(deploymentFilePath);
-    auto          deploymentJs = nlohmann::json::parse(ifs);
-
-    // Getting requested topologies from the json file
-    for (size_t i = 0; i < deploymentJs["Runners"].size(); i++)
-    {
-      // Getting runner
-      const auto &runner = deploymentJs["Runners"][i];
+    // Streaming the deployment file contents into runner requests
+    deployr::DeploymentLoader deploymentLoader;
+    deploymentLoader.parseFile(deploymentFilePath);
 
-      // Assigning runner topology
-      const auto runnerTopology = HiCR::Topology(runner["Topology"]);
-
-      // Asking cloudr to create new instances based on the topology requirement
-      const auto instanceTemplate = cloudrInstanceManager.createInstanceTemplate(runnerTopology);
-      auto       instance         = cloudrInstanceManager.createInstance(*instanceTemplate);
-
-      // Adding new instances to list of newly created instances
-      newInstances.push_back(instance);
+    // Creating deployr object
+    deployr::DeployR deployr(&cloudrInstanceManager, &rpcEngine, topology);
 
-      // Sanity check
-      if (instance == nullptr)
-      {
-        fprintf(stderr, "Error: Could not create instance with required topology: %s\n", runnerTopology.serialize().dump(2).c_str());
-        instanceManager->abort(-1);
-      }
+    // Getting requested topologies from the json file
+    const auto requestedTopologies = deploymentLoader.getRequestedTopologies();
 
-      // Creating runner
-      deployment.addRunner(deployr::Runner(i, deploymentJs["Runners"][i]["Function"].get<std::string>(), instance->getId()));
+    // Asking cloudr to create all new instances based on the topology requirements. If any of them fails, none is kept.
+    // CloudR shares the MPI engine with the RPC engine, which is not thread-safe, so the instances are created one after the other
+    std::vector<std::shared_ptr<HiCR::Instance>> newInstances;
+    try
+    {
+      newInstances = deployr.provisionInstances(requestedTopologies, 1);
+    }
+    catch (const std::exception &e)
+    {
+      fprintf(stderr, "Error: Could not create the instances with the required topologies: %s\n", e.what());
+      instanceManager->abort(-1);
     }
 
-    // Creating deployr object
-    deployr::DeployR deployr(&cloudrInstanceManager, &rpcEngine, topology);
+    // Creating runners
+    std::vector<HiCR::Instance::instanceId_t> newInstanceIds;
+    for (const auto &instance : newInstances) newInstanceIds.push_back(instance->getId());
+    deploymentLoader.buildDeployment(newInstanceIds, deployment);
 
     // Calling main algorithm driver
     deploy(deployr, deployment, cloudrInstanceManager.getCurrentInstance()->getId());
-  }
 
-  // Reliqushing newly created instances from cloudr
-  if (cloudrInstanceManager.getCurrentInstance()->isRootInstance())
-    for (const auto &instance : newInstances) cloudrInstanceManager.terminateInstance(instance);
+    // Reliqushing newly created instances from cloudr, one after the other as well
+    deployr.terminateInstances(newInstances, 1);
+  }
 
   // Finalizing cloudR
   cloudrInstanceManager.finalize();
@@ -24,4 +24,26 @@ void deploy(deployr::DeployR &deployr, const deployr::Deployment &deployment, co
 
   // Deploying now
   deployr.deploy(deployment, coordinatorInstanceId);
+
+  // Waiting for all runners to finish
+  deployr.finalize();
+}
+
+void deployHierarchical(deployr::DeployR                                 &deployr,
+                        const deployr::Deployment                        &deployment,
+                        const HiCR::Instance::instanceId_t                coordinatorInstanceId,
+                        const std::vector<deployr::DeployR::partition_t> &partitions)
+{
+  // Initializing DeployR
+  deployr.initialize();
+
+  // Registering Functions
+  deployr.registerFunction("LeaderFc", [&]() { leaderFc(deployr); });
+  deployr.registerFunction("WorkerFc", [&]() { workerFc(deployr); });
+
+  // Deploying now, through the partition coordinators
+  deployr.deployHierarchical(deployment, coordinatorInstanceId, partitions)->wait();
+
+  // Waiting for all runners to finish
+  deployr.finalize();
 }
\ No newline at end of file
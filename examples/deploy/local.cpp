@@ -0,0 +1,115 @@
+#include <deployr/deployr.hpp>
+#include <deployr/deploymentLoader.hpp>
+#include <deployr/local/engine.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include "deploy.hpp"
+
+int main(int argc, char *argv[])
+{
+  // Checking arguments
+  if (argc < 3 || argc > 5)
+  {
+    fprintf(stderr, "Error: You need to pass a deployment.json and a cloudr.json file as parameters, optionally followed by the number of instances and the message latency (in microseconds).\n");
+    return -1;
+  }
+
+  // Getting the number of instances to simulate (by default, one per topology in the file) and the latency of their messages
+  const size_t instanceCount = argc > 3 ? std::stoul(argv[3]) : 0;
+  const auto   latency       = std::chrono::microseconds(argc > 4 ? std::stoul(argv[4]) : 0);
+
+  // Creating the local engine, with the topologies of the file repeated as many times as needed
+  deployr::local::Engine engine(deployr::local::Engine::loadTopologies(argv[2], instanceCount));
+  engine.setMessageLatency(latency);
+
+  // Streaming the request file contents into runner requests. The runners are also repeated, so that every simulated instance gets one
+  deployr::DeploymentLoader deploymentLoader;
+  deploymentLoader.parseFile(argv[1]);
+  const auto &runnerRequests = deploymentLoader.getRunnerRequests();
+
+  // Optionally deploying hierarchically, through partitions of this many consecutive instances each, whose first instance coordinates the partition
+  const char  *partitionSizeString = std::getenv("DEPLOYR_PARTITION_SIZE");
+  const size_t partitionSize       = partitionSizeString != nullptr ? std::stoul(partitionSizeString) : 0;
+
+  // Running every simulated instance on its own thread
+  const auto startTime = std::chrono::steady_clock::now();
+  engine.run([&](deployr::local::InstanceManager &instanceManager, deployr::local::RPCEngine &rpcEngine, const HiCR::Topology &topology) {
+    // Creating deployr object
+    deployr::DeployR deployr(&instanceManager, &rpcEngine, topology);
+
+    // Initializing deployr object
+    deployr.initialize();
+
+    // In hierarchical mode, the root only splits the runners among the partitions, which gather the topologies of their instances and match them on their own
+    if (partitionSize > 0)
+    {
+      const auto rootInstanceId = instanceManager.getRootInstanceId();
+
+      std::vector<deployr::DeployR::partition_t> partitions;
+      for (const auto &instance : instanceManager.getInstances())
+      {
+        if (instance->getId() == rootInstanceId) continue;
+        if (partitions.empty() || partitions.back().instanceIds.size() == partitionSize) partitions.push_back({instance->getId(), {}});
+        partitions.back().instanceIds.push_back(instance->getId());
+      }
+
+      // Creating the runners, one per instance besides the root, with their requested topologies. Their instances are decided by the partitions
+      deployr::Deployment deployment;
+      if (instanceManager.getCurrentInstance()->isRootInstance())
+      {
+        for (const auto &requestedTopology : deploymentLoader.getTopologies()) deployment.addTopology(requestedTopology);
+        deployment.reserve(engine.getInstanceCount() - 1);
+        for (size_t i = 0; i + 1 < engine.getInstanceCount(); i++)
+        {
+          const auto &request = runnerRequests[i % runnerRequests.size()];
+          deployment.emplaceRunner(i, deploymentLoader.getFunctions()[request.functionIdx], rootInstanceId, (deployr::Deployment::topologyIdx_t)request.topologyIdx);
+        }
+      }
+
+      deployHierarchical(deployr, deployment, rootInstanceId, partitions);
+      return;
+    }
+
+    // Getting the topology of the other simulated instances
+    std::vector<HiCR::Instance::instanceId_t> instanceIds;
+    for (const auto &instance : instanceManager.getInstances()) instanceIds.push_back(instance->getId());
+    const auto globalTopology = deployr.gatherGlobalTopology(instanceManager.getRootInstanceId(), instanceIds, deployr::DeployR::topologyGatherMode_t::tree);
+
+    // Creating deployment object
+    deployr::Deployment deployment;
+
+    // Matching the runners to the instances. This only needs to be done by the deployment coordinator (root, in this case)
+    if (instanceManager.getCurrentInstance()->isRootInstance())
+    {
+      std::vector<HiCR::Topology> requestedTopologies;
+      for (size_t i = 0; i < engine.getInstanceCount(); i++) requestedTopologies.push_back(deploymentLoader.getTopologies()[runnerRequests[i % runnerRequests.size()].topologyIdx]);
+
+      // Using the equivalence class matching, which scales to a large number of instances
+      const auto matching = deployr::DeployR::doEquivalenceClassMatching(requestedTopologies, globalTopology);
+
+      // Check matching
+      if (matching.size() != requestedTopologies.size())
+      {
+        fprintf(stderr, "Error: The simulated instances do not have the sufficient hardware resources to run this job.\n");
+        instanceManager.abort(-1);
+      }
+
+      // Creating the runner objects
+      deployment.reserve(matching.size());
+      for (size_t i = 0; i < matching.size(); i++)
+        deployment.emplaceRunner(i, deploymentLoader.getFunctions()[runnerRequests[i % runnerRequests.size()].functionIdx], instanceIds[matching[i]]);
+    }
+
+    // Deploying
+    deploy(deployr, deployment, instanceManager.getRootInstanceId());
+  });
+  const double elapsedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+  // Reporting the traffic of the simulated instances
+  printf("Simulated %lu instances in %.3fs: %lu messages, %lu return value bytes\n",
+         engine.getInstanceCount(),
+         elapsedTime,
+         engine.getNetwork().getMessageCount(),
+         engine.getNetwork().getByteCount());
+}
@@ -1,6 +1,9 @@
 #include <deployr/deployr.hpp>
+#include <deployr/deploymentLoader.hpp>
 #include <nlohmann_json/json.hpp>
+#include <cstdlib>
 #include <fstream>
+#include <unistd.h>
 #include <hicr/backends/mpi/instanceManager.hpp>
 #include <hicr/backends/mpi/communicationManager.hpp>
 #include <hicr/backends/mpi/memoryManager.hpp>
@@ -68,52 +71,97 @@ int main(int argc, char *argv[])
   // Initializing deployr object
   deployr.initialize();
 
-  // Getting the topology of the other MPI processes
+  // Recording a trace of the deployment, if a file to export it to is given
+  const char *traceFilePath = std::getenv("DEPLOYR_TRACE_FILE");
+  deployr.getTracer().setEnabled(traceFilePath != nullptr);
+
+  // Using the host name as locality, so that runners that communicate are preferably placed on the same host
+  char hostName[256] = {0};
+  gethostname(hostName, sizeof(hostName) - 1);
+  deployr.setLocalLocality(hostName);
+
+  // Checking arguments. The deployment file only needs to be read by the deployment coordinator (root, in this case)
+  const bool isRootInstance = instanceManager->getCurrentInstance()->isRootInstance();
+  if (isRootInstance && argc != 2)
+  {
+    fprintf(stderr, "Error: You need to pass a deployment.json file as parameter.\n");
+    instanceManager->abort(-1);
+  }
+
+  // Getting the ids of the MPI processes
   std::vector<HiCR::Instance::instanceId_t> instanceIds;
   for (const auto &instance : instanceManager->getInstances()) instanceIds.push_back(instance->getId());
-  const auto globalTopology = deployr.gatherGlobalTopology(instanceManager->getRootInstanceId(), instanceIds);
+
+  // Restarting from the deployment plan stored by a previous run, if a file for it is given and the plan is still valid for these processes and deployment file
+  const char             *planFilePath       = std::getenv("DEPLOYR_PLAN_FILE");
+  const uint64_t          requestFingerprint = isRootInstance ? deployr::DeploymentPlan::fingerprintFile(argv[1]) : deployr::DeploymentPlan::noRequestFingerprint;
+  deployr::DeploymentPlan plan;
+  bool                    isPlanValid = false;
+  if (planFilePath != nullptr)
+  {
+    if (isRootInstance) plan = deployr::DeploymentPlan::load(planFilePath).value_or(deployr::DeploymentPlan());
+    isPlanValid = deployr.validateDeploymentPlan(instanceManager->getRootInstanceId(), instanceIds, plan, requestFingerprint);
+  }
 
   // Creating deployment object
   deployr::Deployment deployment;
-
-  // Gathering deployment information from json file. This only needs to be done by the deployment coordinator (root, in this case)
-  if (instanceManager->getCurrentInstance()->isRootInstance())
+  if (isPlanValid) deployment = plan.getDeployment();
+  else
   {
-    // Checking arguments
-    if (argc != 2)
+    // Getting the topology of the other MPI processes. Their fingerprints are needed to store a new plan
+    deployr.setTopologyCacheEnabled(planFilePath != nullptr);
+    const auto globalTopology = deployr.gatherGlobalTopology(instanceManager->getRootInstanceId(), instanceIds);
+
+    // Gathering deployment information from json file. This only needs to be done by the deployment coordinator (root, in this case)
+    if (isRootInstance)
     {
-      fprintf(stderr, "Error: You need to pass a deployment.json file as parameter.\n");
-      instanceManager->abort(-1);
-    }
+      // Reading deployment file
+      std::string deploymentFilePath = std::string(argv[1]);
 
-    // Reading deployment file
-    std::string deploymentFilePath = std::string(argv[1]);
+      // Streaming the request file contents into runner requests and communication hints
+      deployr::DeploymentLoader deploymentLoader;
+      deploymentLoader.parseFile(deploymentFilePath);
 
-    // Parsing request file contents to a JSON object
-    std::ifstream ifs(deploymentFilePath);
-    auto          deploymentJs = nlohmann::json::parse(ifs);
+      // Getting requested topologies from the json file
+      const auto requestedTopologies = deploymentLoader.getRequestedTopologies();
 
-    // Getting requested topologies from the json file
-    std::vector<HiCR::Topology> requestedTopologies;
-    for (const auto &runner : deploymentJs["Runners"]) requestedTopologies.push_back(HiCR::Topology(runner["Topology"]));
+      // Getting the locality of each of the detected instances
+      std::vector<std::string> hostLocalities;
+      for (const auto instanceId : instanceIds) hostLocalities.push_back(deployr.getHostLocality(instanceId));
 
-    // Determine best pairing between the detected instances
-    const auto matching = deployr::DeployR::doBipartiteMatching(requestedTopologies, globalTopology);
+      // Determine best pairing between the detected instances
+      auto       matchSpan = deployr.getTracer().span("Match", "Phase");
+      const auto matching  = deployr::DeployR::doLocalityAwareMatching(requestedTopologies, globalTopology, hostLocalities, deploymentLoader.getCommunicationGroups());
 
-    // Check matching
-    if (matching.size() != requestedTopologies.size())
-    {
-      fprintf(stderr, "Error: The provided instances do not have the sufficient hardware resources to run this job.\n");
-      instanceManager->abort(-1);
-    }
+      // Check matching
+      if (matching.size() != requestedTopologies.size())
+      {
+        fprintf(stderr, "Error: The provided instances do not have the sufficient hardware resources to run this job.\n");
+        instanceManager->abort(-1);
+      }
 
-    // Creating the runner objects
-    for (size_t i = 0; i < deploymentJs["Runners"].size(); i++) deployment.addRunner(deployr::Runner(i, deploymentJs["Runners"][i]["Function"].get<std::string>(), matching[i]));
+      // Creating the runner objects
+      deploymentLoader.buildDeployment(std::vector<HiCR::Instance::instanceId_t>(matching.begin(), matching.end()), deployment);
+
+      // Storing the plan for the next run
+      if (planFilePath != nullptr) deployr.createDeploymentPlan(deployment, instanceIds, requestFingerprint).save(planFilePath);
+    }
   }
 
   // Deploying
   deploy(deployr, deployment, instanceManager->getRootInstanceId());
 
+  // Collecting the trace of all instances at the root, and exporting it
+  if (traceFilePath != nullptr)
+  {
+    deployr.gatherTraces(instanceManager->getRootInstanceId(), instanceIds);
+    if (instanceManager->getCurrentInstance()->isRootInstance())
+    {
+      std::ofstream traceFile(traceFilePath);
+      deployr.getTracer().exportChromeTrace(traceFile);
+    }
+  }
+
   // Finalizing instance manager
   instanceManager->finalize();
 }
\ No newline at end of file
@@ -0,0 +1,360 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace deployr
+{
+
+/**
+ * Maximum-cardinality bipartite matching engine based on the Hopcroft-Karp algorithm, running in O(E√V).
+ *
+ * Left vertices correspond to runners and right vertices to hosts. Adjacency is stored either in compressed sparse row (CSR) form
+ * or, for dense graphs, as one bitset row per left vertex. The search for augmenting paths is iterative, and all working arrays are
+ * kept between calls, so that a single matcher can be reused for many graphs without re-allocating.
+ */
+class BipartiteMatcher final
+{
+  public:
+
+  /// Type for vertex indexes
+  typedef uint32_t vertex_t;
+
+  /// Represents the absence of a vertex (e.g., the pair of an unmatched vertex)
+  static constexpr vertex_t NIL = std::numeric_limits<vertex_t>::max();
+
+  /**
+   * Storage choices for the adjacency of the graph
+   */
+  enum adjacencyStorage_t
+  {
+    /// Picks whichever of the storages below takes less memory for the given graph
+    automatic,
+
+    /// Compressed sparse row: per left vertex, a contiguous range of right vertex indexes
+    csr,
+
+    /// One bitset of size rightCount per left vertex
+    bitset
+  };
+
+  BipartiteMatcher()  = default;
+  ~BipartiteMatcher() = default;
+
+  /**
+   * Loads a new graph into the matcher, discarding the previous graph and matching
+   *
+   * @param[in] adjacency For each left vertex, the indexes of its adjacent right vertices
+   * @param[in] rightCount The number of right vertices
+   * @param[in] storage The adjacency storage to use
+   */
+  __INLINE__ void loadGraph(const std::vector<std::vector<size_t>> &adjacency, const size_t rightCount, const adjacencyStorage_t storage = adjacencyStorage_t::automatic)
+  {
+    if (adjacency.size() >= NIL || rightCount >= NIL) HICR_THROW_LOGIC("[DeployR] Too many vertices for the bipartite matcher (%lu x %lu).\n", adjacency.size(), rightCount);
+
+    _leftCount  = adjacency.size();
+    _rightCount = rightCount;
+
+    size_t edgeCount = 0;
+    for (const auto &neighbors : adjacency) edgeCount += neighbors.size();
+
+    // Bitsets pay off when they take less memory than the explicit edge list
+    _wordsPerRow = (_rightCount + 63) / 64;
+    _useBitset   = storage == adjacencyStorage_t::bitset || (storage == adjacencyStorage_t::automatic && _leftCount * _wordsPerRow * sizeof(uint64_t) < edgeCount * sizeof(vertex_t));
+
+    if (_useBitset)
+    {
+      _bitsetRows.assign(_leftCount * _wordsPerRow, 0);
+      for (size_t u = 0; u < _leftCount; u++)
+        for (const auto v : adjacency[u])
+        {
+          checkRightVertex(v);
+          _bitsetRows[u * _wordsPerRow + v / 64] |= uint64_t(1) << (v % 64);
+        }
+    }
+    else
+    {
+      _rowOffsets.resize(_leftCount + 1);
+      _columns.resize(edgeCount);
+      size_t edge = 0;
+      for (size_t u = 0; u < _leftCount; u++)
+      {
+        _rowOffsets[u] = edge;
+        for (const auto v : adjacency[u])
+        {
+          checkRightVertex(v);
+          _columns[edge++] = (vertex_t)v;
+        }
+      }
+      _rowOffsets[_leftCount] = edge;
+    }
+
+    // Preparing working arrays, reusing their capacity
+    _leftPairs.assign(_leftCount, NIL);
+    _rightPairs.assign(_rightCount, NIL);
+    _distances.resize(_leftCount);
+    _cursors.resize(_leftCount);
+    _pathRight.resize(_leftCount);
+    _queue.reserve(_leftCount);
+    _stack.reserve(_leftCount);
+  }
+
+  /**
+   * Grows the current matching into a maximum-cardinality one. Pairs already in the matching are kept as the starting point
+   *
+   * @return The number of matched left vertices
+   */
+  __INLINE__ size_t computeMaximumMatching()
+  {
+    size_t matchCount = 0;
+    for (const auto v : _leftPairs)
+      if (v != NIL) matchCount++;
+
+    // Keep augmenting along shortest paths while there are any
+    while (buildLayers())
+    {
+      // Resetting the neighbor cursors for this phase
+      for (size_t u = 0; u < _leftCount; u++) _cursors[u] = firstCursor(u);
+
+      for (size_t u = 0; u < _leftCount; u++)
+        if (_leftPairs[u] == NIL && augmentFrom((vertex_t)u)) matchCount++;
+    }
+
+    return matchCount;
+  }
+
+  /**
+   * Removes all pairs from the current matching, keeping the graph
+   */
+  __INLINE__ void clearMatching()
+  {
+    std::fill(_leftPairs.begin(), _leftPairs.end(), NIL);
+    std::fill(_rightPairs.begin(), _rightPairs.end(), NIL);
+  }
+
+  /**
+   * Checks whether an edge exists in the loaded graph
+   *
+   * @param[in] u The left vertex
+   * @param[in] v The right vertex
+   *
+   * @return true, if the edge exists; false, otherwise
+   */
+  [[nodiscard]] __INLINE__ bool hasEdge(const vertex_t u, const vertex_t v) const
+  {
+    if (_useBitset) return (_bitsetRows[u * _wordsPerRow + v / 64] >> (v % 64)) & 1;
+    for (size_t edge = _rowOffsets[u]; edge < _rowOffsets[u + 1]; edge++)
+      if (_columns[edge] == v) return true;
+    return false;
+  }
+
+  /**
+   * Gets the right vertex paired to each left vertex
+   *
+   * @return A vector of size leftCount, containing the paired right vertex or NIL
+   */
+  [[nodiscard]] __INLINE__ const std::vector<vertex_t> &getLeftPairings() const { return _leftPairs; }
+
+  /**
+   * Gets the left vertex paired to each right vertex
+   *
+   * @return A vector of size rightCount, containing the paired left vertex or NIL
+   */
+  [[nodiscard]] __INLINE__ const std::vector<vertex_t> &getRightPairings() const { return _rightPairs; }
+
+  /**
+   * Indicates whether the loaded graph uses bitset adjacency
+   *
+   * @return true, if the adjacency is stored as bitsets; false, if in CSR form
+   */
+  [[nodiscard]] __INLINE__ bool isUsingBitset() const { return _useBitset; }
+
+  private:
+
+  /// Distance of left vertices not reachable in the current layered graph
+  static constexpr vertex_t INF = std::numeric_limits<vertex_t>::max();
+
+  /**
+   * [Internal] Sanity check for right vertex indexes provided by the user
+   *
+   * @param[in] v The right vertex index
+   */
+  __INLINE__ void checkRightVertex(const size_t v) const
+  {
+    if (v >= _rightCount) HICR_THROW_LOGIC("[DeployR] Right vertex %lu out of bounds (%lu vertices) in the bipartite matcher.\n", v, _rightCount);
+  }
+
+  /**
+   * [Internal] Gets the starting position of the neighbor iteration for a left vertex
+   *
+   * @param[in] u The left vertex
+   *
+   * @return The initial cursor
+   */
+  [[nodiscard]] __INLINE__ size_t firstCursor(const vertex_t u) const { return _useBitset ? 0 : _rowOffsets[u]; }
+
+  /**
+   * [Internal] Gets the next neighbor of a left vertex, advancing its cursor
+   *
+   * @param[in] u The left vertex
+   * @param[in,out] cursor The iteration position, as obtained from firstCursor
+   *
+   * @return The next adjacent right vertex, or NIL if there are no more
+   */
+  __INLINE__ vertex_t nextNeighbor(const vertex_t u, size_t &cursor) const
+  {
+    if (_useBitset == false) return cursor < _rowOffsets[u + 1] ? _columns[cursor++] : NIL;
+
+    // For bitsets, the cursor is the next bit to look at
+    const uint64_t *row = _bitsetRows.data() + u * _wordsPerRow;
+    while (cursor < _rightCount)
+    {
+      const size_t   word = cursor / 64;
+      const uint64_t bits = row[word] >> (cursor % 64);
+      if (bits != 0)
+      {
+        const size_t v = cursor + std::countr_zero(bits);
+        cursor         = v + 1;
+        return (vertex_t)v;
+      }
+      cursor = (word + 1) * 64;
+    }
+
+    return NIL;
+  }
+
+  /**
+   * [Internal] Breadth-first search that layers the left vertices by their alternating-path distance from the free left vertices
+   *
+   * @return true, if there is at least one augmenting path; false, otherwise
+   */
+  __INLINE__ bool buildLayers()
+  {
+    _queue.clear();
+    for (size_t u = 0; u < _leftCount; u++)
+    {
+      _distances[u] = _leftPairs[u] == NIL ? 0 : INF;
+      if (_leftPairs[u] == NIL) _queue.push_back((vertex_t)u);
+    }
+
+    bool foundFreeRight = false;
+    for (size_t head = 0; head < _queue.size(); head++)
+    {
+      const auto u      = _queue[head];
+      size_t     cursor = firstCursor(u);
+      for (auto v = nextNeighbor(u, cursor); v != NIL; v = nextNeighbor(u, cursor))
+      {
+        const auto w = _rightPairs[v];
+        if (w == NIL) foundFreeRight = true;
+        else if (_distances[w] == INF)
+        {
+          _distances[w] = _distances[u] + 1;
+          _queue.push_back(w);
+        }
+      }
+    }
+
+    return foundFreeRight;
+  }
+
+  /**
+   * [Internal] Iterative depth-first search for an augmenting path starting at a free left vertex, following the BFS layers.
+   * If one is found, the matching is flipped along it.
+   *
+   * @param[in] root The free left vertex to start from
+   *
+   * @return true, if an augmenting path was found; false, otherwise
+   */
+  __INLINE__ bool augmentFrom(const vertex_t root)
+  {
+    _stack.clear();
+    _stack.push_back(root);
+
+    while (_stack.empty() == false)
+    {
+      const auto u = _stack.back();
+      const auto v = nextNeighbor(u, _cursors[u]);
+
+      // Dead end: this vertex cannot be part of an augmenting path in this phase
+      if (v == NIL)
+      {
+        _distances[u] = INF;
+        _stack.pop_back();
+        continue;
+      }
+
+      const auto w = _rightPairs[v];
+
+      // Found a free right vertex: flipping the path
+      if (w == NIL)
+      {
+        _pathRight[u] = v;
+        for (const auto x : _stack)
+        {
+          _leftPairs[x]              = _pathRight[x];
+          _rightPairs[_pathRight[x]] = x;
+        }
+        return true;
+      }
+
+      // Otherwise, descending into the next layer
+      if (_distances[w] == _distances[u] + 1)
+      {
+        _pathRight[u] = v;
+        _stack.push_back(w);
+      }
+    }
+
+    return false;
+  }
+
+  /// Number of left vertices
+  size_t _leftCount = 0;
+
+  /// Number of right vertices
+  size_t _rightCount = 0;
+
+  /// Whether the current graph uses bitset adjacency
+  bool _useBitset = false;
+
+  /// CSR row offsets, one per left vertex plus one
+  std::vector<size_t> _rowOffsets;
+
+  /// CSR column (right vertex) indexes
+  std::vector<vertex_t> _columns;
+
+  /// Number of 64-bit words per bitset row
+  size_t _wordsPerRow = 0;
+
+  /// Bitset adjacency rows, one per left vertex
+  std::vector<uint64_t> _bitsetRows;
+
+  /// Right vertex paired with each left vertex
+  std::vector<vertex_t> _leftPairs;
+
+  /// Left vertex paired with each right vertex
+  std::vector<vertex_t> _rightPairs;
+
+  /// BFS layer of each left vertex
+  std::vector<vertex_t> _distances;
+
+  /// Per-phase neighbor iteration position of each left vertex
+  std::vector<size_t> _cursors;
+
+  /// Right vertex through which each left vertex in the DFS stack continues the path
+  std::vector<vertex_t> _pathRight;
+
+  /// BFS queue
+  std::vector<vertex_t> _queue;
+
+  /// DFS stack of left vertices
+  std::vector<vertex_t> _stack;
+
+}; // class BipartiteMatcher
+
+} // namespace deployr
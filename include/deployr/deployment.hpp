@@ -1,6 +1,11 @@
 #pragma once
 
 #include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/topology.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include "runner.hpp"
 
@@ -9,30 +14,247 @@ namespace deployr
 
 /**
  * Represents a user's requirements for a deployment. This involves the runners, their hardware requirements, and their pairing to a HiCR instance
+ *
+ * Runners are stored as a struct of arrays: their ids, function indexes and instance ids are kept in separate contiguous vectors, and each distinct
+ * function name is stored only once. Adding a runner whose function is already known does not allocate, beyond the growth of the vectors (see reserve).
+ * Runners may also refer to the topology they requested, among those added with addTopology, which DeployR needs to pin them to their host's resources (see DeployR::setRunnerPinning).
+ * Payloads (see setPayload) are only stored once a runner has one.
  */
 class Deployment final
 {
   public:
 
+  /**
+   * A group of runners that communicate heavily among each other, and should therefore be placed close to each other
+   */
+  struct communicationGroup_t
+  {
+    /// The ids of the runners in the group
+    std::vector<Runner::runnerId_t> runnerIds;
+
+    /// The relative communication intensity between every pair of runners in the group
+    double weight;
+  };
+
+  /// Type for the index of a runner's function among the distinct functions of the deployment
+  typedef uint32_t functionIdx_t;
+
+  /// Type for the index of a runner's requested topology among the topologies of the deployment
+  typedef uint32_t topologyIdx_t;
+
+  /// Topology index of the runners that did not declare their requested topology
+  static constexpr topologyIdx_t noTopology = UINT32_MAX;
+
   Deployment()  = default;
   ~Deployment() = default;
 
+  /**
+   * Reserves space for a number of runners, so that adding them does not reallocate
+   * 
+   * @param[in] runnerCount The total number of runners expected
+   */
+  __INLINE__ void reserve(const size_t runnerCount)
+  {
+    _runnerIds.reserve(runnerCount);
+    _functionIdxs.reserve(runnerCount);
+    _instanceIds.reserve(runnerCount);
+    _topologyIdxs.reserve(runnerCount);
+  }
+
   /**
    * Add an instance
    */
-  __INLINE__ void addRunner(const Runner &runner) { _runners.push_back(runner); }
+  __INLINE__ void addRunner(const Runner &runner)
+  {
+    emplaceRunner(runner.getId(), runner.getFunction(), runner.getInstanceId());
+    if (runner.getPayload().size > 0) setPayload(_runnerIds.size() - 1, runner.getPayload());
+  }
+
+  /**
+   * Adds a runner from its fields, without creating a Runner object
+   * 
+   * @param[in] id The id of the runner
+   * @param[in] function The name of the initial function of the runner
+   * @param[in] instanceId The id of the HiCR instance assigned to the runner
+   * @param[in] topologyIdx The index of the topology requested by the runner, as returned by addTopology, if any
+   */
+  __INLINE__ void emplaceRunner(const Runner::runnerId_t           id,
+                                const std::string                 &function,
+                                const HiCR::Instance::instanceId_t instanceId,
+                                const topologyIdx_t                topologyIdx = noTopology)
+  {
+    if (topologyIdx != noTopology && topologyIdx >= _topologies.size())
+      HICR_THROW_LOGIC("[DeployR] Runner %lu refers to topology %u, but the deployment only has %lu.\n", id, topologyIdx, _topologies.size());
+
+    // Interning the function name
+    auto entry = _functionIdxIndex.find(function);
+    if (entry == _functionIdxIndex.end())
+    {
+      entry = _functionIdxIndex.emplace(function, (functionIdx_t)_functions.size()).first;
+      _functions.push_back(function);
+    }
+
+    _runnerIds.push_back(id);
+    _functionIdxs.push_back(entry->second);
+    _instanceIds.push_back(instanceId);
+    _topologyIdxs.push_back(topologyIdx);
+    if (_payloads.empty() == false) _payloads.emplace_back();
+  }
+
+  /**
+   * Sets the payload delivered to a runner along with its launch (see Runner::createPayload)
+   * 
+   * @param[in] runnerIdx The position of the runner, in the order the runners were added
+   * @param[in] payload The payload
+   */
+  __INLINE__ void setPayload(const size_t runnerIdx, Runner::payload_t payload)
+  {
+    if (runnerIdx >= _runnerIds.size())
+      HICR_THROW_LOGIC("[DeployR] Cannot set the payload of runner position %lu, since the deployment only has %lu runners.\n", runnerIdx, _runnerIds.size());
+    if (_payloads.empty()) _payloads.resize(_runnerIds.size());
+    _payloads[runnerIdx] = std::move(payload);
+  }
+
+  /**
+   * Gets the payload of a runner
+   * 
+   * @param[in] runnerIdx The position of the runner, in the order the runners were added
+   * 
+   * @return The payload of the runner, empty if none
+   */
+  [[nodiscard]] __INLINE__ const Runner::payload_t &getPayload(const size_t runnerIdx) const
+  {
+    static const Runner::payload_t noPayload;
+    return _payloads.empty() ? noPayload : _payloads[runnerIdx];
+  }
+
+  /**
+   * Adds a topology that runners can refer to as the one they requested. Runners requesting the same topology should share it
+   * 
+   * @param[in] topology The requested topology
+   * 
+   * @return The index of the topology, to pass to emplaceRunner
+   */
+  __INLINE__ topologyIdx_t addTopology(const HiCR::Topology &topology)
+  {
+    _topologies.push_back(topology);
+    return (topologyIdx_t)(_topologies.size() - 1);
+  }
+
+  /**
+   * Gets the number of runners
+   * 
+   * @return The number of runners
+   */
+  [[nodiscard]] __INLINE__ size_t getRunnerCount() const { return _runnerIds.size(); }
+
+  /**
+   * Gets the id of each runner
+   * 
+   * @return The runner ids, in the order the runners were added
+   */
+  [[nodiscard]] __INLINE__ const auto &getRunnerIds() const { return _runnerIds; }
+
+  /**
+   * Gets the function index of each runner
+   * 
+   * @return The index of each runner's function in getFunctions, in the order the runners were added
+   */
+  [[nodiscard]] __INLINE__ const auto &getFunctionIdxs() const { return _functionIdxs; }
+
+  /**
+   * Gets the instance id of each runner
+   * 
+   * @return The id of each runner's HiCR instance, in the order the runners were added
+   */
+  [[nodiscard]] __INLINE__ const auto &getInstanceIds() const { return _instanceIds; }
+
+  /**
+   * Gets the distinct functions of the runners
+   * 
+   * @return The function names, indexed by the function indexes of the runners
+   */
+  [[nodiscard]] __INLINE__ const auto &getFunctions() const { return _functions; }
+
+  /**
+   * Gets the requested topology index of each runner
+   * 
+   * @return The index of each runner's requested topology in getTopologies, or noTopology, in the order the runners were added
+   */
+  [[nodiscard]] __INLINE__ const auto &getTopologyIdxs() const { return _topologyIdxs; }
+
+  /**
+   * Gets the topologies requested by the runners
+   * 
+   * @return The topologies, indexed by the topology indexes of the runners
+   */
+  [[nodiscard]] __INLINE__ const auto &getTopologies() const { return _topologies; }
+
+  /**
+   * Gets a runner as a Runner object
+   * 
+   * @param[in] idx The position of the runner, in the order the runners were added
+   * 
+   * @return The runner
+   */
+  [[nodiscard]] __INLINE__ Runner getRunner(const size_t idx) const { return Runner(_runnerIds[idx], _functions[_functionIdxs[idx]], _instanceIds[idx], getPayload(idx)); }
+
+  /**
+   * Gets all runners as Runner objects. Prefer the per-field accessors when iterating large deployments
+   * 
+   * @return A copy of the runners, as Runner objects
+   */
+  [[nodiscard]] __INLINE__ std::vector<Runner> getRunners() const
+  {
+    std::vector<Runner> runners;
+    runners.reserve(_runnerIds.size());
+    for (size_t i = 0; i < _runnerIds.size(); i++) runners.push_back(getRunner(i));
+    return runners;
+  }
+
+  /**
+   * Declares that a group of runners communicates heavily. A pair of runners can be declared as a group of two
+   * 
+   * @param[in] runnerIds The ids of the runners in the group
+   * @param[in] weight The relative communication intensity between every pair of runners in the group
+   */
+  __INLINE__ void addCommunicationGroup(const std::vector<Runner::runnerId_t> &runnerIds, const double weight) { _communicationGroups.push_back({runnerIds, weight}); }
 
   /**
-   * Gets the instance map
+   * Gets the declared communication groups
    * 
-   * @return the instance map
+   * @return The communication groups
    */
-  [[nodiscard]] __INLINE__ const auto &getRunners() const { return _runners; }
+  [[nodiscard]] __INLINE__ const auto &getCommunicationGroups() const { return _communicationGroups; }
 
   private:
 
-  /// A set of runners requested
-  std::vector<Runner> _runners;
+  /// Id of each runner requested
+  std::vector<Runner::runnerId_t> _runnerIds;
+
+  /// Index of each runner's function in the distinct functions
+  std::vector<functionIdx_t> _functionIdxs;
+
+  /// HiCR instance id assigned to each runner
+  std::vector<HiCR::Instance::instanceId_t> _instanceIds;
+
+  /// Index of each runner's requested topology, or noTopology
+  std::vector<topologyIdx_t> _topologyIdxs;
+
+  /// The distinct functions of the runners
+  std::vector<std::string> _functions;
+
+  /// Index of each distinct function
+  std::unordered_map<std::string, functionIdx_t> _functionIdxIndex;
+
+  /// The topologies requested by the runners
+  std::vector<HiCR::Topology> _topologies;
+
+  /// The payload of each runner, or empty if no runner has one
+  std::vector<Runner::payload_t> _payloads;
+
+  /// Groups of runners that communicate heavily among each other
+  std::vector<communicationGroup_t> _communicationGroups;
 
 }; // class Deployment
 
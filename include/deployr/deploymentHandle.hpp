@@ -0,0 +1,189 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/instance.hpp>
+#include <functional>
+#include <map>
+#include <string>
+#include "runner.hpp"
+
+namespace deployr
+{
+
+/**
+ * Tracks the progress of a deployment launched asynchronously by its coordinator.
+ *
+ * Each runner goes from pending to launched when its start command is sent, and then to finished or failed when its host reports its completion.
+ * Completion reports are only received while waiting, so the states of remote runners advance during calls to wait.
+ */
+class DeploymentHandle final
+{
+  public:
+
+  /**
+   * The states a runner goes through during a deployment
+   */
+  enum runnerState_t
+  {
+    /// The start command of the runner has not been sent yet
+    pending,
+
+    /// The start command of the runner has been sent
+    launched,
+
+    /// The runner returned from its initial function
+    finished,
+
+    /// The initial function of the runner threw an exception
+    failed
+  };
+
+  /**
+   * Creates a handle for a deployment without runners, which is already complete
+   */
+  DeploymentHandle() = default;
+
+  /**
+   * Constructor for the deployment handle
+   *
+   * @param[in] runLocalRunners Function that runs the runners assigned to the coordinator itself, updating their states in the handle it receives
+   * @param[in] awaitReport Function that blocks until the next completion report from a remote runner is received, updating its state
+   */
+  DeploymentHandle(std::function<void(DeploymentHandle &)> runLocalRunners, std::function<void()> awaitReport)
+    : _runLocalRunners(std::move(runLocalRunners)),
+      _awaitReport(std::move(awaitReport))
+  {}
+
+  ~DeploymentHandle() = default;
+
+  /**
+   * Sets the state of a runner, adding it to the deployment if it was not tracked yet
+   *
+   * @param[in] runnerId The id of the runner
+   * @param[in] state The new state of the runner
+   */
+  __INLINE__ void setState(const Runner::runnerId_t runnerId, const runnerState_t state)
+  {
+    const auto [entry, isNewRunner] = _states.try_emplace(runnerId, state);
+    if (isNewRunner == false)
+    {
+      if (isDone(entry->second) == false && isDone(state)) _doneCount++;
+      entry->second = state;
+    }
+    else if (isDone(state)) _doneCount++;
+  }
+
+  /**
+   * Gets the state of a runner
+   *
+   * @param[in] runnerId The id of the runner
+   *
+   * @return The current state of the runner
+   */
+  [[nodiscard]] __INLINE__ runnerState_t getState(const Runner::runnerId_t runnerId) const
+  {
+    const auto entry = _states.find(runnerId);
+    if (entry == _states.end()) HICR_THROW_LOGIC("[DeployR] Runner %lu is not part of this deployment.\n", runnerId);
+    return entry->second;
+  }
+
+  /**
+   * Checks whether a runner is part of this deployment and has not finished or failed yet
+   *
+   * @param[in] runnerId The id of the runner
+   *
+   * @return true, if the runner is still running (or about to); false, otherwise
+   */
+  [[nodiscard]] __INLINE__ bool isRunning(const Runner::runnerId_t runnerId) const
+  {
+    const auto entry = _states.find(runnerId);
+    return entry != _states.end() && isDone(entry->second) == false;
+  }
+
+  /**
+   * Gets the states of all runners
+   *
+   * @return A map from runner id to its current state
+   */
+  [[nodiscard]] __INLINE__ const std::map<Runner::runnerId_t, runnerState_t> &getStates() const { return _states; }
+
+  /**
+   * Gets the number of runners in the deployment
+   *
+   * @return The number of runners
+   */
+  [[nodiscard]] __INLINE__ size_t getRunnerCount() const { return _states.size(); }
+
+  /**
+   * Gets the number of runners that failed
+   *
+   * @return The number of runners in the failed state
+   */
+  [[nodiscard]] __INLINE__ size_t getFailedCount() const
+  {
+    size_t failedCount = 0;
+    for (const auto &[runnerId, state] : _states)
+      if (state == runnerState_t::failed) failedCount++;
+    return failedCount;
+  }
+
+  /**
+   * Checks whether all runners have finished or failed
+   *
+   * @return true, if the deployment is complete; false, otherwise
+   */
+  [[nodiscard]] __INLINE__ bool isComplete() const { return _doneCount == _states.size(); }
+
+  /**
+   * Runs the runners assigned to the coordinator, if they did not run yet. It returns once they finish, regardless of the remote runners
+   */
+  __INLINE__ void runLocalRunners()
+  {
+    if (_hasRunLocalRunners) return;
+    _hasRunLocalRunners = true;
+    if (_runLocalRunners) _runLocalRunners(*this);
+  }
+
+  /**
+   * Runs the runners assigned to the coordinator, if they did not run yet, and then blocks until all remote runners report their completion
+   */
+  __INLINE__ void wait()
+  {
+    runLocalRunners();
+    while (isComplete() == false)
+    {
+      if (_awaitReport == nullptr) HICR_THROW_LOGIC("[DeployR] Waiting on a deployment handle that cannot receive completion reports.\n");
+      _awaitReport();
+    }
+  }
+
+  private:
+
+  /**
+   * [Internal] Checks whether a state is final
+   *
+   * @param[in] state The state to check
+   *
+   * @return true, if the state is finished or failed; false, otherwise
+   */
+  [[nodiscard]] __INLINE__ static bool isDone(const runnerState_t state) { return state == runnerState_t::finished || state == runnerState_t::failed; }
+
+  /// Function that runs the runners assigned to the coordinator
+  std::function<void(DeploymentHandle &)> _runLocalRunners;
+
+  /// Function that blocks until the next completion report is received
+  std::function<void()> _awaitReport;
+
+  /// Whether the runners assigned to the coordinator already ran
+  bool _hasRunLocalRunners = false;
+
+  /// Current state of each runner
+  std::map<Runner::runnerId_t, runnerState_t> _states;
+
+  /// Number of runners in a final state
+  size_t _doneCount = 0;
+
+}; // class DeploymentHandle
+
+} // namespace deployr
@@ -0,0 +1,437 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/instance.hpp>
+#include <hicr/core/topology.hpp>
+#include <nlohmann_json/json.hpp>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "deployment.hpp"
+#include "runner.hpp"
+
+namespace deployr
+{
+
+/**
+ * Reads a deployment file without materializing it as a whole, so that manifests with a large number of runners can be loaded by the coordinator.
+ *
+ * The file is parsed as a stream of SAX events. Each runner is reduced to a compact request as soon as its object ends: its function and topology are stored
+ * once per distinct value and referred to by index. Memory use therefore scales with the number of distinct topology shapes, rather than with the number of runners.
+ * Only one runner topology is held as a JSON document at any time.
+ *
+ * The expected format is that of the examples: a root object with a "Runners" array, whose entries contain a "Function" name and a "Topology" object, and an
+ * optional "Communication" array of groups (see Deployment::addCommunicationGroup). Runners take their position in the array as id. Unknown keys are skipped.
+ */
+class DeploymentLoader final : public nlohmann::json_sax<nlohmann::json>
+{
+  public:
+
+  /**
+   * A runner as requested by the deployment file, before it is assigned to an instance
+   */
+  struct runnerRequest_t
+  {
+    /// The id of the runner, its position in the "Runners" array
+    Runner::runnerId_t id;
+
+    /// Index of its initial function among the distinct functions (see getFunctions)
+    size_t functionIdx;
+
+    /// Index of its topology among the distinct topologies (see getTopologies)
+    size_t topologyIdx;
+  };
+
+  DeploymentLoader()  = default;
+  ~DeploymentLoader() = default;
+
+  /**
+   * Parses a deployment file from a stream, adding its runners and communication groups to those already loaded
+   *
+   * @param[in] stream The stream to read the deployment file from
+   */
+  __INLINE__ void parse(std::istream &stream)
+  {
+    resetParserState();
+    nlohmann::json::sax_parse(stream, this);
+  }
+
+  /**
+   * Parses a deployment file, adding its runners and communication groups to those already loaded
+   *
+   * @param[in] filePath The path to the deployment file
+   */
+  __INLINE__ void parseFile(const std::string &filePath)
+  {
+    std::ifstream stream(filePath);
+    if (stream.is_open() == false) HICR_THROW_LOGIC("[DeployR] Could not open deployment file '%s'.\n", filePath.c_str());
+    parse(stream);
+  }
+
+  /**
+   * Gets the requested runners, in the order they appear in the deployment file
+   *
+   * @return The runner requests
+   */
+  [[nodiscard]] __INLINE__ const std::vector<runnerRequest_t> &getRunnerRequests() const { return _runnerRequests; }
+
+  /**
+   * Gets the distinct initial functions requested by the runners
+   *
+   * @return The function names, indexed by runnerRequest_t::functionIdx
+   */
+  [[nodiscard]] __INLINE__ const std::vector<std::string> &getFunctions() const { return _functions; }
+
+  /**
+   * Gets the distinct topologies requested by the runners. Runners requesting identical topology blocks share the same entry
+   *
+   * @return The topologies, indexed by runnerRequest_t::topologyIdx
+   */
+  [[nodiscard]] __INLINE__ const std::vector<HiCR::Topology> &getTopologies() const { return _topologies; }
+
+  /**
+   * Gets the topology requested by each runner, as expected by the DeployR matching functions.
+   *
+   * Copies of the same distinct topology share their devices, so this costs one device list per runner rather than a full topology each.
+   *
+   * @return A vector with the topology of each runner, in the order of getRunnerRequests
+   */
+  [[nodiscard]] __INLINE__ std::vector<HiCR::Topology> getRequestedTopologies() const
+  {
+    std::vector<HiCR::Topology> requestedTopologies;
+    requestedTopologies.reserve(_runnerRequests.size());
+    for (const auto &request : _runnerRequests) requestedTopologies.push_back(_topologies[request.topologyIdx]);
+    return requestedTopologies;
+  }
+
+  /**
+   * Gets the communication groups declared in the deployment file
+   *
+   * @return The communication groups
+   */
+  [[nodiscard]] __INLINE__ const std::vector<Deployment::communicationGroup_t> &getCommunicationGroups() const { return _communicationGroups; }
+
+  /**
+   * Adds the runners, with their requested topologies, and the communication groups to a deployment, once an instance has been assigned to every runner (e.g., by matching or provisioning)
+   *
+   * @param[in] instanceIds The id of the instance assigned to each runner, in the order of getRunnerRequests
+   * @param[out] deployment The deployment to add them to
+   */
+  __INLINE__ void buildDeployment(const std::vector<HiCR::Instance::instanceId_t> &instanceIds, Deployment &deployment) const
+  {
+    if (instanceIds.size() != _runnerRequests.size())
+      HICR_THROW_LOGIC("[DeployR] Provided %lu instance ids for a deployment file with %lu runners.\n", instanceIds.size(), _runnerRequests.size());
+
+    // Adding the distinct topologies once, after those the deployment may already have
+    const auto topologyIdxOffset = (Deployment::topologyIdx_t)deployment.getTopologies().size();
+    for (const auto &topology : _topologies) deployment.addTopology(topology);
+
+    deployment.reserve(deployment.getRunnerCount() + _runnerRequests.size());
+    for (size_t i = 0; i < _runnerRequests.size(); i++)
+      deployment.emplaceRunner(_runnerRequests[i].id, _functions[_runnerRequests[i].functionIdx], instanceIds[i], topologyIdxOffset + _runnerRequests[i].topologyIdx);
+    for (const auto &group : _communicationGroups) deployment.addCommunicationGroup(group.runnerIds, group.weight);
+  }
+
+  /// SAX event handlers. These are only meant to be called by the parser
+
+  __INLINE__ bool null() override { return onScalar(nlohmann::json(nullptr)); }
+  __INLINE__ bool boolean(bool val) override { return onScalar(nlohmann::json(val)); }
+  __INLINE__ bool number_integer(number_integer_t val) override { return onScalar(nlohmann::json(val)); }
+  __INLINE__ bool number_unsigned(number_unsigned_t val) override { return onScalar(nlohmann::json(val)); }
+  __INLINE__ bool number_float(number_float_t val, const string_t &) override { return onScalar(nlohmann::json(val)); }
+  __INLINE__ bool string(string_t &val) override { return onScalar(nlohmann::json(std::move(val))); }
+  __INLINE__ bool binary(binary_t &val) override { return onScalar(nlohmann::json::binary(std::move(val))); }
+  __INLINE__ bool start_object(std::size_t) override { return onContainerStart(true); }
+  __INLINE__ bool start_array(std::size_t) override { return onContainerStart(false); }
+  __INLINE__ bool end_object() override { return onContainerEnd(); }
+  __INLINE__ bool end_array() override { return onContainerEnd(); }
+
+  __INLINE__ bool key(string_t &val) override
+  {
+    if (_skipDepth > 0) return true;
+    if (_captureStack.empty() == false) _captureKey = std::move(val);
+    else _currentKey = std::move(val);
+    return true;
+  }
+
+  __INLINE__ bool parse_error(std::size_t position, const std::string &, const nlohmann::detail::exception &ex) override
+  {
+    HICR_THROW_LOGIC("[DeployR] Could not parse the deployment file at byte %lu: %s\n", position, ex.what());
+  }
+
+  private:
+
+  /**
+   * [Internal] What to do with a value starting at the current position of the document
+   */
+  enum action_t
+  {
+    /// The value is a container whose contents are handled event by event
+    enter,
+
+    /// The value is built as a JSON document, and handled once complete
+    capture,
+
+    /// The value is the initial function of the current runner
+    function,
+
+    /// The value is not needed
+    skip
+  };
+
+  /**
+   * [Internal] The section of the document being parsed at depth 2
+   */
+  enum section_t
+  {
+    /// Outside of any known section
+    none,
+
+    /// The "Runners" array
+    runners,
+
+    /// The "Communication" array
+    communication
+  };
+
+  /**
+   * [Internal] Resets the state of the parser before a new document
+   */
+  __INLINE__ void resetParserState()
+  {
+    _depth     = 0;
+    _section   = section_t::none;
+    _skipDepth = 0;
+    _captureStack.clear();
+    _hasRunnerFunction = false;
+    _hasRunnerTopology = false;
+  }
+
+  /**
+   * [Internal] Decides what to do with a value starting at the current position of the document
+   *
+   * @return The action to take
+   */
+  [[nodiscard]] __INLINE__ action_t getAction() const
+  {
+    if (_depth == 0) return action_t::enter;
+    if (_depth == 1) return _currentKey == "Runners" || _currentKey == "Communication" ? action_t::enter : action_t::skip;
+    if (_depth == 2) return _section == section_t::runners ? action_t::enter : action_t::capture;
+    if (_currentKey == "Function") return action_t::function;
+    if (_currentKey == "Topology") return action_t::capture;
+    return action_t::skip;
+  }
+
+  /**
+   * [Internal] Handles the start of an object or array
+   *
+   * @param[in] isObject Whether the container is an object (or an array)
+   *
+   * @return true, to continue parsing
+   */
+  __INLINE__ bool onContainerStart(const bool isObject)
+  {
+    // Inside a skipped or captured value
+    if (_skipDepth > 0)
+    {
+      _skipDepth++;
+      return true;
+    }
+    if (_captureStack.empty() == false)
+    {
+      _captureStack.push_back(addToCapture(isObject ? nlohmann::json::object() : nlohmann::json::array()));
+      return true;
+    }
+
+    const auto action = getAction();
+    if (action == action_t::skip) _skipDepth = 1;
+    if (action == action_t::function) HICR_THROW_LOGIC("[DeployR] The 'Function' of runner %lu in the deployment file must be a string.\n", _runnerCount);
+    if (action == action_t::capture)
+    {
+      _captured = isObject ? nlohmann::json::object() : nlohmann::json::array();
+      _captureStack.push_back(&_captured);
+    }
+    if (action == action_t::enter)
+    {
+      // The root and the runners are objects, the sections are arrays
+      const bool isSection = _depth == 1;
+      if (isObject == isSection) HICR_THROW_LOGIC("[DeployR] Unexpected %s at depth %lu of the deployment file.\n", isObject ? "object" : "array", _depth);
+      if (isSection) _section = _currentKey == "Runners" ? section_t::runners : section_t::communication;
+      if (_depth == 2)
+      {
+        _hasRunnerFunction = false;
+        _hasRunnerTopology = false;
+      }
+      _depth++;
+    }
+
+    return true;
+  }
+
+  /**
+   * [Internal] Handles the end of an object or array
+   *
+   * @return true, to continue parsing
+   */
+  __INLINE__ bool onContainerEnd()
+  {
+    if (_skipDepth > 0)
+    {
+      _skipDepth--;
+      return true;
+    }
+    if (_captureStack.empty() == false)
+    {
+      _captureStack.pop_back();
+      if (_captureStack.empty()) onCaptureComplete();
+      return true;
+    }
+
+    _depth--;
+    if (_depth == 2 && _section == section_t::runners) onRunnerComplete();
+    if (_depth == 1) _section = section_t::none;
+    return true;
+  }
+
+  /**
+   * [Internal] Handles a scalar value
+   *
+   * @param[in] value The value
+   *
+   * @return true, to continue parsing
+   */
+  __INLINE__ bool onScalar(nlohmann::json &&value)
+  {
+    if (_skipDepth > 0) return true;
+    if (_captureStack.empty() == false)
+    {
+      addToCapture(std::move(value));
+      return true;
+    }
+
+    const auto action = getAction();
+    if (action == action_t::enter) HICR_THROW_LOGIC("[DeployR] Unexpected value at depth %lu of the deployment file.\n", _depth);
+    if (action == action_t::function)
+    {
+      if (value.is_string() == false) HICR_THROW_LOGIC("[DeployR] The 'Function' of runner %lu in the deployment file must be a string.\n", _runnerCount);
+      _runnerFunction    = value.get<std::string>();
+      _hasRunnerFunction = true;
+    }
+    if (action == action_t::capture)
+    {
+      _captured = std::move(value);
+      onCaptureComplete();
+    }
+    return true;
+  }
+
+  /**
+   * [Internal] Adds a value to the innermost container being captured
+   *
+   * @param[in] value The value to add
+   *
+   * @return A pointer to the added value, which stays valid until the next value is added to the same container
+   */
+  __INLINE__ nlohmann::json *addToCapture(nlohmann::json &&value)
+  {
+    auto &container = *_captureStack.back();
+    if (container.is_object()) return &(container[_captureKey] = std::move(value));
+    container.push_back(std::move(value));
+    return &container.back();
+  }
+
+  /**
+   * [Internal] Handles a captured value once complete: either the topology of the current runner, or a communication group
+   */
+  __INLINE__ void onCaptureComplete()
+  {
+    if (_section == section_t::communication)
+    {
+      if (_captured.contains("Runners") == false || _captured.contains("Weight") == false)
+        HICR_THROW_LOGIC("[DeployR] Communication group %lu in the deployment file must contain 'Runners' and 'Weight'.\n", _communicationGroups.size());
+      _communicationGroups.push_back({_captured["Runners"].get<std::vector<Runner::runnerId_t>>(), _captured["Weight"].get<double>()});
+      return;
+    }
+
+    // Deduplicating the topology by its serialized contents
+    const auto [entry, isNewTopology] = _topologyIndexes.try_emplace(_captured.dump(), _topologies.size());
+    if (isNewTopology) _topologies.push_back(HiCR::Topology(_captured));
+    _runnerTopologyIdx = entry->second;
+    _hasRunnerTopology = true;
+  }
+
+  /**
+   * [Internal] Turns the runner whose object just ended into a runner request
+   */
+  __INLINE__ void onRunnerComplete()
+  {
+    if (_hasRunnerFunction == false || _hasRunnerTopology == false)
+      HICR_THROW_LOGIC("[DeployR] Runner %lu in the deployment file must contain a 'Function' and a 'Topology'.\n", _runnerCount);
+
+    const auto [entry, isNewFunction] = _functionIndexes.try_emplace(_runnerFunction, _functions.size());
+    if (isNewFunction) _functions.push_back(_runnerFunction);
+
+    _runnerRequests.push_back({_runnerCount, entry->second, _runnerTopologyIdx});
+    _runnerCount++;
+  }
+
+  /// The requested runners
+  std::vector<runnerRequest_t> _runnerRequests;
+
+  /// The distinct initial functions
+  std::vector<std::string> _functions;
+
+  /// Index of each distinct function
+  std::unordered_map<std::string, size_t> _functionIndexes;
+
+  /// The distinct topologies
+  std::vector<HiCR::Topology> _topologies;
+
+  /// Index of each distinct topology, by its serialized contents
+  std::unordered_map<std::string, size_t> _topologyIndexes;
+
+  /// The communication groups
+  std::vector<Deployment::communicationGroup_t> _communicationGroups;
+
+  /// Number of runners parsed so far, which is the id of the next one
+  Runner::runnerId_t _runnerCount = 0;
+
+  /// Number of containers entered (not skipped, nor captured) at the current position
+  size_t _depth = 0;
+
+  /// The section being parsed
+  section_t _section = section_t::none;
+
+  /// The last key read outside of captured values
+  std::string _currentKey;
+
+  /// Number of nested containers of the skipped value at the current position, if any
+  size_t _skipDepth = 0;
+
+  /// The value being captured
+  nlohmann::json _captured;
+
+  /// Path from the captured value to the innermost container being captured
+  std::vector<nlohmann::json *> _captureStack;
+
+  /// The last key read inside of captured values
+  std::string _captureKey;
+
+  /// Initial function of the current runner
+  std::string _runnerFunction;
+
+  /// Whether the current runner has a function
+  bool _hasRunnerFunction = false;
+
+  /// Topology index of the current runner
+  size_t _runnerTopologyIdx = 0;
+
+  /// Whether the current runner has a topology
+  bool _hasRunnerTopology = false;
+
+}; // class DeploymentLoader
+
+} // namespace deployr
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/instance.hpp>
+#include <nlohmann_json/json.hpp>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <string>
+#include "deployment.hpp"
+#include "topologyCache.hpp"
+#include "wireFormat.hpp"
+
+namespace deployr
+{
+
+/**
+ * A deployment computed once (after gathering the topologies and matching), persisted so that restarting the same job on the same instances can skip straight to dispatch.
+ *
+ * Along with the deployment itself (runner ids, function names, instance pairings and requested topologies), the plan keeps the topology fingerprint of every participating
+ * instance, as computed by the instance itself (see TopologyCache), and a fingerprint of the request it was computed from (e.g., the deployment file, see fingerprintFile).
+ * DeployR::validateDeploymentPlan only exchanges fingerprints to check that nothing changed since. Payloads and communication groups are not part of the plan.
+ *
+ * Plans are stored as CBOR. The runners are stored as rows of [runner id, function index, instance id] (plus the topology index, if they requested one).
+ */
+class DeploymentPlan final
+{
+  public:
+
+  /// Version of the stored plans. Plans stored with a different version are not loaded
+  static constexpr uint64_t formatVersion = 1;
+
+  /// Request fingerprint of plans whose request is not to be checked
+  static constexpr uint64_t noRequestFingerprint = 0;
+
+  /**
+   * Creates an empty plan, which never validates
+   */
+  DeploymentPlan() = default;
+
+  /**
+   * Constructor for the deployment plan
+   *
+   * @param[in] deployment The deployment, with the runners already paired to their instances
+   * @param[in] fingerprints The topology fingerprint of each participating instance
+   * @param[in] requestFingerprint The fingerprint of the request the deployment was computed from, if it is to be checked
+   */
+  DeploymentPlan(Deployment deployment, std::map<HiCR::Instance::instanceId_t, TopologyCache::fingerprint_t> fingerprints, const uint64_t requestFingerprint = noRequestFingerprint)
+    : _deployment(std::move(deployment)),
+      _fingerprints(std::move(fingerprints)),
+      _requestFingerprint(requestFingerprint)
+  {}
+
+  /**
+   * Deserializing constructor for the deployment plan
+   *
+   * @param[in] serializedPlan The plan, as produced by serialize
+   */
+  DeploymentPlan(const nlohmann::json &serializedPlan)
+  {
+    if (serializedPlan.value("Version", (uint64_t)0) != formatVersion)
+      HICR_THROW_LOGIC("[DeployR] The deployment plan has version %lu, but version %lu is expected.\n", serializedPlan.value("Version", (uint64_t)0), formatVersion);
+
+    _requestFingerprint = serializedPlan["Request Fingerprint"].get<uint64_t>();
+    for (const auto &instance : serializedPlan["Instances"]) _fingerprints[instance[0].get<HiCR::Instance::instanceId_t>()] = instance[1].get<TopologyCache::fingerprint_t>();
+
+    for (const auto &topology : serializedPlan["Topologies"]) _deployment.addTopology(HiCR::Topology(topology));
+
+    const auto &functions = serializedPlan["Functions"];
+    const auto &runners   = serializedPlan["Runners"];
+    _deployment.reserve(runners.size());
+    for (const auto &runner : runners)
+    {
+      const auto functionIdx = runner[1].get<Deployment::functionIdx_t>();
+      if (functionIdx >= functions.size()) HICR_THROW_LOGIC("[DeployR] The deployment plan refers to function %u, but only has %lu.\n", functionIdx, functions.size());
+      const auto topologyIdx = runner.size() > 3 ? runner[3].get<Deployment::topologyIdx_t>() : Deployment::noTopology;
+      _deployment.emplaceRunner(runner[0].get<Runner::runnerId_t>(), functions[functionIdx].get<std::string>(), runner[2].get<HiCR::Instance::instanceId_t>(), topologyIdx);
+    }
+  }
+
+  ~DeploymentPlan() = default;
+
+  /**
+   * Serializes the plan
+   *
+   * @return The JSON-encoded plan
+   */
+  [[nodiscard]] __INLINE__ nlohmann::json serialize() const
+  {
+    nlohmann::json serializedPlan;
+    serializedPlan["Version"]             = formatVersion;
+    serializedPlan["Request Fingerprint"] = _requestFingerprint;
+
+    auto instances = nlohmann::json::array();
+    for (const auto &[instanceId, fingerprint] : _fingerprints) instances.push_back({instanceId, fingerprint});
+    serializedPlan["Instances"] = std::move(instances);
+
+    auto topologies = nlohmann::json::array();
+    for (const auto &topology : _deployment.getTopologies()) topologies.push_back(topology.serialize());
+    serializedPlan["Topologies"] = std::move(topologies);
+    serializedPlan["Functions"]  = _deployment.getFunctions();
+
+    const auto &runnerIds    = _deployment.getRunnerIds();
+    const auto &functionIdxs = _deployment.getFunctionIdxs();
+    const auto &instanceIds  = _deployment.getInstanceIds();
+    const auto &topologyIdxs = _deployment.getTopologyIdxs();
+    auto        runners      = nlohmann::json::array();
+    for (size_t i = 0; i < runnerIds.size(); i++)
+    {
+      runners.push_back({runnerIds[i], functionIdxs[i], instanceIds[i]});
+      if (topologyIdxs[i] != Deployment::noTopology) runners.back().push_back(topologyIdxs[i]);
+    }
+    serializedPlan["Runners"] = std::move(runners);
+
+    return serializedPlan;
+  }
+
+  /**
+   * Stores the plan in a file
+   *
+   * @param[in] filePath The path of the file to write
+   */
+  __INLINE__ void save(const std::string &filePath) const
+  {
+    std::ofstream file(filePath, std::ios::binary);
+    if (file.good() == false) HICR_THROW_RUNTIME("[DeployR] Could not open deployment plan file '%s' for writing.\n", filePath.c_str());
+
+    const auto buffer = WireFormat::encode(serialize(), WireFormat::encoding_t::cbor);
+    file.write(buffer.data(), (std::streamsize)buffer.size());
+    if (file.good() == false) HICR_THROW_RUNTIME("[DeployR] Could not write deployment plan file '%s'.\n", filePath.c_str());
+  }
+
+  /**
+   * Loads a plan stored with save
+   *
+   * @param[in] filePath The path of the file to read
+   *
+   * @return The plan, or nothing if the file does not exist or does not contain a plan of the current version. A full matching is then needed
+   */
+  [[nodiscard]] __INLINE__ static std::optional<DeploymentPlan> load(const std::string &filePath)
+  {
+    std::ifstream file(filePath, std::ios::binary);
+    if (file.good() == false) return std::nullopt;
+
+    const std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    try
+    {
+      return DeploymentPlan(WireFormat::decode(buffer.data(), buffer.size(), WireFormat::encoding_t::cbor));
+    }
+    catch (const std::exception &)
+    {
+      return std::nullopt;
+    }
+  }
+
+  /**
+   * Computes the fingerprint of a file (e.g., the deployment file a plan is computed from), as a 64-bit FNV-1a hash of its contents
+   *
+   * @param[in] filePath The path of the file
+   *
+   * @return The fingerprint of the file. It is never equal to noRequestFingerprint
+   */
+  [[nodiscard]] __INLINE__ static uint64_t fingerprintFile(const std::string &filePath)
+  {
+    std::ifstream file(filePath, std::ios::binary);
+    if (file.good() == false) HICR_THROW_RUNTIME("[DeployR] Could not open file '%s' to fingerprint it.\n", filePath.c_str());
+
+    uint64_t hash = 14695981039346656037ull;
+    for (auto c = std::istreambuf_iterator<char>(file); c != std::istreambuf_iterator<char>(); c++)
+    {
+      hash ^= (uint8_t)*c;
+      hash *= 1099511628211ull;
+    }
+    return hash == noRequestFingerprint ? 1 : hash;
+  }
+
+  /**
+   * Indicates whether the plan is empty, as when default-constructed
+   *
+   * @return true, if the plan has no participating instances; false, otherwise
+   */
+  [[nodiscard]] __INLINE__ bool isEmpty() const { return _fingerprints.empty(); }
+
+  /**
+   * Gets the deployment of the plan
+   *
+   * @return The deployment
+   */
+  [[nodiscard]] __INLINE__ const Deployment &getDeployment() const { return _deployment; }
+
+  /**
+   * Gets the topology fingerprint of each participating instance
+   *
+   * @return A map from instance id to its topology fingerprint
+   */
+  [[nodiscard]] __INLINE__ const std::map<HiCR::Instance::instanceId_t, TopologyCache::fingerprint_t> &getFingerprints() const { return _fingerprints; }
+
+  /**
+   * Gets the fingerprint of the request the plan was computed from
+   *
+   * @return The request fingerprint, or noRequestFingerprint if it is not to be checked
+   */
+  [[nodiscard]] __INLINE__ uint64_t getRequestFingerprint() const { return _requestFingerprint; }
+
+  private:
+
+  /// The deployment, with the runners paired to their instances
+  Deployment _deployment;
+
+  /// The topology fingerprint of each participating instance
+  std::map<HiCR::Instance::instanceId_t, TopologyCache::fingerprint_t> _fingerprints;
+
+  /// The fingerprint of the request the deployment was computed from
+  uint64_t _requestFingerprint = noRequestFingerprint;
+
+}; // class DeploymentPlan
+
+} // namespace deployr
@@ -5,14 +5,72 @@
 #include <hicr/core/definitions.hpp>
 #include <nlohmann_json/json.hpp>
 #include <nlohmann_json/parser.hpp>
-#include <hopcroft_karp/hopcroft_karp.hpp>
 #include <hicr/backends/pthreads/computeManager.hpp>
-#include <hicr/frontends/RPCEngine/RPCEngine.hpp>
+#ifdef _DEPLOYR_DISTRIBUTED_ENGINE_LOCAL
+  #include "local/instanceManager.hpp"
+  #include "local/rpcEngine.hpp"
+#else
+  #include <hicr/core/instanceManager.hpp>
+  #include <hicr/frontends/RPCEngine/RPCEngine.hpp>
+#endif
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include "bipartiteMatcher.hpp"
 #include "deployment.hpp"
+#include "deploymentHandle.hpp"
+#include "deploymentPlan.hpp"
+#include "flowNetwork.hpp"
+#include "heartbeat.hpp"
+#include "launchPlan.hpp"
+#include "leaseRegistry.hpp"
+#include "packingMatcher.hpp"
+#include "partitionShare.hpp"
+#include "partitionSummary.hpp"
+#include "resourcePinner.hpp"
+#include "resourceSignatures.hpp"
+#include "topologyCache.hpp"
+#include "tracer.hpp"
+#include "wireFormat.hpp"
+#include "workerPool.hpp"
 
 #define __DEPLOYR_GET_TOPOLOGY_RPC_NAME "[DeployR] Get Topology"
+#define __DEPLOYR_GET_TOPOLOGY_IF_CHANGED_RPC_NAME "[DeployR] Get Topology If Changed"
+#define __DEPLOYR_GATHER_SUBTREE_TOPOLOGY_RPC_NAME "[DeployR] Gather Subtree Topology"
+#define __DEPLOYR_LAUNCH_SUBTREE_RPC_NAME "[DeployR] Launch Subtree"
+#define __DEPLOYR_GET_LAUNCH_PLAN_RPC_NAME "[DeployR] Get Launch Plan"
+#define __DEPLOYR_REPORT_RUNNER_COMPLETION_RPC_NAME "[DeployR] Report Runner Completion"
+#define __DEPLOYR_SHUTDOWN_RPC_NAME "[DeployR] Shutdown"
+#define __DEPLOYR_START_RUNNER_RPC_NAME "[DeployR] Start Runner"
+#define __DEPLOYR_GET_TRACE_RPC_NAME "[DeployR] Get Trace"
+#define __DEPLOYR_GET_RUNNER_PAYLOAD_RPC_NAME "[DeployR] Get Runner Payload"
+#define __DEPLOYR_HEARTBEAT_RPC_NAME "[DeployR] Heartbeat"
+#define __DEPLOYR_CHECK_LEASES_RPC_NAME "[DeployR] Check Leases"
+#define __DEPLOYR_GET_TOPOLOGY_FINGERPRINT_RPC_NAME "[DeployR] Get Topology Fingerprint"
+#define __DEPLOYR_DEPLOYMENT_PLAN_VERDICT_RPC_NAME "[DeployR] Deployment Plan Verdict"
+#define __DEPLOYR_GET_PARTITION_SUMMARY_RPC_NAME "[DeployR] Get Partition Summary"
+#define __DEPLOYR_GET_PARTITION_SHARE_RPC_NAME "[DeployR] Get Partition Share"
+#define __DEPLOYR_RELEASE_PARTITION_HOST_RPC_NAME "[DeployR] Release Partition Host"
+#define __DEPLOYR_REPORT_PARTITION_COMPLETION_RPC_NAME "[DeployR] Report Partition Completion"
+#define __DEPLOYR_GET_PARTITION_REPORT_RPC_NAME "[DeployR] Get Partition Report"
+#define __DEPLOYR_DEFAULT_TOPOLOGY_GATHER_TREE_FANOUT 2
+#define __DEPLOYR_DEFAULT_LAUNCH_TREE_FANOUT 2
+#define __DEPLOYR_PARALLEL_COMPATIBILITY_MIN_PAIRS 1024
+#define __DEPLOYR_DEFAULT_PROVISIONING_CONCURRENCY 8
+#define __DEPLOYR_DEFAULT_PAYLOAD_INLINE_MAX_SIZE 4096
+#define __DEPLOYR_LOCALITY_KEY "Locality"
+#define __DEPLOYR_LOCALITY_SEPARATOR '/'
+#define __DEPLOYR_LOCALITY_MAX_PASSES 16
 
 namespace deployr
 {
@@ -24,10 +82,95 @@ class DeployR final
 {
   public:
 
+  /// Type for the numeric ids function names are interned into, so that start commands carry an integer rather than the name
+  typedef LaunchPlan::functionId_t functionId_t;
+
+#ifdef _DEPLOYR_DISTRIBUTED_ENGINE_LOCAL
+  /// Type of the instance manager, provided by the in-process local engine (see local::Engine)
+  typedef local::InstanceManager instanceManager_t;
+
+  /// Type of the RPC engine, provided by the in-process local engine (see local::Engine)
+  typedef local::RPCEngine rpcEngine_t;
+#else
+  /// Type of the instance manager, provided by HiCR
+  typedef HiCR::InstanceManager instanceManager_t;
+
+  /// Type of the RPC engine, provided by HiCR
+  typedef HiCR::frontend::RPCEngine rpcEngine_t;
+#endif
+
+  /**
+   * Strategies available for gathering the local topologies of the participating instances
+   */
+  enum topologyGatherMode_t
+  {
+    /// The root requests the topology of each instance, one after the other
+    serial,
+
+    /// The instances are arranged in a k-ary tree. Each interior instance collects the topologies of its subtree and returns them to its parent in a single reply
+    tree,
+
+    /// The root requests the topology of all instances up front, and collects the replies in request order, deserializing each on a worker pool while waiting for the next
+    pipelined
+  };
+
+  /**
+   * Strategies available for starting the runners of a deployment
+   */
+  enum launchMode_t
+  {
+    /// The coordinator sends the start command to each runner, one after the other
+    serialLaunch,
+
+    /// The coordinator sends a single start command to each host, which the host answers by requesting its launch plan, listing all of its runners, and starts them on local threads.
+    /// Since an RPC argument is too small to carry the plan, this takes one round trip per host on top of the start command
+    batchedLaunch,
+
+    /// The hosts are arranged in a k-ary tree. Each host requests its launch plan from its parent, and forwards the start command to its children before starting its own runners
+    treeLaunch
+  };
+
+  /**
+   * Statistics about the last launch of a deployment, as observed by its coordinator
+   */
+  struct launchStatistics_t
+  {
+    /// The launch mode used
+    launchMode_t mode;
+
+    /// Number of runners launched, including the coordinator's own, if any
+    size_t runnerCount;
+
+    /// Maximum number of forwarding hops between the coordinator and a runner
+    size_t treeDepth;
+
+    /// Number of start commands sent by the coordinator itself
+    size_t coordinatorMessageCount;
+
+    /// Time (in seconds) the coordinator spent dispatching start commands, before running its own initial function
+    double coordinatorDispatchTime;
+
+    /// Rough estimate (in seconds) of the time between the first and the last runner starting: the coordinator's dispatch time times the tree depth. It is not a bound,
+    /// as the hosts of deeper levels also fetch their launch plan before forwarding it, and their dispatch time may differ from the coordinator's
+    double estimatedLaunchSkew;
+  };
+
+  /**
+   * A partition of the hosts of a hierarchical deployment (e.g., a rack or a node group), managed by its own coordinator (see deployHierarchical)
+   */
+  struct partition_t
+  {
+    /// The id of the instance that gathers the topologies of the hosts, matches their share of the runners to them and launches it
+    HiCR::Instance::instanceId_t coordinatorInstanceId;
+
+    /// The ids of the hosts in the partition. They may include the coordinator of the partition itself
+    std::vector<HiCR::Instance::instanceId_t> instanceIds;
+  };
+
   /**
    * Default constructor for DeployR. It creates the HiCR management engine and registers the basic functions needed during deployment.
    */
-  DeployR(HiCR::InstanceManager *instanceManager, HiCR::frontend::RPCEngine *rpcEngine, const HiCR::Topology &localTopology)
+  DeployR(instanceManager_t *instanceManager, rpcEngine_t *rpcEngine, const HiCR::Topology &localTopology)
     : _instanceManager(instanceManager),
       _rpcEngine(rpcEngine),
       _localTopology(localTopology)
@@ -40,244 +183,2809 @@ class DeployR final
    */
   __INLINE__ void initialize()
   {
+    // The events recorded by this instance are tagged with its id
+    _tracer.setInstanceId(_instanceManager->getCurrentInstance()->getId());
+
     // Registering topology exchanging RPC
     auto gatherTopologyRPC = [this]() {
+      auto span = _tracer.span("Serve Topology", "RPC");
+
+      // The encoding is decided by the requester and passed along as argument
+      const auto encoding = (WireFormat::encoding_t)_rpcEngine->getRPCArgument();
+
       // Serializing
-      const auto serializedTopology = _localTopology.serialize().dump();
+      const auto serializedTopology = WireFormat::encode(serializeLocalTopology(), encoding);
+      span.setBytes(serializedTopology.size());
 
       // Returning serialized topology
-      _rpcEngine->submitReturnValue((void *)serializedTopology.c_str(), serializedTopology.size() + 1);
+      _rpcEngine->submitReturnValue((void *)serializedTopology.data(), serializedTopology.size());
     };
 
     // Adding RPC
     registerRPC(__DEPLOYR_GET_TOPOLOGY_RPC_NAME, gatherTopologyRPC);
+
+    // Computing the fingerprint of the local topology, for the root to check whether the one it has cached is still valid
+    _localTopologyFingerprint = TopologyCache::fingerprint(serializeLocalTopology());
+
+    // Registering cached topology exchanging RPC
+    auto gatherTopologyIfChangedRPC = [this]() {
+      auto span = _tracer.span("Serve Topology", "RPC");
+
+      // The requester passes the fingerprint it has cached for this instance and the encoding along as argument
+      const auto argument         = _rpcEngine->getRPCArgument();
+      const auto knownFingerprint = (TopologyCache::fingerprint_t)(argument >> 8);
+      const auto encoding         = (WireFormat::encoding_t)(argument & 0xFF);
+
+      // Always replying with the fingerprint, but only sending the full topology if the requester's one is outdated
+      nlohmann::json reply;
+      reply["Fingerprint"] = _localTopologyFingerprint;
+      if (knownFingerprint != _localTopologyFingerprint) reply["Topology"] = serializeLocalTopology();
+
+      // Returning serialized reply
+      const auto serializedReply = WireFormat::encode(reply, encoding);
+      span.setBytes(serializedReply.size());
+      _rpcEngine->submitReturnValue((void *)serializedReply.data(), serializedReply.size());
+    };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_GET_TOPOLOGY_IF_CHANGED_RPC_NAME, gatherTopologyIfChangedRPC);
+
+    // Registering subtree topology gathering RPC, used by the tree gather mode
+    auto gatherSubtreeTopologyRPC = [this]() {
+      // The fanout of the tree and the encoding are decided by the root and passed along as argument
+      const auto argument = _rpcEngine->getRPCArgument();
+      const auto fanout   = (size_t)(argument >> 8);
+      const auto encoding = (WireFormat::encoding_t)(argument & 0xFF);
+
+      // Finding this instance's position in the gather tree
+      const auto currentInstanceId = _instanceManager->getCurrentInstance()->getId();
+      const auto position          = std::find(_topologyGatherTree.begin(), _topologyGatherTree.end(), currentInstanceId) - _topologyGatherTree.begin();
+      if ((size_t)position == _topologyGatherTree.size())
+        HICR_THROW_RUNTIME("[DeployR] Instance %lu is not part of the topology gather tree. Tree gathers require all participating instances to call gatherGlobalTopology.\n",
+                           currentInstanceId);
+
+      // Gathering the topologies of the entire subtree rooted at this instance
+      auto       span              = _tracer.span("Serve Subtree Topology", "RPC");
+      const auto serializedSubtree = WireFormat::encode(gatherSubtreeTopologies(position, fanout, encoding), encoding);
+      span.setBytes(serializedSubtree.size());
+
+      // Returning all of them in a single reply
+      _rpcEngine->submitReturnValue((void *)serializedSubtree.data(), serializedSubtree.size());
+    };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_GATHER_SUBTREE_TOPOLOGY_RPC_NAME, gatherSubtreeTopologyRPC);
+
+    // Registering subtree launching RPC, used by the tree launch mode
+    auto launchSubtreeRPC = [this]() {
+      // A partition host waits for nothing else from its partition coordinator
+      _isAwaitingPartitionStart = false;
+
+      // The parent passes its own instance id along as argument, for this instance to fetch its launch plan from it
+      const auto parentInstanceId  = (HiCR::Instance::instanceId_t)_rpcEngine->getRPCArgument();
+      const auto currentInstanceId = _instanceManager->getCurrentInstance()->getId();
+      const auto parentInstance    = getInstance(parentInstanceId);
+      if (parentInstance == nullptr) HICR_THROW_RUNTIME("[DeployR] Launch parent instance %lu not found in the instance manager provided.\n", parentInstanceId);
+
+      // Fetching the launch plan of the subtree rooted at this instance
+      nlohmann::json plan;
+      {
+        auto span = _tracer.span("Fetch Launch Plan", "RPC", parentInstanceId);
+        requestRPC(*parentInstance, __DEPLOYR_GET_LAUNCH_PLAN_RPC_NAME, currentInstanceId);
+        auto returnValue = getReturnValue(*parentInstance);
+        plan             = WireFormat::decode(returnValue->getPointer(), returnValue->getSize(), WireFormat::encoding_t::cbor);
+        span.setBytes(returnValue->getSize());
+        _rpcEngine->getMemoryManager()->freeLocalMemorySlot(returnValue);
+      }
+
+      // The first host in the plan is this instance
+      const auto &hosts = plan["Hosts"];
+      if (hosts.empty() || hosts[0]["Instance Id"].get<HiCR::Instance::instanceId_t>() != currentInstanceId)
+        HICR_THROW_RUNTIME("[DeployR] Instance %lu received a launch plan that does not start with its own runners.\n", currentInstanceId);
+
+      // The runners send heartbeats to the coordinator while they run, if it holds a lease on this instance
+      _coordinatorInstanceId       = plan["Coordinator"].get<HiCR::Instance::instanceId_t>();
+      const auto heartbeatInterval = LaunchPlan::getHeartbeatInterval(hosts[0]);
+
+      // Forwarding the start command to the rest of the subtree first, then running this instance's runners
+      dispatchLaunchPlan(hosts, 1, hosts.size(), plan["Fanout"].get<size_t>());
+      runLocalRunners(receiveHostRunners(hosts[0]), heartbeatInterval);
+    };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_LAUNCH_SUBTREE_RPC_NAME, launchSubtreeRPC);
+
+    // Registering launch plan serving RPC, requested by the children of an instance in the launch tree
+    auto getLaunchPlanRPC = [this]() {
+      // The child passes its own instance id along as argument
+      const auto childInstanceId = (HiCR::Instance::instanceId_t)_rpcEngine->getRPCArgument();
+      const auto entry           = _pendingLaunchPlans.find(childInstanceId);
+      if (entry == _pendingLaunchPlans.end()) HICR_THROW_RUNTIME("[DeployR] No launch plan is pending for instance %lu.\n", childInstanceId);
+
+      // Returning the plan, and forgetting it. It is encoded as CBOR, so that the inline payloads of the runners travel as binary
+      auto       span           = _tracer.span("Serve Launch Plan", "RPC", childInstanceId);
+      const auto serializedPlan = WireFormat::encode(entry->second, WireFormat::encoding_t::cbor);
+      span.setBytes(serializedPlan.size());
+      _pendingLaunchPlans.erase(entry);
+      _rpcEngine->submitReturnValue((void *)serializedPlan.data(), serializedPlan.size());
+    };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_GET_LAUNCH_PLAN_RPC_NAME, getLaunchPlanRPC);
+
+    // Registering runner completion RPC, used by the hosts to report to the coordinator
+    auto reportRunnerCompletionRPC = [this]() {
+      // The runner id and whether it failed are passed along as argument
+      const auto argument = _rpcEngine->getRPCArgument();
+      recordRunnerCompletion((Runner::runnerId_t)(argument >> 1), (argument & 1) == 1);
+    };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_REPORT_RUNNER_COMPLETION_RPC_NAME, reportRunnerCompletionRPC);
+
+    // Registering shutdown RPC, which makes a serving instance return from serve
+    auto shutdownRPC = [this]() { _isServing = false; };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_SHUTDOWN_RPC_NAME, shutdownRPC);
+
+    // Registering runner starting RPC, used by the serial launch mode. The function id and runner id are packed in the argument
+    auto startRunnerRPC = [this]() {
+      const auto argument = _rpcEngine->getRPCArgument();
+      startRunner((functionId_t)(argument >> 32), (Runner::runnerId_t)(argument & 0xFFFFFFFF));
+    };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_START_RUNNER_RPC_NAME, startRunnerRPC);
+
+    // Registering trace collection RPC. The events are moved to the requester, so that they are not collected twice
+    auto getTraceRPC = [this]() {
+      const auto serializedTrace = WireFormat::encode(_tracer.serialize(), WireFormat::encoding_t::json);
+      _tracer.clear();
+      _rpcEngine->submitReturnValue((void *)serializedTrace.data(), serializedTrace.size());
+    };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_GET_TRACE_RPC_NAME, getTraceRPC);
+
+    // Registering runner payload serving RPC, requested by the hosts of runners whose payload is not sent inline. The runner id is passed along as argument
+    auto getRunnerPayloadRPC = [this]() {
+      const auto runnerId = (Runner::runnerId_t)_rpcEngine->getRPCArgument();
+      const auto entry    = _pendingPayloads.find(runnerId);
+      if (entry == _pendingPayloads.end()) HICR_THROW_RUNTIME("[DeployR] No payload is pending for runner %lu.\n", runnerId);
+
+      // Returning the payload straight from its buffer, and forgetting it
+      auto span = _tracer.span("Serve Payload", "RPC");
+      span.setBytes(entry->second.size);
+      const auto payload = std::move(entry->second);
+      _pendingPayloads.erase(entry);
+      _rpcEngine->submitReturnValue((void *)payload.data.get(), payload.size);
+    };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_GET_RUNNER_PAYLOAD_RPC_NAME, getRunnerPayloadRPC);
+
+    // Registering heartbeat RPC, used by the hosts to renew their lease with the coordinator. The host's instance id is passed along as argument
+    auto heartbeatRPC = [this]() { _leaseRegistry.renew((HiCR::Instance::instanceId_t)_rpcEngine->getRPCArgument()); };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_HEARTBEAT_RPC_NAME, heartbeatRPC);
+
+    // Registering lease checking RPC, requested periodically by the coordinator to itself, so that it is served by the thread listening for the heartbeats.
+    // The time of the request is passed along as argument: heartbeats received before it are always served first, even if the coordinator was not listening for a while
+    auto checkLeasesRPC = [this]() {
+      const auto checkTime = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(_rpcEngine->getRPCArgument()));
+
+      // Allowing the next check to be requested, which respawning runners may listen for
+      _isLeaseCheckPending = false;
+      checkLeases(checkTime);
+    };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_CHECK_LEASES_RPC_NAME, checkLeasesRPC);
+
+    // Registering topology fingerprint RPC, used by the root to validate a deployment plan without exchanging the topologies themselves
+    auto getTopologyFingerprintRPC = [this]() {
+      auto span = _tracer.span("Serve Topology Fingerprint", "RPC");
+      span.setBytes(sizeof(_localTopologyFingerprint));
+      _rpcEngine->submitReturnValue((void *)&_localTopologyFingerprint, sizeof(_localTopologyFingerprint));
+    };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_GET_TOPOLOGY_FINGERPRINT_RPC_NAME, getTopologyFingerprintRPC);
+
+    // Registering deployment plan verdict RPC, with which the root tells the participating instances whether the plan is still valid. The verdict is passed along as argument
+    auto deploymentPlanVerdictRPC = [this]() { _deploymentPlanVerdict = _rpcEngine->getRPCArgument() == 1; };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_DEPLOYMENT_PLAN_VERDICT_RPC_NAME, deploymentPlanVerdictRPC);
+
+    // Registering partition summary serving RPC, requested by the global coordinator of a hierarchical deployment from the coordinator of each partition
+    auto getPartitionSummaryRPC = [this]() {
+      if (_pendingPartitionSummary.has_value() == false)
+        HICR_THROW_RUNTIME("[DeployR] No partition summary is pending at instance %lu.\n", _instanceManager->getCurrentInstance()->getId());
+
+      // Returning the summary, and forgetting it
+      auto       span              = _tracer.span("Serve Partition Summary", "RPC");
+      const auto serializedSummary = WireFormat::encode(_pendingPartitionSummary.value(), WireFormat::encoding_t::cbor);
+      span.setBytes(serializedSummary.size());
+      _pendingPartitionSummary.reset();
+      _rpcEngine->submitReturnValue((void *)serializedSummary.data(), serializedSummary.size());
+    };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_GET_PARTITION_SUMMARY_RPC_NAME, getPartitionSummaryRPC);
+
+    // Registering partition share serving RPC, requested by the coordinator of each partition of a hierarchical deployment. It passes its own instance id along as argument
+    auto getPartitionShareRPC = [this]() {
+      const auto partitionCoordinatorInstanceId = (HiCR::Instance::instanceId_t)_rpcEngine->getRPCArgument();
+      const auto entry                          = _pendingPartitionShares.find(partitionCoordinatorInstanceId);
+      if (entry == _pendingPartitionShares.end()) HICR_THROW_RUNTIME("[DeployR] No partition share is pending for instance %lu.\n", partitionCoordinatorInstanceId);
+
+      // Returning the share, and forgetting it. It is encoded as CBOR, so that the payloads of the runners travel as binary
+      auto       span            = _tracer.span("Serve Partition Share", "RPC", partitionCoordinatorInstanceId);
+      const auto serializedShare = WireFormat::encode(entry->second.serialize(), WireFormat::encoding_t::cbor);
+      span.setBytes(serializedShare.size());
+      _pendingPartitionShares.erase(entry);
+      _rpcEngine->submitReturnValue((void *)serializedShare.data(), serializedShare.size());
+    };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_GET_PARTITION_SHARE_RPC_NAME, getPartitionShareRPC);
+
+    // Registering partition host release RPC, with which a partition coordinator lets the hosts left without runners return
+    auto releasePartitionHostRPC = [this]() { _isAwaitingPartitionStart = false; };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_RELEASE_PARTITION_HOST_RPC_NAME, releasePartitionHostRPC);
+
+    // Registering partition completion RPC, with which the coordinator of a partition tells the global coordinator that all of its runners are done.
+    // The partition coordinator passes its own instance id along as argument, for the global coordinator to fetch the report from it
+    auto reportPartitionCompletionRPC = [this]() {
+      const auto partitionCoordinatorInstanceId = (HiCR::Instance::instanceId_t)_rpcEngine->getRPCArgument();
+      const auto partitionCoordinatorInstance   = getInstance(partitionCoordinatorInstanceId);
+      if (partitionCoordinatorInstance == nullptr)
+        HICR_THROW_RUNTIME("[DeployR] Partition coordinator instance %lu not found in the instance manager provided.\n", partitionCoordinatorInstanceId);
+      const auto entry = _partitionRunnerIds.find(partitionCoordinatorInstanceId);
+      if (entry == _partitionRunnerIds.end())
+        HICR_THROW_RUNTIME("[DeployR] Received a completion report from instance %lu, which coordinates no running partition.\n", partitionCoordinatorInstanceId);
+
+      // Fetching the report, which only lists the runners that failed
+      nlohmann::json report;
+      {
+        auto span = _tracer.span("Fetch Partition Report", "RPC", partitionCoordinatorInstanceId);
+        requestRPC(*partitionCoordinatorInstance, __DEPLOYR_GET_PARTITION_REPORT_RPC_NAME);
+        auto returnValue = getReturnValue(*partitionCoordinatorInstance);
+        report           = WireFormat::decode(returnValue->getPointer(), returnValue->getSize(), WireFormat::encoding_t::cbor);
+        span.setBytes(returnValue->getSize());
+        _rpcEngine->getMemoryManager()->freeLocalMemorySlot(returnValue);
+      }
+
+      // Recording the completion of every runner of the partition
+      const auto failedRunnerIds = report["Failed Runner Ids"].get<std::unordered_set<Runner::runnerId_t>>();
+      for (const auto runnerId : entry->second) recordRunnerCompletion(runnerId, failedRunnerIds.contains(runnerId));
+      _partitionRunnerIds.erase(entry);
+    };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_REPORT_PARTITION_COMPLETION_RPC_NAME, reportPartitionCompletionRPC);
+
+    // Registering partition report serving RPC, requested by the global coordinator once the coordinator of a partition reports its completion
+    auto getPartitionReportRPC = [this]() {
+      if (_pendingPartitionReport.has_value() == false)
+        HICR_THROW_RUNTIME("[DeployR] No partition report is pending at instance %lu.\n", _instanceManager->getCurrentInstance()->getId());
+
+      // Returning the report, and forgetting it
+      auto       span             = _tracer.span("Serve Partition Report", "RPC");
+      const auto serializedReport = WireFormat::encode(_pendingPartitionReport.value(), WireFormat::encoding_t::cbor);
+      span.setBytes(serializedReport.size());
+      _pendingPartitionReport.reset();
+      _rpcEngine->submitReturnValue((void *)serializedReport.data(), serializedReport.size());
+    };
+
+    // Adding RPC
+    registerRPC(__DEPLOYR_GET_PARTITION_REPORT_RPC_NAME, getPartitionReportRPC);
+  }
+
+  /**
+   * Attempts to deploy a deployment request. 
+   * 
+   * If not enough (or too many) hosts are detected than the request needs, it will abort execution.
+   * If a good mapping is found, it will run each of the requested instance in one of the found hosts and run its initial function.
+   * 
+   * In the batched and tree launch modes, a single start command is sent per host, and several runners may be paired with the same host. They are started on local threads.
+   * In the tree launch mode, the start command reaches every host in O(log N) forwarding hops, so that all runners start close to each other.
+   * Statistics about the launch can be retrieved afterwards at the coordinator with getLaunchStatistics.
+   * 
+   * The payload of each runner, if any (see Deployment::setPayload), is delivered along with its start command, and can be read by the runner with getRunnerPayload.
+   * Payloads up to a size (see setPayloadInlineMaxSize) travel inside the launch plan. Larger ones are requested by their hosts from the coordinator and returned by the
+   * RPC engine straight from the payload buffer, without serializing them, before the coordinator runs its own runners. Remote payloads need the batched or tree launch modes.
+   * 
+   * When leases are enabled (see setLeases), the remote runners whose host fails are respawned on spare hosts while their completion is awaited.
+   * 
+   * The coordinator runs its own runners, if any, before returning. The completion of the remote runners is awaited by finalize.
+   * 
+   * @param[in] deploymnet A deployment object containing the configuration required to deploy a job
+   * @param[in] coordinatorInstanceId The id of the instance that coordinates the deployment
+   * @param[in] launchMode The strategy for starting the runners. Only needs to be decided by the coordinator
+   */
+  __INLINE__ void deploy(const Deployment &deployment, const HiCR::Instance::instanceId_t coordinatorInstanceId, const launchMode_t launchMode = launchMode_t::serialLaunch)
+  {
+    deployAsync(deployment, coordinatorInstanceId, launchMode)->runLocalRunners();
+  }
+
+  /**
+   * Deploys a deployment request like deploy, but without running the runners assigned to the coordinator, so that it can overlap its own setup with the remote runners starting.
+   * 
+   * The returned handle tracks the state of every runner. Its wait function runs the runners assigned to the coordinator and then receives the completion reports of the remote ones.
+   * The reports are only received while the coordinator listens (e.g., in wait or finalize), so finalize must be called before destroying this object.
+   * Non-coordinator instances run their runners before returning, and get an empty handle.
+   * 
+   * @param[in] deploymnet A deployment object containing the configuration required to deploy a job
+   * @param[in] coordinatorInstanceId The id of the instance that coordinates the deployment
+   * @param[in] launchMode The strategy for starting the runners. Only needs to be decided by the coordinator
+   * 
+   * @return A handle to track the progress of the deployment
+   */
+  [[nodiscard]] __INLINE__ std::shared_ptr<DeploymentHandle> deployAsync(const Deployment                  &deployment,
+                                                                         const HiCR::Instance::instanceId_t coordinatorInstanceId,
+                                                                         const launchMode_t                 launchMode = launchMode_t::serialLaunch)
+  {
+    // Getting this running instance information
+    const auto &currentInstance   = _instanceManager->getCurrentInstance();
+    const auto  currentInstanceId = currentInstance->getId();
+
+    // Getting runner set
+    const auto  &runnerIds    = deployment.getRunnerIds();
+    const auto  &functionIdxs = deployment.getFunctionIdxs();
+    const auto  &instanceIds  = deployment.getInstanceIds();
+    const auto  &topologyIdxs = deployment.getTopologyIdxs();
+    const size_t runnerCount  = deployment.getRunnerCount();
+
+    // Gathering requested runner ids into a set
+    const std::unordered_set<Runner::runnerId_t> uniqueRunnerIds(runnerIds.begin(), runnerIds.end());
+
+    // Sanity check: make sure there are no repeated runners
+    if (runnerCount != uniqueRunnerIds.size()) HICR_THROW_LOGIC("[DeployR] A repeated runner id was provided.\n");
+
+    // Remembering the coordinator, for the runners to report their completion to it
+    _coordinatorInstanceId = coordinatorInstanceId;
+
+    // Bifurcation point: this is only run by the non-coordinator instance
+    // they are captured until the coordinator syncs up with them
+    if (currentInstanceId != coordinatorInstanceId)
+    {
+      listen();
+      return std::make_shared<DeploymentHandle>();
+    }
+
+    // Interning the function names once per distinct function
+    std::vector<functionId_t> functionIds;
+    functionIds.reserve(deployment.getFunctions().size());
+    for (const auto &function : deployment.getFunctions()) functionIds.push_back(getFunctionId(function));
+
+    // Start commands still to be sent, in launch plan form: one entry per host, in order of first appearance, with all of its runners
+    LaunchPlan launchPlan(currentInstanceId, deployment.getTopologies(), _payloadInlineMaxSize, _isRunnerPinningEnabled, _heartbeatInterval);
+
+    // When leasing, the remote runners are kept along with their payloads and requested topologies (shared among them), in case they need to be respawned on a spare host
+    const bool                                         isLeasing = _heartbeatInterval.count() > 0;
+    std::vector<LeaseRegistry::leasedRunner_t>         leasedRunners;
+    std::vector<std::shared_ptr<const HiCR::Topology>> leasedTopologies(isLeasing ? deployment.getTopologies().size() : 0);
+
+    // Finding out the start commands for each of the paired hosts
+    for (size_t i = 0; i < runnerCount; i++)
+    {
+      const auto instanceId = instanceIds[i];
+
+      // Checking the instance corresponding to the provided Id exists
+      if (getInstance(instanceId) == nullptr) HICR_THROW_LOGIC("[DeployR] Provided instance id %lu not found in the instance manager provided.\n", instanceId);
+
+      // Adding the start command to the launch plan. The runners of this host are remembered along with their payloads, but their execution is delayed
+      const auto &payload    = deployment.getPayload(i);
+      const auto  functionId = functionIds[functionIdxs[i]];
+      launchPlan.addRunner(instanceId, runnerIds[i], functionId, payload, topologyIdxs[i]);
+
+      if (isLeasing == false || instanceId == currentInstanceId) continue;
+      std::shared_ptr<const HiCR::Topology> topology;
+      if (topologyIdxs[i] != Deployment::noTopology)
+      {
+        auto &leasedTopology = leasedTopologies[topologyIdxs[i]];
+        if (leasedTopology == nullptr) leasedTopology = std::make_shared<const HiCR::Topology>(deployment.getTopologies()[topologyIdxs[i]]);
+        topology = leasedTopology;
+      }
+      leasedRunners.push_back({instanceId, runnerIds[i], functionId, payload, topology, nullptr});
+    }
+
+    // Sanity check: the serial launch mode sends one start command per runner, to which each host only listens once
+    if (launchMode == launchMode_t::serialLaunch)
+    {
+      launchPlan.checkSerialLaunch();
+      if (leasedRunners.empty() == false) HICR_THROW_LOGIC("[DeployR] Leases need the batched or tree launch modes, whose start commands carry the heartbeat interval.\n");
+    }
+
+    // The remote runners whose payload is not sent inline request it once started, from its buffer
+    std::vector<Runner::runnerId_t> payloadRunnerIds;
+    for (const auto &[runnerId, payload] : launchPlan.getServedPayloads())
+    {
+      _pendingPayloads[runnerId] = payload;
+      payloadRunnerIds.push_back(runnerId);
+    }
+    const auto &entries = launchPlan.getEntries();
+
+    // Creating the handle before sending the start commands, since completion reports may arrive while dispatching. Before running the local runners, the coordinator
+    // serves the payloads not sent inline, so that the remote runners do not wait for the local ones to finish. Those of the runners that completed or failed are not waited for
+    auto handle = std::make_shared<DeploymentHandle>(
+      [this, localRunners = launchPlan.getLocalRunners(), payloadRunnerIds](DeploymentHandle &deploymentHandle) {
+        while (std::any_of(payloadRunnerIds.begin(), payloadRunnerIds.end(), [this](const auto id) { return _pendingPayloads.contains(id); })) listen();
+        for (const auto runnerId : localRunners.runnerIds) deploymentHandle.setState(runnerId, DeploymentHandle::runnerState_t::launched);
+        runLocalRunners(localRunners);
+      },
+      [this]() { listen(); });
+    for (const auto runnerId : launchPlan.getLocalRunners().runnerIds) handle->setState(runnerId, DeploymentHandle::runnerState_t::pending);
+    for (const auto &host : entries)
+      for (const auto &runnerId : host["Runner Ids"]) handle->setState(runnerId.get<Runner::runnerId_t>(), DeploymentHandle::runnerState_t::launched);
+    _activeDeployments.push_back(handle);
+
+    // Granting the leases before sending the start commands, since heartbeats may arrive while dispatching
+    for (auto &runner : leasedRunners)
+    {
+      runner.handle = handle;
+      grantLease(std::move(runner));
+    }
+
+    // Sending the start commands
+    auto       dispatchSpan      = _tracer.span("Dispatch", "Phase");
+    const auto dispatchStartTime = std::chrono::steady_clock::now();
+    size_t     messageCount      = 0;
+    size_t     treeDepth         = entries.empty() ? 0 : 1;
+    if (launchMode == launchMode_t::serialLaunch)
+    {
+      // Index of each runner in the deployment, built on first use
+      std::unordered_map<Runner::runnerId_t, size_t> runnerIdxs;
+
+      // Sending RPCs to the paired hosts to start deployment, with the function id and runner id packed in the argument
+      for (const auto &host : entries)
+      {
+        const auto functionId = host["Function Ids"][0].get<functionId_t>();
+        const auto runnerId   = host["Runner Ids"][0].get<Runner::runnerId_t>();
+        const auto instance   = getInstance(host["Instance Id"].get<HiCR::Instance::instanceId_t>());
+
+        // Runner ids that do not fit in the lower half of the argument are sent to the RPC named after the function instead
+        if (runnerId > 0xFFFFFFFF)
+        {
+          if (runnerIdxs.empty())
+            for (size_t i = 0; i < runnerCount; i++) runnerIdxs[runnerIds[i]] = i;
+          requestRPC(*instance, deployment.getFunctions()[functionIdxs[runnerIdxs.at(runnerId)]], runnerId);
+        }
+        else requestRPC(*instance, __DEPLOYR_START_RUNNER_RPC_NAME, ((uint64_t)functionId << 32) | runnerId);
+      }
+      messageCount = entries.size();
+    }
+
+    // The batched launch mode sends a single start command per host, directly from the coordinator
+    if (launchMode == launchMode_t::batchedLaunch) messageCount = dispatchLaunchPlan(entries, 0, entries.size(), std::max<size_t>(entries.size(), 1));
+
+    // The tree launch mode spreads the start commands down the launch tree
+    if (launchMode == launchMode_t::treeLaunch)
+    {
+      messageCount = dispatchLaunchPlan(entries, 0, entries.size(), _launchTreeFanout);
+      treeDepth    = LaunchPlan::computeTreeDepth(entries.size(), _launchTreeFanout);
+    }
+
+    // Recording the launch statistics
+    const double dispatchTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - dispatchStartTime).count();
+    _launchStatistics         = {launchMode, runnerCount, treeDepth, messageCount, dispatchTime, dispatchTime * (double)treeDepth};
+
+    return handle;
+  }
+
+  /**
+   * Deploys a deployment request through a hierarchy of coordinators, for jobs too large for a single coordinator to gather, match and launch. All participating instances
+   * must call it with the same partitions.
+   *
+   * The hosts are split into partitions (e.g., one per rack or node group), each with its own coordinator. The coordinator of each partition gathers the topologies of
+   * its hosts, and only sends a summary of them (see PartitionSummary) to the global coordinator. The global coordinator splits the runners among the partitions by their
+   * requested topologies, and sends each partition coordinator its share. Each partition coordinator then matches its share to its hosts (see doEquivalenceClassMatching),
+   * launches it as the coordinator of its partition and, once all of its runners are done, reports which of them failed. The global coordinator thus never holds the
+   * topology of every host, nor exchanges any message with the hosts themselves.
+   *
+   * The global coordinator does not take part in any partition. The partition coordinators launch their share with their own settings (e.g., setLaunchTreeFanout,
+   * setRunnerPinning and setLeases) and keep the launch statistics of their partition. The hosts left without runners return right away.
+   *
+   * @param[in] deployment The runners to deploy, each with its requested topology (see Deployment::addTopology). Their instance ids are ignored. Only needs to be given by the global coordinator
+   * @param[in] coordinatorInstanceId The id of the global coordinator
+   * @param[in] partitions The partitions of the hosts
+   * @param[in] launchMode The strategy for the partition coordinators to start their runners. Either the batched or the tree launch mode. Only needs to be decided by the global coordinator
+   *
+   * @return A handle to track the progress of the deployment, at the global coordinator. The rest of the instances return once their part is done, and get an empty handle
+   */
+  [[nodiscard]] __INLINE__ std::shared_ptr<DeploymentHandle> deployHierarchical(const Deployment                  &deployment,
+                                                                                const HiCR::Instance::instanceId_t coordinatorInstanceId,
+                                                                                const std::vector<partition_t>    &partitions,
+                                                                                const launchMode_t                 launchMode = launchMode_t::treeLaunch)
+  {
+    const auto currentInstanceId = _instanceManager->getCurrentInstance()->getId();
+
+    // Sanity check: every instance takes a single role. All participating instances check it, so that they all fail alike
+    const partition_t                               *currentPartition = nullptr;
+    std::unordered_set<HiCR::Instance::instanceId_t> participantIds   = {coordinatorInstanceId};
+    for (const auto &partition : partitions)
+    {
+      if (participantIds.insert(partition.coordinatorInstanceId).second == false)
+        HICR_THROW_LOGIC("[DeployR] Instance %lu takes more than one role in the hierarchical deployment.\n", partition.coordinatorInstanceId);
+
+      const std::unordered_set<HiCR::Instance::instanceId_t> hostIds(partition.instanceIds.begin(), partition.instanceIds.end());
+      if (hostIds.size() != partition.instanceIds.size())
+        HICR_THROW_LOGIC("[DeployR] A repeated host was provided in the partition of instance %lu.\n", partition.coordinatorInstanceId);
+      for (const auto instanceId : hostIds)
+        if (instanceId != partition.coordinatorInstanceId && participantIds.insert(instanceId).second == false)
+          HICR_THROW_LOGIC("[DeployR] Instance %lu takes more than one role in the hierarchical deployment.\n", instanceId);
+
+      if (partition.coordinatorInstanceId == currentInstanceId || hostIds.contains(currentInstanceId)) currentPartition = &partition;
+    }
+
+    // Bifurcation point: the partition coordinators deploy their share, while their hosts serve the requests of their coordinator until its start command (or release) arrives
+    if (currentPartition != nullptr && currentPartition->coordinatorInstanceId == currentInstanceId)
+    {
+      deployPartition(*currentPartition, coordinatorInstanceId);
+      return std::make_shared<DeploymentHandle>();
+    }
+    if (currentPartition != nullptr)
+    {
+      _isAwaitingPartitionStart = true;
+      while (_isAwaitingPartitionStart) listen();
+      return std::make_shared<DeploymentHandle>();
+    }
+    if (currentInstanceId != coordinatorInstanceId) return std::make_shared<DeploymentHandle>();
+
+    // Sanity checks on the request, by the global coordinator
+    const auto &runnerIds    = deployment.getRunnerIds();
+    const auto &topologyIdxs = deployment.getTopologyIdxs();
+    if (deployment.getRunnerCount() != std::unordered_set<Runner::runnerId_t>(runnerIds.begin(), runnerIds.end()).size())
+      HICR_THROW_LOGIC("[DeployR] A repeated runner id was provided.\n");
+    if (std::find(topologyIdxs.begin(), topologyIdxs.end(), Deployment::noTopology) != topologyIdxs.end())
+      HICR_THROW_LOGIC("[DeployR] Hierarchical deployments need every runner to declare its requested topology, for the partition coordinators to match it.\n");
+    if (launchMode == launchMode_t::serialLaunch)
+      HICR_THROW_LOGIC("[DeployR] Hierarchical deployments need the batched or tree launch modes, whose start commands also let the partition hosts return.\n");
+    if (_partitionRunnerIds.empty() == false)
+      HICR_THROW_LOGIC("[DeployR] A hierarchical deployment is still running. Wait for its handle before deploying hierarchically again.\n");
+
+    // Remembering the coordinator, as for any other deployment
+    _coordinatorInstanceId = coordinatorInstanceId;
+
+    // Finding the partition coordinators
+    std::vector<HiCR::Instance *> partitionCoordinators;
+    for (const auto &partition : partitions)
+    {
+      const auto instance = getInstance(partition.coordinatorInstanceId);
+      if (instance == nullptr) HICR_THROW_LOGIC("[DeployR] Provided instance id %lu not found in the instance manager provided.\n", partition.coordinatorInstanceId);
+      partitionCoordinators.push_back(instance);
+    }
+
+    // Requesting the summaries of all partitions up front, and then collecting them. The partitions gather the topologies of their hosts on their own, in parallel
+    std::vector<PartitionSummary> summaries;
+    {
+      auto       span        = _tracer.span("Gather Partition Summaries", "Phase");
+      const auto requestTime = Tracer::now();
+      for (const auto instance : partitionCoordinators) requestRPC(*instance, __DEPLOYR_GET_PARTITION_SUMMARY_RPC_NAME);
+      for (const auto instance : partitionCoordinators)
+      {
+        auto returnValue = getReturnValue(*instance);
+        _tracer.record("Partition Summary Request", "RPC", requestTime, Tracer::now(), returnValue->getSize(), instance->getId());
+        summaries.push_back(PartitionSummary(WireFormat::decode(returnValue->getPointer(), returnValue->getSize(), WireFormat::encoding_t::cbor)));
+        _rpcEngine->getMemoryManager()->freeLocalMemorySlot(returnValue);
+      }
+    }
+
+    // Splitting the runners among the partitions. If they do not have enough compatible hosts, every partition still gets an empty share, for its hosts to return
+    const auto runnerPartitions = partitionRunners(deployment, summaries);
+    const bool isFeasible       = runnerPartitions.size() == deployment.getRunnerCount();
+
+    // Building the share of each partition, with the requested topologies of its runners and their payloads
+    auto shares = PartitionShare::split(deployment, runnerPartitions, partitions.size(), launchMode);
+    for (size_t p = 0; p < partitions.size(); p++)
+      if (shares[p].getRunnerCount() > 0) _partitionRunnerIds[partitions[p].coordinatorInstanceId] = shares[p].getRunnerIds();
+
+    // Creating the handle before serving the shares, since the completion reports of the partitions may arrive in between
+    auto handle = std::make_shared<DeploymentHandle>(nullptr, [this]() { listen(); });
+    for (size_t i = 0; i < runnerPartitions.size(); i++) handle->setState(runnerIds[i], DeploymentHandle::runnerState_t::launched);
+    if (isFeasible) _activeDeployments.push_back(handle);
+
+    // Serving the share of each partition coordinator, as it requests it
+    {
+      auto dispatchSpan = _tracer.span("Dispatch", "Phase");
+      for (size_t p = 0; p < partitions.size(); p++) _pendingPartitionShares.insert_or_assign(partitions[p].coordinatorInstanceId, std::move(shares[p]));
+      while (_pendingPartitionShares.empty() == false) listen();
+    }
+
+    if (isFeasible == false)
+      HICR_THROW_RUNTIME("[DeployR] The partitions do not have enough compatible hosts for the %lu runners requested. Their hosts were released.\n", deployment.getRunnerCount());
+
+    return handle;
+  }
+
+  /**
+   * Keeps this instance serving requests from a coordinator, until the coordinator shuts it down with shutdownWorkers.
+   * 
+   * While serving, an instance answers topology gathers (in the serial and pipelined modes) and runs the runners of any number of deployments, without
+   * calling gatherGlobalTopology or deploy itself. This allows a coordinator to run many jobs on the same instances. Runners that fail are reported
+   * to the coordinator and do not stop the service. Tree gathers still need every participating instance to call gatherGlobalTopology.
+   * 
+   * @param[in] coordinatorInstanceId The id of the instance whose requests to serve
+   */
+  __INLINE__ void serve(const HiCR::Instance::instanceId_t coordinatorInstanceId)
+  {
+    if (_instanceManager->getCurrentInstance()->getId() == coordinatorInstanceId) HICR_THROW_LOGIC("[DeployR] The coordinator instance cannot serve requests from itself.\n");
+
+    // Remembering the coordinator, for the runners to report their completion to it
+    _coordinatorInstanceId = coordinatorInstanceId;
+
+    // Serving requests until told to shut down
+    _isServing = true;
+    while (_isServing) listen();
+
+    // Waiting for the runners still running on the dedicated execution resources, if any, which send their last reports, and freeing their payloads
+    if (_runnerExecutionPool != nullptr) _runnerExecutionPool->wait();
+    _offloadedRunnerHeartbeat.reset();
+    freeReleasedPayloads();
+  }
+
+  /**
+   * Dedicates a number of compute resources of the local topology to running the initial functions of runners while serving (see serve).
+   * 
+   * Each of them runs a HiCR processing unit that picks up runners as they are started, so that the listening thread stays free for control-plane requests
+   * (topology queries, further launches, completion reports, shutdown) and several runners can run at the same time.
+   * The last compute resources of the local topology are used, leaving the first ones (where the RPC engine usually runs) untouched.
+   * 
+   * The processing units report the completion of their runners to the coordinator themselves. Their requests are serialized with those of the listening thread,
+   * but may be sent while it listens: with the HiCR RPC engine, this needs a thread-safe communication backend (e.g., MPI initialized with MPI_THREAD_MULTIPLE).
+   * The initial functions of runners run this way must not use the RPC engine themselves, since their requests would not be serialized.
+   * 
+   * @param[in] computeResourceCount The number of compute resources to dedicate. Zero runs the runners on the listening thread, as when not serving
+   */
+  __INLINE__ void setRunnerExecutionResourceCount(const size_t computeResourceCount)
+  {
+    if (_isServing) HICR_THROW_LOGIC("[DeployR] The runner execution resources cannot be changed while serving.\n");
+
+    // Waiting for the previous resources to finish
+    _runnerExecutionPool.reset();
+    if (computeResourceCount == 0) return;
+
+    // Taking the last compute resources of the local topology
+    std::vector<std::shared_ptr<HiCR::ComputeResource>> computeResources;
+    for (const auto &device : _localTopology.getDevices())
+      for (const auto &computeResource : device->getComputeResourceList()) computeResources.push_back(computeResource);
+    if (computeResourceCount > computeResources.size())
+      HICR_THROW_LOGIC("[DeployR] Requested %lu compute resources to run runners, but the local topology only has %lu.\n", computeResourceCount, computeResources.size());
+    computeResources.erase(computeResources.begin(), computeResources.end() - computeResourceCount);
+
+    _runnerExecutionPool = std::make_unique<WorkerPool>(_runnerExecutionComputeManager, computeResources);
+  }
+
+  /**
+   * Makes a set of serving instances return from serve. Only to be called by their coordinator, after all of their deployments are finalized
+   * 
+   * @param[in] instanceIds The ids of the serving instances. The current instance is skipped, if present
+   */
+  __INLINE__ void shutdownWorkers(const std::vector<HiCR::Instance::instanceId_t> &instanceIds)
+  {
+    const auto currentInstanceId = _instanceManager->getCurrentInstance()->getId();
+    for (const auto instanceId : instanceIds)
+    {
+      if (instanceId == currentInstanceId) continue;
+      const auto instance = getInstance(instanceId);
+      if (instance == nullptr) HICR_THROW_LOGIC("[DeployR] Provided instance id %lu not found in the instance manager provided.\n", instanceId);
+      requestRPC(*instance, __DEPLOYR_SHUTDOWN_RPC_NAME);
+    }
+  }
+
+  /**
+   * Indicates whether this instance is currently serving requests (see serve)
+   * 
+   * @return true, if serving; false, otherwise
+   */
+  [[nodiscard]] __INLINE__ bool isServing() const { return _isServing; }
+
+  /**
+   * Creates one new instance per requested topology (e.g., through CloudR), with up to maxConcurrency creations in flight at a time.
+   * 
+   * Either all instances are created, or none: if any creation fails, the instances already created by this call are terminated and an exception is thrown.
+   * The instance manager must allow concurrent instance creation and termination; otherwise, a concurrency of 1 creates them one after the other.
+   * 
+   * @param[in] requestedTopologies The topology of each instance to create, usually those requested by the runners of a deployment
+   * @param[in] maxConcurrency The maximum number of instances being created at the same time
+   * 
+   * @return The new instances, in the same order as the requested topologies
+   */
+  [[nodiscard]] __INLINE__ std::vector<std::shared_ptr<HiCR::Instance>> provisionInstances(const std::vector<HiCR::Topology> &requestedTopologies,
+                                                                                          const size_t maxConcurrency = __DEPLOYR_DEFAULT_PROVISIONING_CONCURRENCY)
+  {
+    if (maxConcurrency == 0) HICR_THROW_LOGIC("[DeployR] The provisioning concurrency must be at least 1.\n");
+    if (requestedTopologies.empty()) return {};
+
+    // Creating the instance templates up front, since they are cheap
+    std::vector<std::shared_ptr<HiCR::InstanceTemplate>> instanceTemplates;
+    for (const auto &topology : requestedTopologies) instanceTemplates.push_back(_instanceManager->createInstanceTemplate(topology));
+
+    // Creating the instances on a pool of workers. After the first failure, the remaining creations are skipped
+    std::vector<std::shared_ptr<HiCR::Instance>> newInstances(requestedTopologies.size());
+    std::vector<std::string>                     failureReasons(requestedTopologies.size());
+    std::atomic<bool>                            hasFailed = false;
+    {
+      WorkerPool pool(std::min(maxConcurrency, requestedTopologies.size()));
+      for (size_t i = 0; i < requestedTopologies.size(); i++)
+        pool.submit([&, i]() {
+          if (hasFailed) return;
+          try
+          {
+            newInstances[i] = createInstance(*instanceTemplates[i]);
+          }
+          catch (const std::exception &e)
+          {
+            failureReasons[i] = e.what();
+            hasFailed         = true;
+          }
+        });
+      pool.wait();
+    }
+
+    if (hasFailed == false) return newInstances;
+
+    // Rolling back: terminating the instances that were created
+    std::vector<std::shared_ptr<HiCR::Instance>> createdInstances;
+    for (const auto &instance : newInstances)
+      if (instance != nullptr) createdInstances.push_back(instance);
+
+    std::string rollbackFailure;
+    try
+    {
+      terminateInstances(createdInstances, maxConcurrency);
+    }
+    catch (const std::exception &e)
+    {
+      rollbackFailure = e.what();
+    }
+
+    // Reporting the first failure found
+    const auto failedIdx = std::find_if(failureReasons.begin(), failureReasons.end(), [](const auto &reason) { return reason.empty() == false; }) - failureReasons.begin();
+    HICR_THROW_RUNTIME("[DeployR] Failed to provision instance %lu of %lu; the %lu instances created were rolled back. Reason: \n  + '%s'%s%s",
+                       (size_t)failedIdx,
+                       requestedTopologies.size(),
+                       createdInstances.size(),
+                       failureReasons[failedIdx].c_str(),
+                       rollbackFailure.empty() ? "" : "\nAdditionally, the rollback failed: ",
+                       rollbackFailure.c_str());
+  }
+
+  /**
+   * Terminates a set of instances (e.g., those created by provisionInstances), with up to maxConcurrency terminations in flight at a time.
+   * 
+   * All instances are attempted, even if some of the terminations fail. In that case, an exception is thrown at the end.
+   * 
+   * @param[in] instances The instances to terminate
+   * @param[in] maxConcurrency The maximum number of instances being terminated at the same time
+   */
+  __INLINE__ void terminateInstances(const std::vector<std::shared_ptr<HiCR::Instance>> &instances, const size_t maxConcurrency = __DEPLOYR_DEFAULT_PROVISIONING_CONCURRENCY)
+  {
+    if (maxConcurrency == 0) HICR_THROW_LOGIC("[DeployR] The provisioning concurrency must be at least 1.\n");
+    if (instances.empty()) return;
+
+    // Terminating the instances on a pool of workers, remembering the failures
+    std::vector<std::string> failureReasons(instances.size());
+    {
+      WorkerPool pool(std::min(maxConcurrency, instances.size()));
+      for (size_t i = 0; i < instances.size(); i++)
+        pool.submit([&, i]() {
+          try
+          {
+            _instanceManager->terminateInstance(instances[i]);
+            unindexInstance(instances[i]->getId());
+          }
+          catch (const std::exception &e)
+          {
+            failureReasons[i] = e.what();
+          }
+        });
+      pool.wait();
+    }
+
+    // Reporting the failures, if any
+    const auto failedCount = std::count_if(failureReasons.begin(), failureReasons.end(), [](const auto &reason) { return reason.empty() == false; });
+    if (failedCount == 0) return;
+    const auto failedIdx = std::find_if(failureReasons.begin(), failureReasons.end(), [](const auto &reason) { return reason.empty() == false; }) - failureReasons.begin();
+    HICR_THROW_RUNTIME("[DeployR] Failed to terminate %lu of %lu instances. First reason (instance %lu): \n  + '%s'",
+                       (size_t)failedCount,
+                       instances.size(),
+                       instances[failedIdx]->getId(),
+                       failureReasons[failedIdx].c_str());
+  }
+
+  /**
+   * Sets the maximum number of children per instance in the launch tree used by the tree launch mode
+   * 
+   * @param[in] fanout The maximum number of children per instance. Must be at least 1
+   */
+  __INLINE__ void setLaunchTreeFanout(const size_t fanout)
+  {
+    if (fanout == 0) HICR_THROW_LOGIC("[DeployR] The launch tree fanout must be at least 1.\n");
+    _launchTreeFanout = fanout;
+  }
+
+  /**
+   * Enables or disables pinning the runners of the deployments launched by this instance, as coordinator, to the resources of their hosts.
+   * 
+   * For each runner with a requested topology (see Deployment::addTopology), its host finds the concrete compute resources and memory spaces that satisfy it, following the
+   * same rules as the matching (see ResourcePinner). The runner's initial function then runs on a thread bound to the matched processors, so that the memory it touches first is
+   * allocated on their NUMA domain, and can get its resources with getRunnerPlacement. If there are not enough compute resources for all of its runners, a host
+   * shares them round-robin. Runners without a requested topology, or run on the dedicated execution resources while
+   * serving (see setRunnerExecutionResourceCount), are not pinned. Remote runners can only be pinned in the batched and tree launch modes.
+   * 
+   * @param[in] isEnabled Whether to pin the runners
+   */
+  __INLINE__ void setRunnerPinning(const bool isEnabled) { _isRunnerPinningEnabled = isEnabled; }
+
+  /**
+   * Sets the largest runner payload that is sent inline in the launch plan. Larger payloads are requested by their hosts from the coordinator (see deploy)
+   * 
+   * @param[in] maxSize The largest inline payload size, in bytes
+   */
+  __INLINE__ void setPayloadInlineMaxSize(const size_t maxSize) { _payloadInlineMaxSize = maxSize; }
+
+  /**
+   * Gets the payload delivered to the calling runner at launch (see Deployment::setPayload)
+   * 
+   * @return A view of the payload, valid until the runner's initial function returns. It is empty if the runner has no payload
+   */
+  [[nodiscard]] __INLINE__ std::span<const uint8_t> getRunnerPayload() const
+  {
+    // Runners sharing this instance run on their own threads, which remember their own payload
+    const auto &payload = getThreadRunnerId().has_value() ? getThreadRunnerPayload() : _runnerPayload;
+    return std::span<const uint8_t>(payload.data.get(), payload.size);
+  }
+
+  /**
+   * Gets the resources of this host the calling runner is pinned to, e.g., to allocate its buffers on the matched memory spaces
+   * 
+   * @return The placement of the runner. It is empty if the runner is not pinned (see setRunnerPinning)
+   */
+  [[nodiscard]] __INLINE__ static const ResourcePinner::placement_t &getRunnerPlacement() { return getThreadRunnerPlacement(); }
+
+  /**
+   * Makes the coordinator detect the failure of the hosts of its remote runners, and respawn those runners on spare hosts (see addSpareHosts).
+   * 
+   * While running runners, each host sends a heartbeat to the coordinator at every interval, renewing its lease. While it holds leases, a thread of the coordinator
+   * requests a check of the leases from the coordinator itself at every interval, which is served while listening (e.g., while waiting for a deployment) after the
+   * heartbeats received before it. A host that did not renew its
+   * lease for longer than its duration is considered failed: its runners that did not complete are matched anew to the spare hosts whose topology satisfies theirs,
+   * and started there with the same function and payload. Runners that no spare host can take are marked as failed, so that waiting for their deployment does not hang.
+   * A runner whose host was only late may still complete there, in which case its first report counts. In the tree launch mode, the hosts below a failed host that
+   * did not get their start command are considered failed as well.
+   * 
+   * Leases need the batched or tree launch modes. The hosts running their runners on the listening thread send the heartbeats from it. Otherwise, as for the lease
+   * checks, they are sent by a thread of DeployR while the listening thread listens: with the HiCR RPC engine, this needs a thread-safe communication backend
+   * (e.g., MPI initialized with MPI_THREAD_MULTIPLE), as for the dedicated execution resources (see setRunnerExecutionResourceCount).
+   * 
+   * @param[in] heartbeatInterval The time between heartbeats. Zero disables leases
+   * @param[in] leaseDuration The time without heartbeats after which a host is considered failed. It should cover several heartbeat intervals, as well as the launch of the runners
+   */
+  __INLINE__ void setLeases(const std::chrono::nanoseconds heartbeatInterval, const std::chrono::nanoseconds leaseDuration)
+  {
+    if (heartbeatInterval.count() > 0 && leaseDuration <= heartbeatInterval) HICR_THROW_LOGIC("[DeployR] The lease duration must be longer than the heartbeat interval.\n");
+    _heartbeatInterval = heartbeatInterval;
+    _leaseDuration     = leaseDuration;
+  }
+
+  /**
+   * Adds hosts for the coordinator to respawn the runners of failed hosts on (see setLeases). Each spare host takes a single runner, after which it is no longer spare.
+   * 
+   * Spare hosts (e.g., instances drawn from an InstancePool) must be serving this instance as coordinator (see serve), so that runners can be started on them at any time.
+   * 
+   * @param[in] instanceIds The ids of the spare hosts
+   * @param[in] topologies The topology of each spare host, e.g., as gathered by gatherGlobalTopology
+   */
+  __INLINE__ void addSpareHosts(const std::vector<HiCR::Instance::instanceId_t> &instanceIds, const std::vector<HiCR::Topology> &topologies)
+  {
+    _leaseRegistry.addSpareHosts(instanceIds, topologies);
+  }
+
+  /**
+   * Gets the number of spare hosts not taken by a respawned runner yet
+   * 
+   * @return The number of spare hosts
+   */
+  [[nodiscard]] __INLINE__ size_t getSpareHostCount() const { return _leaseRegistry.getSpareHostCount(); }
+
+  /**
+   * Gets the hosts this instance, as coordinator, considered failed because their lease expired
+   * 
+   * @return The ids of the failed hosts
+   */
+  [[nodiscard]] __INLINE__ const std::unordered_set<HiCR::Instance::instanceId_t> &getFailedInstanceIds() const { return _leaseRegistry.getFailedInstanceIds(); }
+
+  /**
+   * Gets the statistics of the last deployment launched by this instance as coordinator
+   * 
+   * @return The launch statistics
+   */
+  [[nodiscard]] __INLINE__ const launchStatistics_t &getLaunchStatistics() const { return _launchStatistics; }
+
+  /**
+   * Gets the tracer recording the events of this instance: topology gather phases and requests, launch dispatch, launch plan exchanges and runner executions.
+   * Recording is disabled until enabled with Tracer::setEnabled. User code may add its own spans (e.g., around the matching).
+   * 
+   * @return The tracer
+   */
+  [[nodiscard]] __INLINE__ Tracer &getTracer() { return _tracer; }
+
+  /**
+   * Collects the events recorded by the participating instances into the tracer of the root instance, so that they can be exported from there.
+   * 
+   * The root requests the events of each instance in turn. The remote timestamps are shifted onto the root's clock by assuming that each instance took its
+   * timestamp halfway through the request's round trip, which is recorded as well. The events are moved: the remote instances forget them.
+   * All participating instances must call this function with the same instance ids, unless they are serving (see serve).
+   * 
+   * @param[in] rootInstanceId The id of the instance that receives the events
+   * @param[in] instanceIds The ids of the participating instances
+   */
+  __INLINE__ void gatherTraces(const HiCR::Instance::instanceId_t rootInstanceId, const std::vector<HiCR::Instance::instanceId_t> &instanceIds)
+  {
+    const auto currentInstanceId = _instanceManager->getCurrentInstance()->getId();
+
+    // If I am not root, the root will request my events only if I am participating
+    if (currentInstanceId != rootInstanceId)
+    {
+      if (std::find(instanceIds.begin(), instanceIds.end(), currentInstanceId) != instanceIds.end()) listen();
+      return;
+    }
+
+    for (const auto instanceId : instanceIds)
+    {
+      if (instanceId == currentInstanceId) continue;
+      const auto instance = getInstance(instanceId);
+      if (instance == nullptr) HICR_THROW_LOGIC("[DeployR] Provided instance id %lu not found in the instance manager provided.\n", instanceId);
+
+      // Requesting the remote events, timing the round trip
+      const auto requestTime = Tracer::now();
+      requestRPC(*instance, __DEPLOYR_GET_TRACE_RPC_NAME);
+      auto       returnValue = getReturnValue(*instance);
+      const auto replyTime   = Tracer::now();
+      const auto trace       = WireFormat::decode(returnValue->getPointer(), returnValue->getSize(), WireFormat::encoding_t::json);
+      _tracer.record("Trace Request", "RPC", requestTime, replyTime, returnValue->getSize(), instanceId);
+      _rpcEngine->getMemoryManager()->freeLocalMemorySlot(returnValue);
+
+      // Merging them onto the local clock
+      const auto clockOffset = trace["Clock"].get<Tracer::timestamp_t>() - (requestTime + (replyTime - requestTime) / 2);
+      _tracer.merge(trace, clockOffset);
+    }
+  }
+
+  /**
+   * Registers a function that can be a target as initial function for one or more requested instances.
+   * 
+   * If a requested initial function is not registered by this function, deployment will fail.
+   * 
+   * @param[in] functionName The name of the function to register. This value will be used to match against the requested instance functions
+   * @param[in] fc The actual function to register
+   * 
+   */
+  __INLINE__ void registerFunction(const std::string &functionName, std::function<void()> fc)
+  {
+    // Checking if the function name, or its id, was already used
+    const auto functionId = getFunctionId(functionName);
+    const auto entry      = _registeredFunctions.find(functionId);
+    if (entry != _registeredFunctions.end() && entry->second.name == functionName) HICR_THROW_LOGIC("The function '%s' was already registered.", functionName.c_str());
+    if (entry != _registeredFunctions.end())
+      HICR_THROW_LOGIC("[DeployR] The function names '%s' and '%s' map to the same function id (%u). Please rename one of them.\n", functionName.c_str(), entry->second.name.c_str(), functionId);
+
+    // Adding new function to the set
+    _registeredFunctions.insert({functionId, {functionName, fc}});
+
+    // Adding function to RPC Engine, for runners whose id does not fit in the start runner RPC argument. The runner id comes as the RPC argument
+    registerRPC(functionName, [this, functionId]() { startRunner(functionId, _rpcEngine->getRPCArgument()); });
+  }
+
+  /**
+   * Gets the numeric id a function name is interned into. It only depends on the name, so that all instances agree on it without exchanging their registrations
+   * 
+   * @param[in] functionName The name of the function
+   * 
+   * @return The id of the function, as a 32-bit FNV-1a hash of its name
+   */
+  [[nodiscard]] __INLINE__ static functionId_t getFunctionId(const std::string &functionName)
+  {
+    uint32_t hash = 2166136261u;
+    for (const auto c : functionName)
+    {
+      hash ^= (uint8_t)c;
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+  /**
+   * Retrieves the id of the running instance
+   * 
+   * @return The id of the running instance
+   */
+  [[nodiscard]] __INLINE__ Runner::runnerId_t getRunnerId() const
+  {
+    // Runners sharing this instance run on their own threads, which remember their own runner id
+    if (getThreadRunnerId().has_value()) return getThreadRunnerId().value();
+
+    // Otherwise, the runner id is remembered when the runner is started, whether by the coordinator itself, an RPC, or the launch plan
+    return _runnerId;
+  }
+
+  /**
+   * Finalizes the deployment. Must be called by the root instance before exiting the applicataion
+   *
+   * The completion reports of the remote runners only advance while the coordinator listens to the RPC engine. Calling finalize is therefore required before
+   * destroying this object: the destructor does not wait for the outstanding deployments, and reports still in flight are lost.
+   *
+   * When leasing (see setLeases), the hosts stop sending heartbeats before reporting the completion of their last runner, so none of them is left in flight afterwards.
+   * The last lease check the coordinator requested from itself, if any, is served before returning.
+   */
+  __INLINE__ void finalize()
+  {
+    // Waiting for all runners launched by this instance as coordinator to report their completion
+    for (const auto &handle : _activeDeployments) handle->wait();
+    _activeDeployments.clear();
+
+    // Stopping the lease checks, if not stopped yet, and serving the last one requested
+    _leaseMonitor.reset();
+    while (_isLeaseCheckPending) listen();
+  }
+
+  /**
+   * Fatally aborts execution. Must be used only in case of unsalvageable errors.
+   */
+  __INLINE__ void abort() { _instanceManager->abort(-1); }
+
+  /**
+   * Retrieves the RPC engine for direct use
+   * 
+   * @return A pointer to the internal RPC engine
+   */
+  __INLINE__ rpcEngine_t *getRPCEngine() { return _rpcEngine; }
+
+  /**
+   * Retrieves currently running instance
+   * 
+   * @return The current HiCR instance
+   */
+  __INLINE__ HiCR::Instance &getCurrentHiCRInstance() const { return *_instanceManager->getCurrentInstance(); }
+
+  /**
+   * Sets the fanout (maximum number of children per instance) of the tree used by the tree topology gather mode
+   * 
+   * @param[in] fanout The fanout to use. Must be at least 1
+   */
+  __INLINE__ void setTopologyGatherTreeFanout(const size_t fanout)
+  {
+    if (fanout == 0) HICR_THROW_LOGIC("[DeployR] The topology gather tree fanout must be at least 1.\n");
+    _topologyGatherTreeFanout = fanout;
+  }
+
+  /**
+   * Sets the encoding used by the remote instances to send their topology to the root during topology gathering
+   * 
+   * The encoding is negotiated with each remote instance at request time, so only the root needs to set it.
+   * 
+   * @param[in] encoding The encoding to use. Binary encodings (e.g., CBOR) produce considerably smaller messages than plain JSON
+   */
+  __INLINE__ void setTopologyWireFormat(const WireFormat::encoding_t encoding) { _topologyWireFormat = encoding; }
+
+  /**
+   * Enables or disables the topology cache used by the root in the serial and pipelined topology gather modes
+   * 
+   * When enabled, the root remembers the topology of each instance together with its fingerprint. Subsequent gathers only exchange fingerprints,
+   * and the full topology is sent only by those instances whose fingerprint changed. The tree gather mode always sends full topologies.
+   * 
+   * @param[in] enabled Whether to use the topology cache
+   */
+  __INLINE__ void setTopologyCacheEnabled(const bool enabled) { _isTopologyCacheEnabled = enabled; }
+
+  /**
+   * Forgets all cached topologies, forcing the next gather to fetch them in full
+   */
+  __INLINE__ void clearTopologyCache() { _topologyCache.clear(); }
+
+  /**
+   * Sets the location of this instance in the system hierarchy, which is sent to the root along with the local topology.
+   * 
+   * The locality is a path of levels separated by '/', from the outermost to the innermost (e.g., "rack0/switch1/node3/numa0").
+   * The more leading levels two instances share, the closer they are. It is typically obtained from the scheduler or the host name.
+   * 
+   * @param[in] locality The locality of this instance
+   */
+  __INLINE__ void setLocalLocality(const std::string &locality)
+  {
+    _localLocality            = locality;
+    _localTopologyFingerprint = TopologyCache::fingerprint(serializeLocalTopology());
+  }
+
+  /**
+   * Gets the locality of an instance, as received during the last topology gather
+   * 
+   * @param[in] instanceId The id of the instance
+   * 
+   * @return The locality of the instance, or an empty string if unknown
+   */
+  [[nodiscard]] __INLINE__ std::string getHostLocality(const HiCR::Instance::instanceId_t instanceId) const
+  {
+    if (instanceId == _instanceManager->getCurrentInstance()->getId()) return _localLocality;
+    const auto entry = _hostLocalities.find(instanceId);
+    return entry == _hostLocalities.end() ? std::string() : entry->second;
+  }
+
+  /**
+   * Sets the number of worker threads the root uses to deserialize topologies in the pipelined topology gather mode
+   * 
+   * @param[in] threadCount The number of worker threads. Zero means using the hardware concurrency of the system
+   */
+  __INLINE__ void setTopologyGatherThreadCount(const size_t threadCount) { _topologyGatherThreadCount = threadCount; }
+
+  /**
+ * Gets the global topology, the sum of all local topologies among the provided instances
+ * 
+ * In serial mode, the root requests the topology of every instance in the instance manager, one after the other.
+ * In pipelined mode, the root sends all requests before waiting for any reply, and parses the replies on a worker pool while waiting for the rest.
+ * The replies are still collected in request order, since the RPC engine can only wait for the reply of a given instance: a slow instance delays the parsing of every later reply.
+ * In tree mode, the provided instances are arranged in a k-ary tree rooted at the root instance, and the critical path becomes O(log N) round trips.
+ * All participating instances must call this function with the same instance ids.
+ * 
+ * @param[in] rootInstanceId The id of the instance that receives the global topology
+ * @param[in] instanceIds The ids of the participating instances
+ * @param[in] mode The strategy to use for gathering the topologies
+ * 
+ * @return A vector containing each of the local topologies, where the index corresponds to the host index in the getHiCRInstances function (serial and pipelined modes) or in the provided instance ids (tree mode)
+ */
+  [[nodiscard]] __INLINE__ std::vector<HiCR::Topology> gatherGlobalTopology(const HiCR::Instance::instanceId_t              rootInstanceId,
+                                                                            const std::vector<HiCR::Instance::instanceId_t> instanceIds,
+                                                                            const topologyGatherMode_t                      mode = topologyGatherMode_t::serial)
+  {
+    auto span = _tracer.span("Gather Topology", "Phase");
+
+    if (mode == topologyGatherMode_t::tree) return gatherGlobalTopologyTree(rootInstanceId, instanceIds);
+    if (mode == topologyGatherMode_t::pipelined) return gatherGlobalTopologyPipelined(rootInstanceId);
+
+    // Storage
+    std::vector<HiCR::Topology> globalTopology;
+    const auto                 &currentInstance = _instanceManager->getCurrentInstance();
+    const bool                  isRootInstance  = currentInstance->getId() == rootInstanceId;
+    const auto                 &instances       = _instanceManager->getInstances();
+
+    // If I am not root and I am among the participating instances, then listen for the incoming RPC and return an empty topology
+    if (isRootInstance == false) { listen(); }
+    else // If I am root, request topology from all instances
+    {
+      for (const auto &instance : instances)
+        if (instance->getId() == currentInstance->getId()) // If its me, just push my local topology
+        {
+          globalTopology.push_back(_localTopology);
+        }
+        else // If not, it's another instance: send RPC and deserialize return value
+        {
+          // Requesting RPC from the remote instance
+          auto requestSpan = _tracer.span("Topology Request", "RPC", instance->getId());
+          requestTopology(*instance);
+
+          // Getting return value as a memory slot
+          auto returnValue = getReturnValue(*instance);
+          requestSpan.setBytes(returnValue->getSize());
+
+          // Decoding the reply straight from the return value
+          auto reply = parseTopologyReply(*returnValue);
+
+          // Freeing return value
+          _rpcEngine->getMemoryManager()->freeLocalMemorySlot(returnValue);
+
+          // Pushing topology into the vector
+          globalTopology.push_back(resolveTopologyReply(instance->getId(), std::move(reply)));
+        }
+    }
+
+    // Return global topology
+    return globalTopology;
+  }
+
+  /**
+   * Creates the plan of a deployment, to persist it (see DeploymentPlan::save) and restart the same job on the same instances without gathering and matching again (see validateDeploymentPlan).
+   * Only to be called by the root that gathered the topologies of the participating instances.
+   * 
+   * The plan keeps the topology fingerprints computed by the instances themselves, which the root only knows for the instances it gathered with the topology cache enabled
+   * (see setTopologyCacheEnabled), in the serial or pipelined gather modes.
+   * 
+   * @param[in] deployment The deployment, with the runners already paired to the participating instances
+   * @param[in] instanceIds The ids of the participating instances
+   * @param[in] requestFingerprint The fingerprint of the request the deployment was computed from (e.g., see DeploymentPlan::fingerprintFile), if it is to be checked when validating
+   * 
+   * @return The plan
+   */
+  [[nodiscard]] __INLINE__ DeploymentPlan createDeploymentPlan(const Deployment                                &deployment,
+                                                                const std::vector<HiCR::Instance::instanceId_t> &instanceIds,
+                                                                const uint64_t                                   requestFingerprint = DeploymentPlan::noRequestFingerprint) const
+  {
+    const auto currentInstanceId = _instanceManager->getCurrentInstance()->getId();
+
+    std::map<HiCR::Instance::instanceId_t, TopologyCache::fingerprint_t> fingerprints;
+    for (const auto instanceId : instanceIds)
+    {
+      const auto fingerprint = instanceId == currentInstanceId ? _localTopologyFingerprint : _topologyCache.getFingerprint(instanceId);
+      if (fingerprint == TopologyCache::noFingerprint)
+        HICR_THROW_LOGIC("[DeployR] The topology fingerprint of instance %lu is not known. Deployment plans need the topology cache enabled while gathering topologies.\n", instanceId);
+      fingerprints[instanceId] = fingerprint;
+    }
+
+    return DeploymentPlan(deployment, std::move(fingerprints), requestFingerprint);
+  }
+
+  /**
+   * Checks whether a persisted deployment plan is still valid for the participating instances, by exchanging only their topology fingerprints. All participating instances must call it.
+   * 
+   * The plan is valid if it was computed from the same request, for the same participating instances, and none of their topologies (nor localities) changed since.
+   * The coordinator can then deploy the deployment of the plan directly. Otherwise, the topologies need to be gathered and matched again, as without a plan.
+   * The root sends its verdict to every participating instance, so that they all take the same path.
+   * 
+   * @param[in] rootInstanceId The id of the instance that validates the plan
+   * @param[in] instanceIds The ids of the participating instances
+   * @param[in] plan The plan to validate. Only needs to be given by the root. An empty plan (e.g., if none was stored yet) is never valid
+   * @param[in] requestFingerprint The fingerprint of the current request. Only needs to be given by the root
+   * 
+   * @return true, if the plan is valid; false, otherwise. All participating instances get the same verdict
+   */
+  [[nodiscard]] __INLINE__ bool validateDeploymentPlan(const HiCR::Instance::instanceId_t               rootInstanceId,
+                                                       const std::vector<HiCR::Instance::instanceId_t> &instanceIds,
+                                                       const DeploymentPlan                            &plan               = DeploymentPlan(),
+                                                       const uint64_t                                   requestFingerprint = DeploymentPlan::noRequestFingerprint)
+  {
+    const auto currentInstanceId = _instanceManager->getCurrentInstance()->getId();
+
+    // If I am not root, serving the fingerprint request, if any, until the verdict arrives
+    if (currentInstanceId != rootInstanceId)
+    {
+      _deploymentPlanVerdict.reset();
+      while (_deploymentPlanVerdict.has_value() == false) listen();
+      return _deploymentPlanVerdict.value();
+    }
+
+    auto       span    = _tracer.span("Validate Deployment Plan", "Phase");
+    const bool isValid = checkDeploymentPlan(instanceIds, plan, requestFingerprint);
+
+    // Sending the verdict to the rest of the participating instances
+    for (const auto instanceId : instanceIds)
+    {
+      if (instanceId == currentInstanceId) continue;
+      const auto instance = getInstance(instanceId);
+      if (instance == nullptr) HICR_THROW_LOGIC("[DeployR] Provided instance id %lu not found in the instance manager provided.\n", instanceId);
+      requestRPC(*instance, __DEPLOYR_DEPLOYMENT_PLAN_VERDICT_RPC_NAME, isValid ? 1 : 0);
+    }
+
+    return isValid;
+  }
+
+  /**
+ * Performs a matching between the a set of required topologies and a set of given (existing) topologies and returns, if exists, a possible pairing.
+ * 
+ * A pairing consists of a 1:1 mapping of the required topologies and the given topologies. For each pairing the given topology is a equal or a superset of the required one.
+ * 
+ * This implementation uses the Hopcroft-Karp algorithm to find a matching of all requested runners to a host.
+ * To keep a matching up to date as hosts join or leave, without recomputing it, use IncrementalMatcher instead.
+ * 
+ * @param[in] requested The topologies requested by the runners
+ * @param[in] given The topologies of the available hosts
+ * @param[in] threadCount The number of threads used to build the compatibility graph. Zero means using the hardware concurrency of the system
+ * 
+ * @return If successful, a vector of size size(requested) containing the indexes of the given topologies that match the requested ones. Otherwise, an empty vector.
+ */
+  [[nodiscard]] __INLINE__ static std::vector<size_t> doBipartiteMatching(const std::vector<HiCR::Topology> &requested,
+                                                                          const std::vector<HiCR::Topology> &given,
+                                                                          const size_t                       threadCount = 0)
+  {
+    // Creating pairings vector
+    std::vector<size_t> pairingsVector;
+
+    // Creating one deployment runner per requested runner
+    for (size_t i = 0; i < requested.size(); i++) pairingsVector.push_back(i);
+
+    // Finding out which hosts are compatible with each runner
+    const auto compatibility = buildCompatibilityGraph(requested, given, threadCount);
+
+    // Building the matching graph
+    BipartiteMatcher matcher;
+    matcher.loadGraph(compatibility, given.size());
+
+    //  Finding out if a proper matching exists
+    auto matchCount = matcher.computeMaximumMatching();
+
+    // If the number of matchings is smaller than requested, return an empty vector
+    if (matchCount < pairingsVector.size()) return {};
+
+    // Getting the pairings from the graph
+    const auto &graphPairings = matcher.getLeftPairings();
+    for (size_t i = 0; i < pairingsVector.size(); i++)
+    {
+      const auto givenIdx = (size_t)graphPairings[i];
+      pairingsVector[i]   = givenIdx;
+    }
+
+    return pairingsVector;
+  }
+
+  /**
+   * Performs the same matching as doBipartiteMatching, but on equivalence classes of identical topologies rather than on individual runners and hosts.
+   * 
+   * Identical requested (and given) topologies are grouped into classes, and the compatibility check runs once per pair of classes.
+   * The assignment is then found as a maximum flow through a small network (source -> runner classes -> host classes -> sink) whose capacities are the class sizes,
+   * and finally expanded back into a per-runner pairing. For deployments with few distinct runner shapes and host types, this is nearly independent of the number of runners and hosts.
+   * 
+   * @param[in] requested The topologies requested by the runners
+   * @param[in] given The topologies of the available hosts
+   * 
+   * @return If successful, a vector of size size(requested) containing the indexes of the given topologies that match the requested ones. Otherwise, an empty vector.
+   */
+  [[nodiscard]] __INLINE__ static std::vector<size_t> doEquivalenceClassMatching(const std::vector<HiCR::Topology> &requested, const std::vector<HiCR::Topology> &given)
+  {
+    return solveClassTransportation(requested, given, false);
+  }
+
+  /**
+   * Performs a matching between a set of required topologies and a set of given topologies that, among all possible pairings, wastes the least resources.
+   * 
+   * The cost of assigning a runner to a host is the excess of the host's resources (devices, compute resources and largest memory spaces) over the runner's request.
+   * Each kind of resource is normalized by the largest amount found among the hosts, so that e.g. bytes of RAM do not dominate over cores.
+   * This packs runners onto the smallest sufficient hosts, keeping larger hosts free for later deployments.
+   * 
+   * The assignment is computed as a minimum-cost flow over equivalence classes of identical topologies (see doEquivalenceClassMatching), which yields an optimal per-runner assignment since members of a class are interchangeable.
+   * 
+   * @param[in] requested The topologies requested by the runners
+   * @param[in] given The topologies of the available hosts
+   * 
+   * @return If successful, a vector of size size(requested) containing the indexes of the given topologies that match the requested ones. Otherwise, an empty vector.
+   */
+  [[nodiscard]] __INLINE__ static std::vector<size_t> doWeightedMatching(const std::vector<HiCR::Topology> &requested, const std::vector<HiCR::Topology> &given)
+  {
+    return solveClassTransportation(requested, given, true);
+  }
+
+  /**
+   * Performs a matching that packs several runners into each host, treating the given topologies as divisible capacity rather than pairing each runner with a whole host.
+   * 
+   * The runners are packed first-fit decreasing by PackingMatcher, which also divides the compute resources and memory of each host among its runners. Use it directly to get
+   * these per-runner partitions, or to pack several deployments into the same hosts. Since several runners may be paired with the same host, their deployment needs the
+   * batched or tree launch modes, which send a single start command per host.
+   * 
+   * @param[in] requested The topologies requested by the runners
+   * @param[in] given The topologies of the available hosts
+   * 
+   * @return If successful, a vector of size size(requested) containing the indexes of the given topologies the requested ones are packed into. Otherwise, an empty vector.
+   */
+  [[nodiscard]] __INLINE__ static std::vector<size_t> doPackingMatching(const std::vector<HiCR::Topology> &requested, const std::vector<HiCR::Topology> &given)
+  {
+    PackingMatcher matcher(given);
+    const auto     partitions = matcher.pack(requested);
+    if (partitions.size() < requested.size()) return {};
+
+    std::vector<size_t> pairingsVector(requested.size());
+    for (size_t i = 0; i < requested.size(); i++) pairingsVector[i] = partitions[i].hostIdx;
+    return pairingsVector;
+  }
+
+  /**
+   * Performs a matching between a set of required topologies and a set of given topologies that places heavily communicating runners close to each other.
+   * 
+   * A feasible assignment is first found with doBipartiteMatching. It is then improved by local search: each communicating runner is moved to the compatible host,
+   * free or occupied by a runner that can take its place, that most reduces the sum over all communicating pairs of their weight times the locality distance of their hosts.
+   * Since this objective makes the problem a quadratic assignment, the result is a local optimum rather than a global one.
+   * 
+   * @param[in] requested The topologies requested by the runners
+   * @param[in] given The topologies of the available hosts
+   * @param[in] givenLocalities The locality of each of the available hosts (see setLocalLocality and getHostLocality)
+   * @param[in] communicationGroups The groups of communicating runners. Their runner ids are taken as indexes into the requested topologies
+   * @param[in] threadCount The number of threads used to build the compatibility graph. Zero means using the hardware concurrency of the system
+   * 
+   * @return If successful, a vector of size size(requested) containing the indexes of the given topologies that match the requested ones. Otherwise, an empty vector.
+   */
+  [[nodiscard]] __INLINE__ static std::vector<size_t> doLocalityAwareMatching(const std::vector<HiCR::Topology>                   &requested,
+                                                                              const std::vector<HiCR::Topology>                   &given,
+                                                                              const std::vector<std::string>                      &givenLocalities,
+                                                                              const std::vector<Deployment::communicationGroup_t> &communicationGroups,
+                                                                              const size_t                                         threadCount = 0)
+  {
+    if (givenLocalities.size() != given.size())
+      HICR_THROW_LOGIC("[DeployR] The number of host localities (%lu) does not match the number of given topologies (%lu).\n", givenLocalities.size(), given.size());
+
+    // Finding out which hosts are compatible with each runner
+    const auto compatibility = buildCompatibilityGraph(requested, given, threadCount);
+
+    // Starting from any feasible assignment
+    BipartiteMatcher matcher;
+    matcher.loadGraph(compatibility, given.size());
+    if (matcher.computeMaximumMatching() < requested.size()) return {};
+    std::vector<size_t> pairingsVector(matcher.getLeftPairings().begin(), matcher.getLeftPairings().end());
+
+    // Collecting the communication partners of each runner, with the weight of each pair
+    std::vector<std::vector<std::pair<size_t, double>>> partners(requested.size());
+    for (const auto &group : communicationGroups)
+      for (const auto a : group.runnerIds)
+      {
+        if (a >= requested.size()) HICR_THROW_LOGIC("[DeployR] Communication group refers to runner %lu, but only %lu runners were requested.\n", a, requested.size());
+        for (const auto b : group.runnerIds)
+          if (a != b) partners[a].push_back({b, group.weight});
+      }
+
+    // Splitting the localities into their levels once, to compute distances fast
+    std::vector<std::vector<std::string>> givenLevels;
+    for (const auto &locality : givenLocalities) givenLevels.push_back(splitLocality(locality));
+
+    // Dense compatibility lookup, to check quickly whether a host can take a displaced runner
+    std::vector<uint8_t> isCompatible(requested.size() * given.size(), 0);
+    for (size_t i = 0; i < requested.size(); i++)
+      for (const auto j : compatibility[i]) isCompatible[i * given.size() + j] = 1;
+
+    // Runner currently placed on each host, if any
+    constexpr size_t    noRunner = std::numeric_limits<size_t>::max();
+    std::vector<size_t> occupants(given.size(), noRunner);
+    for (size_t i = 0; i < requested.size(); i++) occupants[pairingsVector[i]] = i;
+
+    // Communication cost of a runner under the current assignment
+    auto runnerCost = [&](const size_t runner) {
+      double cost = 0.0;
+      for (const auto &[partner, weight] : partners[runner]) cost += weight * (double)computeLevelDistance(givenLevels[pairingsVector[runner]], givenLevels[pairingsVector[partner]]);
+      return cost;
+    };
+
+    // Improving the assignment by moving or swapping runners, until no move reduces the cost or the pass limit is reached
+    for (size_t pass = 0; pass < __DEPLOYR_LOCALITY_MAX_PASSES; pass++)
+    {
+      bool isImproved = false;
+      for (size_t runner = 0; runner < requested.size(); runner++)
+      {
+        if (partners[runner].empty()) continue;
+
+        const size_t currentHost = pairingsVector[runner];
+        size_t       bestHost    = currentHost;
+        double       bestDelta   = 0.0;
+
+        for (const auto host : compatibility[runner])
+        {
+          if (host == currentHost) continue;
+
+          // A swap is only possible if the displaced runner fits in the current host
+          const size_t occupant = occupants[host];
+          if (occupant != noRunner && isCompatible[occupant * given.size() + currentHost] == 0) continue;
+
+          // Evaluating the move by applying it tentatively
+          const double costBefore = runnerCost(runner) + (occupant != noRunner ? runnerCost(occupant) : 0.0);
+          pairingsVector[runner]  = host;
+          if (occupant != noRunner) pairingsVector[occupant] = currentHost;
+          const double costAfter = runnerCost(runner) + (occupant != noRunner ? runnerCost(occupant) : 0.0);
+          pairingsVector[runner] = currentHost;
+          if (occupant != noRunner) pairingsVector[occupant] = host;
+
+          // Requiring a minimum improvement to avoid cycling due to rounding
+          const double delta = costAfter - costBefore;
+          if (delta < bestDelta - 1e-9)
+          {
+            bestDelta = delta;
+            bestHost  = host;
+          }
+        }
+
+        // Applying the best move found, if any
+        if (bestHost == currentHost) continue;
+        const size_t occupant  = occupants[bestHost];
+        pairingsVector[runner] = bestHost;
+        occupants[bestHost]    = runner;
+        occupants[currentHost] = occupant;
+        if (occupant != noRunner) pairingsVector[occupant] = currentHost;
+        isImproved = true;
+      }
+
+      if (isImproved == false) break;
+    }
+
+    return pairingsVector;
+  }
+
+  /**
+   * Computes the distance between two localities, as the number of levels in which they differ: the depth of the deeper one minus the number of leading levels they share.
+   * 
+   * For example, "rack0/node1" and "rack0/node2" are at distance 1, "rack0/node1" and "rack1/node1" at distance 2, and identical localities at distance 0.
+   * 
+   * @param[in] a The first locality
+   * @param[in] b The second locality
+   * 
+   * @return The distance between the localities
+   */
+  [[nodiscard]] __INLINE__ static size_t computeLocalityDistance(const std::string &a, const std::string &b) { return computeLevelDistance(splitLocality(a), splitLocality(b)); }
+
+  /**
+   * Groups identical topologies into equivalence classes. Two topologies are considered identical if their serialized forms are equal
+   * 
+   * @param[in] topologies The topologies to group
+   * 
+   * @return One entry per class, in order of first appearance, containing the indexes of its member topologies in increasing order
+   */
+  [[nodiscard]] __INLINE__ static std::vector<std::vector<size_t>> groupEquivalentTopologies(const std::vector<HiCR::Topology> &topologies)
+  {
+    std::vector<std::vector<size_t>> classes;
+    std::map<std::string, size_t>    classIndexes;
+
+    for (size_t i = 0; i < topologies.size(); i++)
+    {
+      const auto key               = topologies[i].serialize().dump();
+      const auto [entry, isNewKey] = classIndexes.try_emplace(key, classes.size());
+      if (isNewKey) classes.emplace_back();
+      classes[entry->second].push_back(i);
+    }
+
+    return classes;
+  }
+
+  /**
+   * Finds out, for each requested topology, which of the given topologies are a superset of it.
+   * 
+   * Pairs are first filtered by comparing resource-count signatures, so that the full HiCR::Topology::isSubset check only runs on pairs that may be compatible.
+   * For large inputs, the requested topologies are distributed among a pool of worker threads.
+   * 
+   * @param[in] requested The requested topologies
+   * @param[in] given The given (existing) topologies
+   * @param[in] threadCount The number of threads to use. Zero means using the hardware concurrency of the system
+   * 
+   * @return A vector of size size(requested), where each entry contains the indexes of the given topologies compatible with the corresponding requested one, in increasing order
+   */
+  [[nodiscard]] __INLINE__ static std::vector<std::vector<size_t>> buildCompatibilityGraph(const std::vector<HiCR::Topology> &requested,
+                                                                                           const std::vector<HiCR::Topology> &given,
+                                                                                           const size_t                       threadCount = 0)
+  {
+    // Canonicalizing topologies into resource-count signatures
+    const ResourceSignatures signatures(requested, given);
+
+    // Storage for the compatible hosts of each requested runner
+    std::vector<std::vector<size_t>> compatibility(requested.size());
+
+    // Function that fills in the compatible hosts of a range of requested runners
+    auto fillCompatibility = [&](const size_t begin, const size_t end) {
+      for (size_t i = begin; i < end; i++)
+        for (size_t j = 0; j < given.size(); j++)
+          if (signatures.mayContain(i, j) && HiCR::Topology::isSubset(given[j], requested[i])) compatibility[i].push_back(j);
+    };
+
+    // Small inputs are not worth the threading overhead
+    if (requested.size() * given.size() < __DEPLOYR_PARALLEL_COMPATIBILITY_MIN_PAIRS || requested.size() < 2)
+    {
+      fillCompatibility(0, requested.size());
+      return compatibility;
+    }
+
+    // Otherwise, distributing the requested runners among the workers
+    WorkerPool pool(std::min(threadCount == 0 ? std::thread::hardware_concurrency() : threadCount, requested.size()));
+    pool.parallelFor(requested.size(), fillCompatibility);
+
+    return compatibility;
+  }
+
+  private:
+
+  /**
+   * [Internal] Solves the assignment of runners to hosts as a transportation problem between equivalence classes of identical topologies
+   * 
+   * @param[in] requested The topologies requested by the runners
+   * @param[in] given The topologies of the available hosts
+   * @param[in] minimizeExcess Whether to find the assignment that minimizes the excess resources of the hosts over the requests, rather than any assignment
+   * 
+   * @return If successful, a vector of size size(requested) containing the indexes of the given topologies that match the requested ones. Otherwise, an empty vector.
+   */
+  [[nodiscard]] __INLINE__ static std::vector<size_t> solveClassTransportation(const std::vector<HiCR::Topology> &requested,
+                                                                               const std::vector<HiCR::Topology> &given,
+                                                                               const bool                         minimizeExcess)
+  {
+    // Grouping identical topologies
+    const auto requestedClasses = groupEquivalentTopologies(requested);
+    const auto givenClasses     = groupEquivalentTopologies(given);
+
+    // Picking the first member of each class as its representative
+    std::vector<HiCR::Topology> requestedRepresentatives, givenRepresentatives;
+    for (const auto &members : requestedClasses) requestedRepresentatives.push_back(requested[members[0]]);
+    for (const auto &members : givenClasses) givenRepresentatives.push_back(given[members[0]]);
+
+    // Building the transportation network. Vertex 0 is the source, followed by the runner classes, the host classes and the sink
+    const size_t source = 0;
+    const size_t sink   = 1 + requestedClasses.size() + givenClasses.size();
+    FlowNetwork  network(sink + 1);
+
+    for (size_t r = 0; r < requestedClasses.size(); r++) network.addEdge(source, 1 + r, requestedClasses[r].size());
+    for (size_t g = 0; g < givenClasses.size(); g++) network.addEdge(1 + requestedClasses.size() + g, sink, givenClasses[g].size());
+
+    // Adding an unlimited edge between every pair of compatible classes
+    const auto                                      compatibility = buildCompatibilityGraph(requestedRepresentatives, givenRepresentatives);
+    const auto                                      excessCosts   = minimizeExcess ? computeExcessCosts(requestedRepresentatives, givenRepresentatives) : std::vector<FlowNetwork::cost_t>();
+    std::vector<std::tuple<size_t, size_t, size_t>> classEdges;
+    for (size_t r = 0; r < requestedClasses.size(); r++)
+      for (const auto g : compatibility[r])
+      {
+        const auto cost = minimizeExcess ? excessCosts[r * givenClasses.size() + g] : 0;
+        classEdges.push_back({r, g, network.addEdge(1 + r, 1 + requestedClasses.size() + g, FlowNetwork::unlimited, cost)});
+      }
+
+    // If not all runners can be assigned, return an empty vector
+    const auto flow = minimizeExcess ? network.computeMinCostMaxFlow(source, sink) : network.computeMaxFlow(source, sink);
+    if ((size_t)flow < requested.size()) return {};
+
+    // Expanding the class-level flow into individual pairings, handing out the members of each class in order
+    std::vector<size_t> pairingsVector(requested.size());
+    std::vector<size_t> nextRequested(requestedClasses.size(), 0);
+    std::vector<size_t> nextGiven(givenClasses.size(), 0);
+    for (const auto &[r, g, edgeId] : classEdges)
+      for (FlowNetwork::capacity_t k = 0; k < network.getFlow(edgeId); k++) pairingsVector[requestedClasses[r][nextRequested[r]++]] = givenClasses[g][nextGiven[g]++];
+
+    return pairingsVector;
+  }
+
+  /**
+   * [Internal] Splits the runners of a hierarchical deployment among its partitions, as a transportation problem between the runners grouped by their requested topology
+   * and the classes of identical hosts of every partition
+   *
+   * @param[in] deployment The runners, each with its requested topology
+   * @param[in] summaries The summary of the hosts of each partition
+   *
+   * @return If successful, a vector of size deployment.getRunnerCount() containing the index of the partition of each runner. Otherwise, an empty vector.
+   */
+  [[nodiscard]] __INLINE__ static std::vector<size_t> partitionRunners(const Deployment &deployment, const std::vector<PartitionSummary> &summaries)
+  {
+    const auto &topologyIdxs = deployment.getTopologyIdxs();
+
+    // Grouping the runners by their requested topology
+    std::vector<std::vector<size_t>> runnerClasses(deployment.getTopologies().size());
+    for (size_t i = 0; i < topologyIdxs.size(); i++) runnerClasses[topologyIdxs[i]].push_back(i);
+
+    // Flattening the host classes of all partitions
+    std::vector<HiCR::Topology> hostTopologies;
+    std::vector<size_t>         hostCounts, hostPartitions;
+    for (size_t p = 0; p < summaries.size(); p++)
+      for (size_t c = 0; c < summaries[p].getTopologies().size(); c++)
+      {
+        hostTopologies.push_back(summaries[p].getTopologies()[c]);
+        hostCounts.push_back(summaries[p].getHostCounts()[c]);
+        hostPartitions.push_back(p);
+      }
+
+    // Building the transportation network. Vertex 0 is the source, followed by the runner classes, the host classes and the sink
+    const size_t source = 0;
+    const size_t sink   = 1 + runnerClasses.size() + hostTopologies.size();
+    FlowNetwork  network(sink + 1);
+
+    for (size_t r = 0; r < runnerClasses.size(); r++) network.addEdge(source, 1 + r, runnerClasses[r].size());
+    for (size_t h = 0; h < hostTopologies.size(); h++) network.addEdge(1 + runnerClasses.size() + h, sink, hostCounts[h]);
+
+    // Adding an unlimited edge between every pair of compatible classes
+    const auto                                      compatibility = buildCompatibilityGraph(deployment.getTopologies(), hostTopologies);
+    std::vector<std::tuple<size_t, size_t, size_t>> classEdges;
+    for (size_t r = 0; r < runnerClasses.size(); r++)
+      for (const auto h : compatibility[r]) classEdges.push_back({r, h, network.addEdge(1 + r, 1 + runnerClasses.size() + h, FlowNetwork::unlimited)});
+
+    // If not all runners can be assigned, return an empty vector
+    if ((size_t)network.computeMaxFlow(source, sink) < topologyIdxs.size()) return {};
+
+    // Handing out the runners of each class to the partitions their flow goes to
+    std::vector<size_t> runnerPartitions(topologyIdxs.size());
+    std::vector<size_t> nextRunner(runnerClasses.size(), 0);
+    for (const auto &[r, h, edgeId] : classEdges)
+      for (FlowNetwork::capacity_t k = 0; k < network.getFlow(edgeId); k++) runnerPartitions[runnerClasses[r][nextRunner[r]++]] = hostPartitions[h];
+
+    return runnerPartitions;
+  }
+
+  /**
+   * [Internal] Computes the cost of assigning each requested topology to each given topology, as the normalized excess of resources of the latter over the former
+   * 
+   * @param[in] requested The requested topologies
+   * @param[in] given The given topologies
+   * 
+   * @return A row-major matrix of size size(requested) x size(given) with the cost of each pair. Only meaningful for compatible pairs
+   */
+  [[nodiscard]] __INLINE__ static std::vector<FlowNetwork::cost_t> computeExcessCosts(const std::vector<HiCR::Topology> &requested, const std::vector<HiCR::Topology> &given)
+  {
+    // Each kind of resource contributes at most this much to the cost, when the host has the largest amount found and the request is empty
+    constexpr FlowNetwork::cost_t costScale = 1 << 20;
+
+    const ResourceSignatures signatures(requested, given);
+    const size_t             dimensionCount = signatures.getDimensions().size();
+
+    // Finding the largest amount of each kind of resource among the hosts, for normalization
+    std::vector<ResourceSignatures::counter_t> maxGiven(dimensionCount, 0);
+    for (size_t j = 0; j < given.size(); j++)
+      for (size_t d = 0; d < dimensionCount; d++) maxGiven[d] = std::max(maxGiven[d], signatures.getGivenSignature(j)[d]);
+
+    // Adding up the normalized excess of each kind of resource
+    std::vector<FlowNetwork::cost_t> costs(requested.size() * given.size(), 0);
+    for (size_t i = 0; i < requested.size(); i++)
+      for (size_t j = 0; j < given.size(); j++)
+      {
+        const auto requestedSignature = signatures.getRequestedSignature(i);
+        const auto givenSignature     = signatures.getGivenSignature(j);
+        auto      &cost               = costs[i * given.size() + j];
+        for (size_t d = 0; d < dimensionCount; d++)
+          if (givenSignature[d] > requestedSignature[d]) cost += (FlowNetwork::cost_t)((long double)(givenSignature[d] - requestedSignature[d]) * costScale / maxGiven[d]);
+      }
+
+    return costs;
+  }
+
+  /**
+   * [Internal] Splits a locality into its levels
+   * 
+   * @param[in] locality The locality to split
+   * 
+   * @return The levels of the locality, from the outermost to the innermost. Empty levels are ignored
+   */
+  [[nodiscard]] __INLINE__ static std::vector<std::string> splitLocality(const std::string &locality)
+  {
+    std::vector<std::string> levels;
+    size_t                   begin = 0;
+    while (begin <= locality.size())
+    {
+      auto end = locality.find(__DEPLOYR_LOCALITY_SEPARATOR, begin);
+      if (end == std::string::npos) end = locality.size();
+      if (end > begin) levels.push_back(locality.substr(begin, end - begin));
+      begin = end + 1;
+    }
+    return levels;
+  }
+
+  /**
+   * [Internal] Computes the distance between two split localities (see computeLocalityDistance)
+   * 
+   * @param[in] a The levels of the first locality
+   * @param[in] b The levels of the second locality
+   * 
+   * @return The distance between the localities
+   */
+  [[nodiscard]] __INLINE__ static size_t computeLevelDistance(const std::vector<std::string> &a, const std::vector<std::string> &b)
+  {
+    size_t sharedLevels = 0;
+    while (sharedLevels < a.size() && sharedLevels < b.size() && a[sharedLevels] == b[sharedLevels]) sharedLevels++;
+    return std::max(a.size(), b.size()) - sharedLevels;
+  }
+
+  /**
+   * [Internal] Looks up an instance known to the instance manager by its id.
+   * 
+   * The lookup goes through a persistent index. Instances created and terminated through DeployR update it directly. Those added or removed by other means are
+   * picked up by re-synchronizing the index with the instance manager whenever its number of instances changed, or an id is not found.
+   * 
+   * @param[in] instanceId The id of the instance
+   * 
+   * @return The instance, or nullptr if the instance manager does not know it
+   */
+  [[nodiscard]] __INLINE__ HiCR::Instance *getInstance(const HiCR::Instance::instanceId_t instanceId)
+  {
+#ifdef _DEPLOYR_DISTRIBUTED_ENGINE_LOCAL
+    // The local engine looks its instances up by id already. Indexing them in every simulated instance would multiply the work by the number of instances
+    return _instanceManager->getInstance(instanceId);
+#else
+    std::unique_lock lock(_instanceIndexMutex);
+
+    // Re-synchronizing if the instance manager changed since the last time
+    if (_instanceManager->getInstances().size() != _instanceIndexSyncSize) syncInstanceIndex();
+
+    auto entry = _instanceIndex.find(instanceId);
+    if (entry != _instanceIndex.end()) return entry->second.get();
+
+    // The instance may have been replaced without changing the number of instances
+    syncInstanceIndex();
+    entry = _instanceIndex.find(instanceId);
+    return entry == _instanceIndex.end() ? nullptr : entry->second.get();
+#endif
+  }
+
+  /**
+   * [Internal] Re-synchronizes the instance index with the instance manager. Only new instances are added, unless some were removed. Requires holding the index mutex
+   */
+  __INLINE__ void syncInstanceIndex()
+  {
+    const auto &instances = _instanceManager->getInstances();
+    for (const auto &instance : instances) _instanceIndex.try_emplace(instance->getId(), instance);
+
+    // Any extra entries belong to removed instances: rebuilding the index from scratch
+    if (_instanceIndex.size() != instances.size())
+    {
+      _instanceIndex.clear();
+      for (const auto &instance : instances) _instanceIndex.try_emplace(instance->getId(), instance);
+    }
+
+    _instanceIndexSyncSize = instances.size();
+  }
+
+  /**
+   * [Internal] Adds an instance just created through the instance manager to the instance index, without re-synchronizing it
+   * 
+   * @param[in] instance The new instance
+   */
+  __INLINE__ void indexInstance(const std::shared_ptr<HiCR::Instance> &instance)
+  {
+    std::unique_lock lock(_instanceIndexMutex);
+    if (_instanceIndex.try_emplace(instance->getId(), instance).second) _instanceIndexSyncSize++;
+  }
+
+  /**
+   * [Internal] Removes an instance just terminated through the instance manager from the instance index
+   * 
+   * @param[in] instanceId The id of the terminated instance
+   */
+  __INLINE__ void unindexInstance(const HiCR::Instance::instanceId_t instanceId)
+  {
+    std::unique_lock lock(_instanceIndexMutex);
+    _instanceIndex.erase(instanceId);
+  }
+
+  /**
+   * [Internal] Deploys the share of a hierarchical deployment assigned to the partition coordinated by this instance, and reports its completion to the global coordinator
+   *
+   * @param[in] partition The partition coordinated by this instance
+   * @param[in] globalCoordinatorInstanceId The id of the global coordinator
+   */
+  __INLINE__ void deployPartition(const partition_t &partition, const HiCR::Instance::instanceId_t globalCoordinatorInstanceId)
+  {
+    const auto currentInstanceId         = _instanceManager->getCurrentInstance()->getId();
+    const auto globalCoordinatorInstance = getInstance(globalCoordinatorInstanceId);
+    if (globalCoordinatorInstance == nullptr) HICR_THROW_LOGIC("[DeployR] Provided instance id %lu not found in the instance manager provided.\n", globalCoordinatorInstanceId);
+
+    // Gathering the topologies of the hosts of the partition
+    std::vector<HiCR::Topology> hostTopologies;
+    {
+      auto span      = _tracer.span("Gather Topology", "Phase");
+      hostTopologies = gatherTopologies(partition.instanceIds);
+    }
+
+    // Summarizing them into classes of identical hosts, and serving the summary to the global coordinator
+    std::vector<HiCR::Topology> classTopologies;
+    std::vector<size_t>         hostCounts;
+    for (const auto &members : groupEquivalentTopologies(hostTopologies))
+    {
+      classTopologies.push_back(hostTopologies[members[0]]);
+      hostCounts.push_back(members.size());
+    }
+    _pendingPartitionSummary = PartitionSummary(std::move(classTopologies), std::move(hostCounts)).serialize();
+    while (_pendingPartitionSummary.has_value()) listen();
+
+    // Fetching the share of the runners assigned to this partition
+    nlohmann::json serializedShare;
+    {
+      auto span = _tracer.span("Fetch Partition Share", "RPC", globalCoordinatorInstanceId);
+      requestRPC(*globalCoordinatorInstance, __DEPLOYR_GET_PARTITION_SHARE_RPC_NAME, currentInstanceId);
+      auto returnValue = getReturnValue(*globalCoordinatorInstance);
+      serializedShare  = WireFormat::decode(returnValue->getPointer(), returnValue->getSize(), WireFormat::encoding_t::cbor);
+      span.setBytes(returnValue->getSize());
+      _rpcEngine->getMemoryManager()->freeLocalMemorySlot(returnValue);
+    }
+    const PartitionShare share(std::move(serializedShare));
+    const size_t         runnerCount = share.getRunnerCount();
+
+    // Matching the share to the hosts of the partition. The global coordinator split the runners by the same host classes, so a matching exists unless some host changed meanwhile
+    const auto matching = runnerCount == 0 ? std::vector<size_t>() : doEquivalenceClassMatching(share.getRequestedTopologies(), hostTopologies);
+
+    // Releasing the hosts left without runners, which are all of them if no matching was found
+    std::vector<bool> isHostUsed(partition.instanceIds.size(), false);
+    for (const auto hostIdx : matching) isHostUsed[hostIdx] = true;
+    for (size_t i = 0; i < partition.instanceIds.size(); i++)
+    {
+      if (isHostUsed[i] || partition.instanceIds[i] == currentInstanceId) continue;
+      const auto instance = getInstance(partition.instanceIds[i]);
+      if (instance == nullptr) HICR_THROW_LOGIC("[DeployR] Provided instance id %lu not found in the instance manager provided.\n", partition.instanceIds[i]);
+      requestRPC(*instance, __DEPLOYR_RELEASE_PARTITION_HOST_RPC_NAME);
+    }
+
+    // The global coordinator expects no report from partitions without runners
+    if (runnerCount == 0) return;
+
+    // Deploying the share as the coordinator of the partition, and waiting for all of its runners. If no matching was found, they all fail without running.
+    // If a runner of this instance fails, the rest are still awaited and reported before rethrowing its exception, so that the global coordinator does not wait forever
+    std::vector<Runner::runnerId_t> failedRunnerIds;
+    std::exception_ptr              localException;
+    if (matching.size() != runnerCount) failedRunnerIds = share.getRunnerIds();
+    else
+    {
+      std::vector<HiCR::Instance::instanceId_t> instanceIds;
+      instanceIds.reserve(runnerCount);
+      for (const auto hostIdx : matching) instanceIds.push_back(partition.instanceIds[hostIdx]);
+
+      const auto handle = deployAsync(share.createDeployment(instanceIds), currentInstanceId, (launchMode_t)share.getLaunchMode());
+      try
+      {
+        handle->wait();
+      }
+      catch (...)
+      {
+        localException = std::current_exception();
+        handle->wait();
+      }
+      std::erase(_activeDeployments, handle);
+      for (const auto &[runnerId, state] : handle->getStates())
+        if (state == DeploymentHandle::runnerState_t::failed) failedRunnerIds.push_back(runnerId);
+    }
+
+    // Reporting the completion of the share to the global coordinator, and serving its request for the report
+    nlohmann::json report;
+    report["Failed Runner Ids"] = failedRunnerIds;
+    _pendingPartitionReport     = std::move(report);
+    requestRPC(*globalCoordinatorInstance, __DEPLOYR_REPORT_PARTITION_COMPLETION_RPC_NAME, currentInstanceId);
+    while (_pendingPartitionReport.has_value()) listen();
+
+    if (localException != nullptr) std::rethrow_exception(localException);
+  }
+
+  /**
+   * [Internal] Sends the start command to the subtrees of the launch tree below this instance, and serves them their launch plans.
+   * 
+   * The range of plan entries is split into up to fanout contiguous chunks (see LaunchPlan::splitRange). The first host of each chunk becomes a child of this instance, and is in charge of the rest of its chunk.
+   * 
+   * @param[in] plan The launch plan, with one entry per host
+   * @param[in] begin The first entry of the range to dispatch
+   * @param[in] end One past the last entry of the range to dispatch
+   * @param[in] fanout The maximum number of children per instance in the launch tree
+   * 
+   * @return The number of children this instance sent the start command to
+   */
+  __INLINE__ size_t dispatchLaunchPlan(const nlohmann::json &plan, const size_t begin, const size_t end, const size_t fanout)
+  {
+    const auto currentInstanceId = _instanceManager->getCurrentInstance()->getId();
+
+    // Splitting the range into nearly equal chunks, and sending the start command to the first runner of each
+    const auto                                chunks = LaunchPlan::splitRange(begin, end, fanout);
+    std::vector<HiCR::Instance::instanceId_t> childInstanceIds;
+    for (const auto &[chunkBegin, chunkEnd] : chunks)
+    {
+      const auto childInstanceId = plan[chunkBegin]["Instance Id"].get<HiCR::Instance::instanceId_t>();
+
+      // Keeping the chunk until the child requests it
+      _pendingLaunchPlans[childInstanceId] = {{"Coordinator", _coordinatorInstanceId}, {"Fanout", fanout}, {"Hosts", nlohmann::json(plan.begin() + chunkBegin, plan.begin() + chunkEnd)}};
+      const auto childInstance = getInstance(childInstanceId);
+      if (childInstance == nullptr) HICR_THROW_RUNTIME("[DeployR] Launch child instance %lu not found in the instance manager provided.\n", childInstanceId);
+      requestRPC(*childInstance, __DEPLOYR_LAUNCH_SUBTREE_RPC_NAME, currentInstanceId);
+      childInstanceIds.push_back(childInstanceId);
+    }
+
+    // Serving the launch plan request of each child. Other requests (e.g., completion reports to the coordinator) may arrive in between
+    while (std::any_of(childInstanceIds.begin(), childInstanceIds.end(), [this](const auto id) { return _pendingLaunchPlans.contains(id); })) listen();
+
+    return chunks.size();
+  }
+
+  /**
+   * [Internal] Runs the runners assigned to this instance. A single runner runs on the calling thread; several runners, or any runner while sending heartbeats, run on one local thread each
+   * 
+   * @param[in] runners The runners to run, along with their payloads
+   * @param[in] heartbeatInterval The time between the heartbeats sent to the coordinator while the runners run, or zero if it holds no lease on this instance
+   */
+  __INLINE__ void runLocalRunners(LaunchPlan::hostRunners_t runners, const std::chrono::nanoseconds heartbeatInterval = std::chrono::nanoseconds(0))
+  {
+    if (runners.runnerIds.empty()) return;
+
+    // When offloading, handing the runners over to the dedicated execution resources and returning right away
+    if (isOffloadingRunners()) return offloadRunners(runners, heartbeatInterval);
+
+    // When pinning, the resources of this host are given out to the runners in order
+    ResourcePinner pinner(_localTopology);
+
+    // The common case: one runner per instance. When sending heartbeats, it runs on its own thread instead, so that this one keeps sending them
+    if (runners.runnerIds.size() == 1 && heartbeatInterval.count() == 0)
+    {
+      _initialFunctionId = runners.functionIds[0];
+      _runnerId          = runners.runnerIds[0];
+      _runnerPayload     = std::move(runners.payloads[0]);
+      try
+      {
+        const auto placement = pinRunner(pinner, runners, 0);
+        auto       span      = _tracer.span("Run", "Runner");
+        if (placement.has_value()) runPinned(*placement, [this]() { runInitialFunction(); });
+        else runInitialFunction();
+      }
+      catch (...)
+      {
+        // When serving, the failure is only reported, so that the instance keeps serving
+        _runnerPayload = {};
+        freeReleasedPayloads();
+        reportRunnerCompletion(_runnerId, true);
+        if (_isServing == false) throw;
+        return;
+      }
+      _runnerPayload = {};
+      freeReleasedPayloads();
+      reportRunnerCompletion(_runnerId, false);
+      return;
+    }
+
+    // Checking all requested functions were registered before starting any of them
+    for (const auto functionId : runners.functionIds)
+      if (_registeredFunctions.contains(functionId) == false)
+        HICR_THROW_FATAL("The requested function (id %u) is not registered. Please register it before initializing DeployR.\n", functionId);
+
+    // Running each runner on its own thread, which remembers its runner id and the exception it threw, if any. Runners that cannot be pinned fail without running
+    std::vector<std::exception_ptr> exceptions(runners.runnerIds.size());
+    {
+      WorkerPool pool(runners.runnerIds.size());
+      for (size_t i = 0; i < runners.runnerIds.size(); i++)
+      {
+        std::optional<ResourcePinner::placement_t> placement;
+        try
+        {
+          placement = pinRunner(pinner, runners, i);
+        }
+        catch (...)
+        {
+          exceptions[i] = std::current_exception();
+          continue;
+        }
+
+        const auto runnerId = runners.runnerIds[i];
+        const auto function = getRegisteredFunction(runners.functionIds[i]);
+        pool.submit([this, runnerId, function, placement, payload = std::move(runners.payloads[i]), &exception = exceptions[i]]() {
+          getThreadRunnerId()      = runnerId;
+          getThreadRunnerPayload() = payload;
+          try
+          {
+            auto span = _tracer.span("Run", "Runner");
+            if (placement.has_value()) runPinned(*placement, function);
+            else function();
+          }
+          catch (...)
+          {
+            exception = std::current_exception();
+          }
+          getThreadRunnerPayload() = {};
+          getThreadRunnerId().reset();
+        });
+      }
+
+      // Waiting for all of them to finish, renewing the lease of the coordinator meanwhile. The last heartbeat is sent before the completion reports
+      if (heartbeatInterval.count() > 0)
+      {
+        const auto coordinatorInstance = getInstance(_coordinatorInstanceId);
+        if (coordinatorInstance == nullptr) HICR_THROW_RUNTIME("[DeployR] Coordinator instance %lu not found in the instance manager provided.\n", _coordinatorInstanceId);
+        sendHeartbeat(*coordinatorInstance);
+        while (pool.waitFor(heartbeatInterval) == false) sendHeartbeat(*coordinatorInstance);
+      }
+      else pool.wait();
+    }
+
+    // Reporting their completion from this thread, and re-throwing the first failure unless serving
+    freeReleasedPayloads();
+    for (size_t i = 0; i < runners.runnerIds.size(); i++) reportRunnerCompletion(runners.runnerIds[i], exceptions[i] != nullptr);
+    if (_isServing) return;
+    for (const auto &exception : exceptions)
+      if (exception != nullptr) std::rethrow_exception(exception);
+  }
+
+  /**
+   * [Internal] Finds the resources of this host for a runner, if it carries its requested topology
+   * 
+   * @param[in] pinner The resource pinner of this host, shared by all the runners started together
+   * @param[in] runners The runners of this host
+   * @param[in] idx The index of the runner among them
+   * 
+   * @return The placement of the runner, or nothing if it is not to be pinned
+   */
+  [[nodiscard]] __INLINE__ std::optional<ResourcePinner::placement_t> pinRunner(ResourcePinner &pinner, const LaunchPlan::hostRunners_t &runners, const size_t idx) const
+  {
+    if (runners.topologyIdxs.empty() || runners.topologyIdxs[idx] == Deployment::noTopology) return std::nullopt;
+
+    auto placement = pinner.pin(HiCR::Topology(runners.topologies.at(runners.topologyIdxs[idx])));
+    if (placement.has_value() == false)
+      HICR_THROW_RUNTIME("[DeployR] Runner %lu cannot be pinned: the local topology does not satisfy its requested topology.\n", runners.runnerIds[idx]);
+    return placement;
+  }
+
+  /**
+   * [Internal] Runs a function on the calling thread, bound to the processors of a placement. The previous affinity of the thread is restored afterwards, even if the function throws
+   * 
+   * @param[in] placement The placement to bind the thread to, which the function can get with getRunnerPlacement
+   * @param[in] fc The function to run
+   */
+  __INLINE__ static void runPinned(const ResourcePinner::placement_t &placement, const std::function<void()> &fc)
+  {
+    const auto previousAffinity = ResourcePinner::getCurrentThreadAffinity();
+    ResourcePinner::bindCurrentThread(placement);
+    getThreadRunnerPlacement() = placement;
+    try
+    {
+      fc();
+    }
+    catch (...)
+    {
+      getThreadRunnerPlacement() = {};
+      ResourcePinner::setCurrentThreadAffinity(previousAffinity);
+      throw;
+    }
+    getThreadRunnerPlacement() = {};
+    ResourcePinner::setCurrentThreadAffinity(previousAffinity);
+  }
+
+  /**
+   * [Internal] Indicates whether runners are to run on the dedicated execution resources rather than on the calling thread
+   * 
+   * @return true, if serving with dedicated execution resources; false, otherwise
+   */
+  [[nodiscard]] __INLINE__ bool isOffloadingRunners() const { return _isServing && _runnerExecutionPool != nullptr; }
+
+  /**
+   * [Internal] Listens for the next incoming RPC. It is used in place of the RPC engine's listen, so that the payloads released by the runners are freed after
+   * each served RPC
+   */
+  __INLINE__ void listen()
+  {
+    _rpcEngine->listen();
+    freeReleasedPayloads();
+  }
+
+  /**
+   * [Internal] Frees the memory slots of the received payloads that their runners are done with. Only called by the listening thread, after each served RPC
+   */
+  __INLINE__ void freeReleasedPayloads()
+  {
+    std::vector<std::shared_ptr<HiCR::LocalMemorySlot>> payloadSlots;
+    {
+      std::unique_lock lock(_runnerReportMutex);
+      if (_releasedPayloadSlots.empty()) return;
+      payloadSlots.swap(_releasedPayloadSlots);
+    }
+    for (const auto &payloadSlot : payloadSlots) _rpcEngine->getMemoryManager()->freeLocalMemorySlot(payloadSlot);
+  }
+
+  /**
+   * [Internal] Runs runners on the dedicated execution resources. Their failures are reported, and not re-thrown
+   * 
+   * @param[in] runners The runners to run, along with their payloads
+   * @param[in] heartbeatInterval The time between the heartbeats sent to the coordinator while the runners run, or zero if it holds no lease on this instance
+   */
+  __INLINE__ void offloadRunners(const LaunchPlan::hostRunners_t &runners, const std::chrono::nanoseconds heartbeatInterval)
+  {
+    // Checking all requested functions were registered before starting any of them
+    for (const auto functionId : runners.functionIds)
+      if (_registeredFunctions.contains(functionId) == false)
+        HICR_THROW_FATAL("The requested function (id %u) is not registered. Please register it before initializing DeployR.\n", functionId);
+
+    // The runners report their completion to the coordinator themselves
+    const auto coordinatorInstance = getInstance(_coordinatorInstanceId);
+    if (coordinatorInstance == nullptr) HICR_THROW_RUNTIME("[DeployR] Coordinator instance %lu not found in the instance manager provided.\n", _coordinatorInstanceId);
+
+    // A thread sends the heartbeats while any of the leased runners runs, starting right away
+    if (heartbeatInterval.count() > 0)
+    {
+      {
+        std::unique_lock lock(_runnerReportMutex);
+        _leasedOffloadedRunnerIds.insert(runners.runnerIds.begin(), runners.runnerIds.end());
+      }
+      if (_offloadedRunnerHeartbeat == nullptr)
+        _offloadedRunnerHeartbeat = std::make_unique<Heartbeat>(heartbeatInterval, [this, coordinatorInstance]() { sendOffloadedRunnerHeartbeat(*coordinatorInstance); });
+    }
+
+    for (size_t i = 0; i < runners.runnerIds.size(); i++)
+    {
+      const auto runnerId = runners.runnerIds[i];
+      const auto function = getRegisteredFunction(runners.functionIds[i]);
+
+      _runnerExecutionPool->submit([this, runnerId, function, coordinatorInstance, payload = runners.payloads[i]]() {
+        getThreadRunnerId()      = runnerId;
+        getThreadRunnerPayload() = payload;
+        bool hasFailed           = false;
+        try
+        {
+          auto span = _tracer.span("Run", "Runner");
+          function();
+        }
+        catch (...)
+        {
+          hasFailed = true;
+        }
+        getThreadRunnerPayload() = {};
+        getThreadRunnerId().reset();
+
+        // Reporting its completion from this thread. The listening thread keeps serving meanwhile. No heartbeat is sent for it afterwards
+        std::unique_lock lock(_runnerReportMutex);
+        _leasedOffloadedRunnerIds.erase(runnerId);
+        sendRunnerReport(*coordinatorInstance, runnerId, hasFailed);
+      });
+    }
+  }
+
+  /**
+   * [Internal] Takes the runners assigned to this instance from its launch plan entry, and receives their payloads. Inline payloads are taken from the entry,
+   * the others are requested from the coordinator
+   * 
+   * @param[in] entry The launch plan entry of this instance, as built by LaunchPlan::addRunner
+   * 
+   * @return The runners, along with their payloads
+   */
+  [[nodiscard]] __INLINE__ LaunchPlan::hostRunners_t receiveHostRunners(const nlohmann::json &entry)
+  {
+    std::vector<std::pair<size_t, size_t>> servedPayloads;
+    auto                                   runners = LaunchPlan::parseEntry(entry, servedPayloads);
+    for (const auto &[i, payloadSize] : servedPayloads)
+    {
+      // Requesting the payload from the coordinator, which returns it straight from its buffer
+      const auto runnerId            = runners.runnerIds[i];
+      const auto coordinatorInstance = getInstance(_coordinatorInstanceId);
+      if (coordinatorInstance == nullptr) HICR_THROW_RUNTIME("[DeployR] Coordinator instance %lu not found in the instance manager provided.\n", _coordinatorInstanceId);
+      auto span = _tracer.span("Fetch Payload", "RPC", _coordinatorInstanceId);
+      requestRPC(*coordinatorInstance, __DEPLOYR_GET_RUNNER_PAYLOAD_RPC_NAME, runnerId);
+      auto returnValue = getReturnValue(*coordinatorInstance);
+      span.setBytes(returnValue->getSize());
+      if (returnValue->getSize() != payloadSize)
+        HICR_THROW_RUNTIME("[DeployR] Received %lu bytes of payload for runner %lu, instead of %lu.\n", returnValue->getSize(), runnerId, payloadSize);
+
+      // The payload refers to the received memory slot directly. Once the runner is done with it, the slot is handed to the listening thread, which owns the RPC engine, to free it
+      const auto freeReturnValue = [this, returnValue](const uint8_t *) {
+        std::unique_lock lock(_runnerReportMutex);
+        _releasedPayloadSlots.push_back(returnValue);
+      };
+      runners.payloads[i]        = {std::shared_ptr<const uint8_t>((const uint8_t *)returnValue->getPointer(), freeReturnValue), returnValue->getSize()};
+    }
+    return runners;
+  }
+
+  /**
+   * [Internal] Reports the completion of a runner to the coordinator of its deployment
+   * 
+   * @param[in] runnerId The id of the runner
+   * @param[in] hasFailed Whether the runner threw an exception
+   */
+  __INLINE__ void reportRunnerCompletion(const Runner::runnerId_t runnerId, const bool hasFailed)
+  {
+    // The coordinator records it directly
+    if (_instanceManager->getCurrentInstance()->getId() == _coordinatorInstanceId) return recordRunnerCompletion(runnerId, hasFailed);
+
+    // Otherwise, sending it
+    const auto coordinatorInstance = getInstance(_coordinatorInstanceId);
+    if (coordinatorInstance == nullptr) HICR_THROW_RUNTIME("[DeployR] Coordinator instance %lu not found in the instance manager provided.\n", _coordinatorInstanceId);
+    sendRunnerReport(*coordinatorInstance, runnerId, hasFailed);
+  }
+
+  /**
+   * [Internal] Sends the completion report of a runner to a remote coordinator. May be called by any thread
+   * 
+   * @param[in] coordinatorInstance The coordinator of the deployment of the runner
+   * @param[in] runnerId The id of the runner
+   * @param[in] hasFailed Whether the runner threw an exception
+   */
+  __INLINE__ void sendRunnerReport(HiCR::Instance &coordinatorInstance, const Runner::runnerId_t runnerId, const bool hasFailed)
+  {
+    // The runner id and whether it failed are packed in the RPC argument
+    requestRPC(coordinatorInstance, __DEPLOYR_REPORT_RUNNER_COMPLETION_RPC_NAME, (runnerId << 1) | (hasFailed ? 1 : 0));
+  }
+
+  /**
+   * [Internal] Records the completion of a runner in the handle of the deployment it belongs to. Only used by the coordinator
+   * 
+   * @param[in] runnerId The id of the runner
+   * @param[in] hasFailed Whether the runner threw an exception
+   */
+  __INLINE__ void recordRunnerCompletion(const Runner::runnerId_t runnerId, const bool hasFailed)
+  {
+    for (const auto &handle : _activeDeployments)
+      if (handle->isRunning(runnerId))
+      {
+        handle->setState(runnerId, hasFailed ? DeploymentHandle::runnerState_t::failed : DeploymentHandle::runnerState_t::finished);
+        releaseLeasedRunner(runnerId);
+        _pendingPayloads.erase(runnerId);
+        return;
+      }
+
+    // A respawned runner may report twice, if its first host was only late to renew its lease. The first report counts
+    if (_leaseRegistry.isRespawned(runnerId)) return;
+
+    HICR_THROW_RUNTIME("[DeployR] Received a completion report for runner %lu, which is not part of any active deployment.\n", runnerId);
+  }
+
+  /**
+   * [Internal] Sends a heartbeat to the coordinator, renewing the lease it holds on this instance. May be called by any thread
+   * 
+   * @param[in] coordinatorInstance The coordinator holding the lease
+   */
+  __INLINE__ void sendHeartbeat(HiCR::Instance &coordinatorInstance) { requestRPC(coordinatorInstance, __DEPLOYR_HEARTBEAT_RPC_NAME, _instanceManager->getCurrentInstance()->getId()); }
+
+  /**
+   * [Internal] Sends a heartbeat to the coordinator if any leased runner runs on the dedicated execution resources. Called by their heartbeat thread
+   * 
+   * @param[in] coordinatorInstance The coordinator holding the lease
+   */
+  __INLINE__ void sendOffloadedRunnerHeartbeat(HiCR::Instance &coordinatorInstance)
+  {
+    // Sending under the lock the runners report their completion under, so that no heartbeat follows the report of the last leased runner
+    std::unique_lock lock(_runnerReportMutex);
+    if (_leasedOffloadedRunnerIds.empty() == false) sendHeartbeat(coordinatorInstance);
+  }
+
+  /**
+   * [Internal] Requests a check of the leases from this instance, unless the last one requested was not served yet. Called by the lease monitor thread
+   * 
+   * @param[in] currentInstance This instance
+   */
+  __INLINE__ void requestLeaseCheck(HiCR::Instance &currentInstance)
+  {
+    if (_isLeaseCheckPending.exchange(true)) return;
+    requestRPC(currentInstance, __DEPLOYR_CHECK_LEASES_RPC_NAME, (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count());
+  }
+
+  /**
+   * [Internal] Handles the failure of the hosts whose lease expired. Only called by the listening thread, once the heartbeats received before the check was requested were served
+   * 
+   * @param[in] checkTime The time the check was requested at
+   */
+  __INLINE__ void checkLeases(const std::chrono::steady_clock::time_point checkTime)
+  {
+    // Respawning runners may listen, and handle other failed hosts meanwhile
+    for (const auto instanceId : _leaseRegistry.getExpiredInstanceIds(checkTime, _leaseDuration))
+      if (_leaseRegistry.isLeased(instanceId)) recoverHost(instanceId);
+  }
+
+  /**
+   * [Internal] Adds a remote runner to the lease of its host, granting the lease if the host had none, and starts checking the leases if not done yet. Only used by the coordinator
+   * 
+   * @param[in] runner The runner, along with what is needed to respawn it
+   */
+  __INLINE__ void grantLease(LeaseRegistry::leasedRunner_t &&runner)
+  {
+    _leaseRegistry.grant(std::move(runner));
+
+    // The leases are checked by a request of the coordinator to itself, which interrupts its listening
+    if (_leaseMonitor != nullptr) return;
+    const auto currentInstance = getInstance(_instanceManager->getCurrentInstance()->getId());
+    _leaseMonitor              = std::make_unique<Heartbeat>(_heartbeatInterval, [this, currentInstance]() { requestLeaseCheck(*currentInstance); });
+  }
+
+  /**
+   * [Internal] Removes a completed runner from the lease of its host, releasing the lease once the host has no runners left, and stops checking the leases once none is left
+   * 
+   * @param[in] runnerId The id of the runner. Nothing is done if it is not leased
+   */
+  __INLINE__ void releaseLeasedRunner(const Runner::runnerId_t runnerId)
+  {
+    _leaseRegistry.release(runnerId);
+    if (_leaseRegistry.empty()) _leaseMonitor.reset();
   }
 
   /**
-   * Attempts to deploy a deployment request. 
+   * [Internal] Handles the failure of a host whose lease expired, respawning its runners that did not complete on spare hosts. Only used by the coordinator
    * 
-   * If not enough (or too many) hosts are detected than the request needs, it will abort execution.
-   * If a good mapping is found, it will run each of the requested instance in one of the found hosts and run its initial function.
+   * The runners are matched to the spare hosts whose topology satisfies the one they requested (or any, if they requested none), one runner per spare host,
+   * so that the runners of the hosts that did not fail are not moved. The respawned runners are started with the batched launch mode, under new leases.
    * 
-   * @param[in] deploymnet A deployment object containing the configuration required to deploy a job
+   * @param[in] instanceId The id of the failed host
    */
-  __INLINE__ void deploy(const Deployment &deployment, const HiCR::Instance::instanceId_t coordinatorInstanceId)
+  __INLINE__ void recoverHost(const HiCR::Instance::instanceId_t instanceId)
   {
-    // Getting this running instance information
-    const auto &currentInstance   = _instanceManager->getCurrentInstance();
-    const auto  currentInstanceId = currentInstance->getId();
+    auto span = _tracer.span("Respawn", "Phase", instanceId);
 
-    // Getting runner set
-    const auto &runners = deployment.getRunners();
-
-    // Remembering if the coordinator is assigned a runner role
-    bool coodinatorIsRunner = false;
-
-    // Gathering required HiCR instances into a set
-    std::set<HiCR::Instance::instanceId_t> instanceIds;
-    for (const auto &runner : runners) instanceIds.insert(runner.getId());
-
-    // Sanity check: make sure there are no repeated instances being used
-    if (runners.size() != instanceIds.size()) HICR_THROW_LOGIC("[DeployR] A repeated HiCR instance was provided.\n");
-
-    // Bifurcation point: this is only run by the non-coordinator instance
-    // they are captured until the coordinator syncs up with them
-    if (currentInstanceId != coordinatorInstanceId)
+    // Taking the runners of the failed host that did not complete. Its launch plan and their payloads are not to be waited for anymore, if still pending
+    _pendingLaunchPlans.erase(instanceId);
+    std::vector<LeaseRegistry::leasedRunner_t> orphans;
+    for (auto &runner : _leaseRegistry.revoke(instanceId))
     {
-      _rpcEngine->listen();
-      return;
+      _pendingPayloads.erase(runner.runnerId);
+      if (runner.handle->isRunning(runner.runnerId)) orphans.push_back(std::move(runner));
     }
 
-    // Gathering accessible instances from the instance manager
-    const auto                                              &instances = _instanceManager->getInstances();
-    std::map<HiCR::Instance::instanceId_t, HiCR::Instance *> instanceMap;
-    for (const auto &instance : instances) instanceMap.insert({instance->getId(), instance.get()});
+    // Matching them to the spare hosts
+    const auto spareInstanceIds = _leaseRegistry.takeSpareHosts(orphans);
 
-    // Sending RPCs to the paired hosts to start deployment
-    for (const auto &runner : runners)
+    // Building the launch plan of the respawned runners, one spare host each, with the topologies they requested
+    std::vector<HiCR::Topology> topologies;
+    for (const auto &orphan : orphans)
+      if (orphan.topology != nullptr) topologies.push_back(*orphan.topology);
+    LaunchPlan launchPlan(_instanceManager->getCurrentInstance()->getId(), topologies, _payloadInlineMaxSize, _isRunnerPinningEnabled, _heartbeatInterval);
+    Deployment::topologyIdx_t topologyCount = 0;
+    for (size_t i = 0; i < orphans.size(); i++)
     {
-      const auto  runnerId      = runner.getId();
-      const auto &initialFcName = runner.getFunction();
-      const auto  instanceId    = runner.getInstanceId();
-
-      // Getting instance corresponding to the provided Id
-      if (instanceMap.contains(instanceId) == false) HICR_THROW_LOGIC("[DeployR] Provided instance id %lu not found in the instance manager provided.\n", instanceId);
-      const auto instance = instanceMap.at(instanceId);
+      const auto runnerId    = orphans[i].runnerId;
+      const auto topologyIdx = orphans[i].topology != nullptr ? topologyCount++ : Deployment::noTopology;
 
-      // If the pairing refers to this host, assign its function name but delay execution
-      if (instanceId == currentInstanceId)
+      // Runners that no spare host can take fail, so that waiting for their deployment does not hang
+      if (spareInstanceIds[i].has_value() == false)
       {
-        coodinatorIsRunner = true;
-        _initialFunction   = initialFcName;
-        _runnerId          = runnerId;
+        orphans[i].handle->setState(runnerId, DeploymentHandle::runnerState_t::failed);
         continue;
       }
 
-      // Sending RPC
-      _rpcEngine->requestRPC(*instance, initialFcName, runnerId);
+      // The runner is sent as it was to its failed host. Payloads not sent inline are served to the spare host again
+      launchPlan.addRunner(*spareInstanceIds[i], runnerId, orphans[i].functionId, orphans[i].payload, topologyIdx);
+      orphans[i].instanceId = *spareInstanceIds[i];
+      grantLease(std::move(orphans[i]));
     }
+    if (_leaseRegistry.empty()) _leaseMonitor.reset();
+    for (const auto &[runnerId, payload] : launchPlan.getServedPayloads()) _pendingPayloads[runnerId] = payload;
 
-    // Running initial function, if one has been assigned to the coordinator
-    if (coodinatorIsRunner) runInitialFunction();
+    // Starting the respawned runners
+    const auto &entries = launchPlan.getEntries();
+    dispatchLaunchPlan(entries, 0, entries.size(), std::max<size_t>(entries.size(), 1));
   }
 
   /**
-   * Registers a function that can be a target as initial function for one or more requested instances.
-   * 
-   * If a requested initial function is not registered by this function, deployment will fail.
+   * [Internal] Gets the id of the runner executed by the calling thread, when several runners share this instance
    * 
-   * @param[in] functionName The name of the function to register. This value will be used to match against the requested instance functions
-   * @param[in] fc The actual function to register
+   * @return A reference to the thread's runner id, if any
+   */
+  [[nodiscard]] __INLINE__ static std::optional<Runner::runnerId_t> &getThreadRunnerId()
+  {
+    static thread_local std::optional<Runner::runnerId_t> threadRunnerId;
+    return threadRunnerId;
+  }
+
+  /**
+   * [Internal] Gets the payload of the runner executed by the calling thread, when several runners share this instance
    * 
+   * @return A reference to the thread's payload, empty if none
    */
-  __INLINE__ void registerFunction(const std::string &functionName, std::function<void()> fc)
+  [[nodiscard]] __INLINE__ static Runner::payload_t &getThreadRunnerPayload()
   {
-    // Checking if the RPC name was already used
-    if (_registeredFunctions.contains(functionName) == true) HICR_THROW_LOGIC("The function '%s' was already registered.", functionName.c_str());
+    static thread_local Runner::payload_t threadRunnerPayload;
+    return threadRunnerPayload;
+  }
 
-    // Adding new RPC to the set
-    _registeredFunctions.insert({functionName, fc});
+  /**
+   * [Internal] Gets the placement of the runner executed by the calling thread, when it is pinned
+   * 
+   * @return A reference to the thread's placement, empty if none
+   */
+  [[nodiscard]] __INLINE__ static ResourcePinner::placement_t &getThreadRunnerPlacement()
+  {
+    static thread_local ResourcePinner::placement_t threadRunnerPlacement;
+    return threadRunnerPlacement;
+  }
 
-    // Adding function to RPC Engine
-    registerRPC(functionName, fc);
+  /**
+   * [Internal] Serializes the local topology as it is sent to the root, including the locality of this instance
+   * 
+   * @return The JSON-encoded local topology
+   */
+  [[nodiscard]] __INLINE__ nlohmann::json serializeLocalTopology() const
+  {
+    auto serializedTopology = _localTopology.serialize();
+    if (_localLocality.empty() == false) serializedTopology[__DEPLOYR_LOCALITY_KEY] = _localLocality;
+    return serializedTopology;
   }
 
   /**
-   * Retrieves the id of the running instance
+   * [Internal] Contents of a reply to a topology request
+   */
+  struct topologyReply_t
+  {
+    /// Fingerprint of the remote topology, as computed by the remote instance. Only set if the topology cache is enabled
+    TopologyCache::fingerprint_t fingerprint = TopologyCache::noFingerprint;
+
+    /// The remote topology. Missing if the topology cache is enabled and the cached topology is still valid
+    std::optional<HiCR::Topology> topology;
+
+    /// The locality of the remote instance. Only meaningful if the topology is present
+    std::string locality;
+  };
+
+  /**
+   * [Internal] Checks a deployment plan against the current request and the topology fingerprints of the participating instances. Only used by the root
    * 
-   * @return The id of the running instance
+   * @param[in] instanceIds The ids of the participating instances
+   * @param[in] plan The plan to check
+   * @param[in] requestFingerprint The fingerprint of the current request
+   * 
+   * @return true, if the plan is valid; false, otherwise
    */
-  [[nodiscard]] __INLINE__ const Runner::runnerId_t getRunnerId() const
+  [[nodiscard]] __INLINE__ bool checkDeploymentPlan(const std::vector<HiCR::Instance::instanceId_t> &instanceIds, const DeploymentPlan &plan, const uint64_t requestFingerprint)
   {
-    // If I am root, I remembered my instance Id
-    if (_instanceManager->getCurrentInstance()->isRootInstance() == true) return _runnerId;
+    const auto  currentInstanceId = _instanceManager->getCurrentInstance()->getId();
+    const auto &fingerprints      = plan.getFingerprints();
+
+    // Checking everything that can be checked locally first, before requesting any fingerprint
+    if (plan.isEmpty() || plan.getRequestFingerprint() != requestFingerprint) return false;
+    const std::unordered_set<HiCR::Instance::instanceId_t> uniqueInstanceIds(instanceIds.begin(), instanceIds.end());
+    if (uniqueInstanceIds.size() != fingerprints.size()) return false;
+    std::vector<HiCR::Instance *> instances;
+    for (const auto instanceId : uniqueInstanceIds)
+    {
+      if (fingerprints.contains(instanceId) == false) return false;
+      if (instanceId == currentInstanceId) continue;
+      const auto instance = getInstance(instanceId);
+      if (instance == nullptr) return false;
+      instances.push_back(instance);
+    }
+    bool isValid = fingerprints.contains(currentInstanceId) == false || fingerprints.at(currentInstanceId) == _localTopologyFingerprint;
+
+    // Requesting all fingerprints up front, and then collecting every reply, even once a mismatch is found, so that none is left behind
+    for (const auto instance : instances) requestRPC(*instance, __DEPLOYR_GET_TOPOLOGY_FINGERPRINT_RPC_NAME);
+    for (const auto instance : instances)
+    {
+      auto                         returnValue = getReturnValue(*instance);
+      TopologyCache::fingerprint_t fingerprint = TopologyCache::noFingerprint;
+      if (returnValue->getSize() == sizeof(fingerprint)) memcpy(&fingerprint, returnValue->getPointer(), sizeof(fingerprint));
+      _rpcEngine->getMemoryManager()->freeLocalMemorySlot(returnValue);
+      isValid &= fingerprint == fingerprints.at(instance->getId());
+    }
 
-    // Otherwise, get it from the RPC engine
-    return _rpcEngine->getRPCArgument();
+    return isValid;
   }
 
   /**
-   * Finalizes the deployment. Must be called by the root instance before exiting the applicataion
+   * [Internal] Requests the topology of a remote instance. If the topology cache is enabled, the remote instance only sends it if the cached one is outdated
+   * 
+   * @param[in] instance The instance to request the topology from
    */
-  __INLINE__ void finalize()
+  __INLINE__ void requestTopology(HiCR::Instance &instance)
   {
-    // Nothing to do here so far
+    if (_isTopologyCacheEnabled == false)
+    {
+      requestRPC(instance, __DEPLOYR_GET_TOPOLOGY_RPC_NAME, _topologyWireFormat);
+      return;
+    }
+
+    const auto knownFingerprint = _topologyCache.getFingerprint(instance.getId());
+    requestRPC(instance, __DEPLOYR_GET_TOPOLOGY_IF_CHANGED_RPC_NAME, (knownFingerprint << 8) | _topologyWireFormat);
   }
 
   /**
-   * Fatally aborts execution. Must be used only in case of unsalvageable errors.
+   * [Internal] Decodes the reply to a topology request. This function does not access the topology cache, so it can run concurrently
+   * 
+   * @param[in] returnValue The memory slot containing the reply
+   * 
+   * @return The decoded reply
    */
-  __INLINE__ void abort() { _instanceManager->abort(-1); }
+  [[nodiscard]] __INLINE__ topologyReply_t parseTopologyReply(const HiCR::LocalMemorySlot &returnValue) const
+  {
+    topologyReply_t reply;
+    const auto      replyJson = WireFormat::decode(returnValue.getPointer(), returnValue.getSize(), _topologyWireFormat);
+
+    // Without cache, the reply is the topology itself
+    if (_isTopologyCacheEnabled == false)
+    {
+      reply.topology.emplace(replyJson);
+      reply.locality = replyJson.value(__DEPLOYR_LOCALITY_KEY, std::string());
+      return reply;
+    }
+
+    // With cache, the reply contains the fingerprint and, if changed, the topology
+    reply.fingerprint = replyJson["Fingerprint"].get<TopologyCache::fingerprint_t>();
+    if (replyJson.contains("Topology"))
+    {
+      reply.topology.emplace(replyJson["Topology"]);
+      reply.locality = replyJson["Topology"].value(__DEPLOYR_LOCALITY_KEY, std::string());
+    }
+    return reply;
+  }
 
   /**
-   * Retrieves the RPC engine for direct use
+   * [Internal] Gets the topology of a remote instance from its decoded reply, updating the topology cache if enabled
    * 
-   * @return A pointer to the internal RPC engine
+   * @param[in] instanceId The id of the remote instance
+   * @param[in] reply The decoded reply
+   * 
+   * @return The topology of the remote instance
    */
-  __INLINE__ HiCR::frontend::RPCEngine *getRPCEngine() { return _rpcEngine; }
+  [[nodiscard]] __INLINE__ HiCR::Topology resolveTopologyReply(const HiCR::Instance::instanceId_t instanceId, topologyReply_t &&reply)
+  {
+    // Remembering the locality sent along with the topology. If the topology was not sent, the locality did not change either
+    if (reply.topology.has_value()) _hostLocalities[instanceId] = reply.locality;
+
+    if (_isTopologyCacheEnabled == false) return std::move(reply.topology.value());
+
+    // If the remote instance sent its topology, the cached one is outdated
+    if (reply.topology.has_value()) _topologyCache.update(instanceId, reply.fingerprint, reply.topology.value());
+
+    // Sanity check: the remote instance should only omit its topology if the cached fingerprint matched
+    if (_topologyCache.getFingerprint(instanceId) != reply.fingerprint) HICR_THROW_RUNTIME("[DeployR] Instance %lu did not send its topology but the cached one is outdated.\n", instanceId);
+
+    return _topologyCache.getTopology(instanceId);
+  }
 
   /**
-   * Retrieves currently running instance
+   * [Internal] Gathers the global topology by sending all requests up front and deserializing the replies on a worker pool while waiting for the rest
    * 
-   * @return The current HiCR instance
+   * @param[in] rootInstanceId The id of the instance that receives the global topology
+   * 
+   * @return A vector containing the local topologies of all instances, in the order given by the instance manager. Empty for non-root instances
    */
-  __INLINE__ HiCR::Instance &getCurrentHiCRInstance() const { return *_instanceManager->getCurrentInstance(); }
+  [[nodiscard]] __INLINE__ std::vector<HiCR::Topology> gatherGlobalTopologyPipelined(const HiCR::Instance::instanceId_t rootInstanceId)
+  {
+    // If I am not root, listen for the incoming RPC
+    if (_instanceManager->getCurrentInstance()->getId() != rootInstanceId)
+    {
+      listen();
+      return {};
+    }
+
+    // Gathering the topologies of all instances
+    std::vector<HiCR::Instance::instanceId_t> instanceIds;
+    for (const auto &instance : _instanceManager->getInstances()) instanceIds.push_back(instance->getId());
+    return gatherTopologies(instanceIds);
+  }
 
   /**
- * Gets the global topology, the sum of all local topologies among the provided instances
- * 
- * @return A vector containing each of the local topologies, where the index corresponds to the host index in the getHiCRInstances function
- */
-  [[nodiscard]] __INLINE__ std::vector<HiCR::Topology> gatherGlobalTopology(const HiCR::Instance::instanceId_t              rootInstanceId,
-                                                                            const std::vector<HiCR::Instance::instanceId_t> instanceIds)
+   * [Internal] Gathers the topologies of the given instances by sending all requests up front and deserializing the replies on a worker pool while waiting for the rest.
+   * Used by the root in the pipelined gather mode, and by the partition coordinators of hierarchical deployments
+   * 
+   * The replies are collected in the order of the given instances, since the RPC engine only waits for the reply of a given instance. A slow instance thus holds back
+   * the collection (but not the parsing already submitted) of the replies after it; only the parsing, not the waiting, overlaps with the communication.
+   * 
+   * @param[in] instanceIds The ids of the instances to gather the topologies of. They may include this instance
+   * 
+   * @return A vector containing the local topologies of the given instances, in the order they were given
+   */
+  [[nodiscard]] __INLINE__ std::vector<HiCR::Topology> gatherTopologies(const std::vector<HiCR::Instance::instanceId_t> &instanceIds)
   {
-    // Storage
-    std::vector<HiCR::Topology> globalTopology;
-    const auto                 &currentInstance = _instanceManager->getCurrentInstance();
-    const bool                  isRootInstance  = currentInstance->getId() == rootInstanceId;
-    const auto                 &instances       = _instanceManager->getInstances();
+    const auto currentInstanceId = _instanceManager->getCurrentInstance()->getId();
 
-    // If I am not root and I am among the participating instances, then listen for the incoming RPC and return an empty topology
-    if (isRootInstance == false) { _rpcEngine->listen(); }
-    else // If I am root, request topology from all instances
+    // Finding the remote instances, before sending any request. This instance is left as nullptr
+    std::vector<HiCR::Instance *> instances(instanceIds.size(), nullptr);
+    for (size_t i = 0; i < instanceIds.size(); i++)
     {
-      for (const auto &instance : instances)
-        if (instance->getId() == currentInstance->getId()) // If its me, just push my local topology
+      if (instanceIds[i] == currentInstanceId) continue;
+      instances[i] = getInstance(instanceIds[i]);
+      if (instances[i] == nullptr) HICR_THROW_LOGIC("[DeployR] Provided instance id %lu not found in the instance manager provided.\n", instanceIds[i]);
+    }
+
+    // Sending all requests before waiting for any reply
+    const auto requestTime = Tracer::now();
+    for (const auto instance : instances)
+      if (instance != nullptr) requestTopology(*instance);
+
+    // Storage for the replies and their deserialized contents
+    std::vector<HiCR::Topology>                          topologies(instances.size());
+    std::vector<topologyReply_t>                         replies(instances.size());
+    std::vector<std::shared_ptr<HiCR::LocalMemorySlot>> returnValues;
+
+    // No need for more parser threads than instances
+    const size_t parserThreadCount = _topologyGatherThreadCount == 0 ? std::thread::hardware_concurrency() : _topologyGatherThreadCount;
+
+    // Deserializing replies in the background while waiting for the next ones, which are collected in request order
+    try
+    {
+      WorkerPool parserPool(std::min(parserThreadCount, instances.size()));
+
+      for (size_t i = 0; i < instances.size(); i++)
+      {
+        // If its me, just place my local topology
+        if (instances[i] == nullptr)
         {
-          globalTopology.push_back(_localTopology.serialize());
+          topologies[i] = _localTopology;
+          continue;
         }
-        else // If not, it's another instance: send RPC and deserialize return value
-        {
-          // Requesting RPC from the remote instance
-          _rpcEngine->requestRPC(*instance, __DEPLOYR_GET_TOPOLOGY_RPC_NAME);
 
-          // Getting return value as a memory slot
-          auto returnValue = _rpcEngine->getReturnValue(*instance);
+        // Getting return value as a memory slot
+        auto returnValue = getReturnValue(*instances[i]);
+        returnValues.push_back(returnValue);
+        _tracer.record("Topology Request", "RPC", requestTime, Tracer::now(), returnValue->getSize(), instances[i]->getId());
 
-          // Receiving raw serialized topology information from the worker
-          std::string serializedTopology = (char *)returnValue->getPointer();
+        // Parsing serialized reply into its place
+        parserPool.submit([this, &replies, returnValue, i, peer = instances[i]->getId()]() {
+          auto span  = _tracer.span("Parse Topology", "Parse", peer);
+          replies[i] = parseTopologyReply(*returnValue);
+        });
+      }
 
-          // Parsing serialized raw topology into a json object
-          auto topologyJson = nlohmann::json::parse(serializedTopology);
+      // Waiting for the deserialization to finish
+      parserPool.wait();
+    }
+    catch (...)
+    {
+      // Freeing the return values received so far before propagating the failure. The parser pool is gone, so none of them is being parsed anymore
+      for (const auto &returnValue : returnValues) _rpcEngine->getMemoryManager()->freeLocalMemorySlot(returnValue);
+      throw;
+    }
 
-          // Freeing return value
-          _rpcEngine->getMemoryManager()->freeLocalMemorySlot(returnValue);
+    // Freeing return values
+    for (const auto &returnValue : returnValues) _rpcEngine->getMemoryManager()->freeLocalMemorySlot(returnValue);
 
-          // Creating new topology object
-          HiCR::Topology topology(topologyJson);
+    // Resolving replies against the topology cache, which is not thread-safe
+    for (size_t i = 0; i < instances.size(); i++)
+      if (instances[i] != nullptr) topologies[i] = resolveTopologyReply(instances[i]->getId(), std::move(replies[i]));
 
-          // Pushing topology into the vector
-          globalTopology.push_back(topology);
-        }
+    return topologies;
+  }
+
+  /**
+   * [Internal] Gathers the global topology through a k-ary tree of instances rooted at the root instance
+   * 
+   * The tree is built over the root followed by the remaining provided instances, in order. The children of the instance at position p are those at positions p*k+1 to p*k+k.
+   * 
+   * @param[in] rootInstanceId The id of the instance that receives the global topology
+   * @param[in] instanceIds The ids of the participating instances
+   * 
+   * @return A vector containing the local topologies of the provided instances, in the order they were provided. Empty for non-root instances
+   */
+  [[nodiscard]] __INLINE__ std::vector<HiCR::Topology> gatherGlobalTopologyTree(const HiCR::Instance::instanceId_t               rootInstanceId,
+                                                                                const std::vector<HiCR::Instance::instanceId_t> &instanceIds)
+  {
+    const auto currentInstanceId = _instanceManager->getCurrentInstance()->getId();
+
+    // Building the tree ordering: the root goes first, followed by the rest of the instances in the order provided
+    _topologyGatherTree.clear();
+    _topologyGatherTree.push_back(rootInstanceId);
+    for (const auto instanceId : instanceIds)
+      if (instanceId != rootInstanceId) _topologyGatherTree.push_back(instanceId);
+
+    // If I am not root, the parent will request my subtree's topologies only if I am participating
+    if (currentInstanceId != rootInstanceId)
+    {
+      if (std::find(instanceIds.begin(), instanceIds.end(), currentInstanceId) != instanceIds.end()) listen();
+      return {};
+    }
+
+    // Gathering the entire tree, starting from the root
+    const auto treeTopologies = gatherSubtreeTopologies(0, _topologyGatherTreeFanout, _topologyWireFormat);
+
+    // Indexing the received topologies by instance id
+    std::map<HiCR::Instance::instanceId_t, const nlohmann::json *> topologyMap;
+    for (const auto &entry : treeTopologies) topologyMap[entry["Instance Id"].get<HiCR::Instance::instanceId_t>()] = &entry["Topology"];
+
+    // Returning the topologies in the order of the provided instance ids
+    std::vector<HiCR::Topology> globalTopology;
+    for (const auto instanceId : instanceIds)
+    {
+      if (topologyMap.contains(instanceId) == false) HICR_THROW_RUNTIME("[DeployR] Did not receive the topology of instance %lu during tree gather.\n", instanceId);
+      globalTopology.push_back(HiCR::Topology(*topologyMap.at(instanceId)));
+      _hostLocalities[instanceId] = topologyMap.at(instanceId)->value(__DEPLOYR_LOCALITY_KEY, std::string());
     }
 
-    // Return global topology
     return globalTopology;
   }
 
   /**
- * Performs a matching between the a set of required topologies and a set of given (existing) topologies and returns, if exists, a possible pairing.
- * 
- * A pairing consists of a 1:1 mapping of the required topologies and the given topologies. For each pairing the given topology is a equal or a superset of the required one.
- * 
- * This implementation uses the Hopcroft-Karp algorithm to find a matching of all requested runners to a host.
- * 
- * @return If successful, a vector of size size(requested) containing the indexes of the given topologies that match the requested ones. Otherwise, an empty vector.
- */
-  [[nodiscard]] __INLINE__ static std::vector<size_t> doBipartiteMatching(const std::vector<HiCR::Topology> &requested, const std::vector<HiCR::Topology> &given)
+   * [Internal] Gathers the topologies of all the instances in the subtree rooted at the given position of the gather tree
+   * 
+   * The requests to all children are issued before waiting for any of their replies, so that the subtrees are gathered in parallel.
+   * 
+   * @param[in] position The position of the subtree root in the gather tree
+   * @param[in] fanout The maximum number of children per instance
+   * @param[in] encoding The encoding to request from the children
+   * 
+   * @return A JSON array containing one entry, with the instance id and its topology, per instance in the subtree
+   */
+  [[nodiscard]] __INLINE__ nlohmann::json gatherSubtreeTopologies(const size_t position, const size_t fanout, const WireFormat::encoding_t encoding)
   {
-    // Creating pairings vector
-    std::vector<size_t> pairingsVector;
+    // Adding my own topology first
+    auto subtreeTopologies = nlohmann::json::array();
+    subtreeTopologies.push_back({{"Instance Id", _topologyGatherTree[position]}, {"Topology", serializeLocalTopology()}});
 
-    // Creating one deployment runner per requested runner
-    for (size_t i = 0; i < requested.size(); i++) pairingsVector.push_back(i);
+    // Finding my children in the tree
+    std::vector<HiCR::Instance *> children;
+    for (size_t childPosition = position * fanout + 1; childPosition <= position * fanout + fanout && childPosition < _topologyGatherTree.size(); childPosition++)
+    {
+      const auto childInstanceId = _topologyGatherTree[childPosition];
+      const auto childInstance   = getInstance(childInstanceId);
+      if (childInstance == nullptr) HICR_THROW_LOGIC("[DeployR] Provided instance id %lu not found in the instance manager provided.\n", childInstanceId);
+      children.push_back(childInstance);
+    }
 
-    // Building the matching graph
-    theAlgorithms::graph::HKGraph graph(pairingsVector.size(), given.size());
-    for (size_t i = 0; i < pairingsVector.size(); i++)
-      for (size_t j = 0; j < given.size(); j++)
-        if (HiCR::Topology::isSubset(given[j], requested[i])) graph.addEdge(i, j);
+    // Requesting all children subtrees at once
+    const auto requestTime = Tracer::now();
+    for (const auto child : children) requestRPC(*child, __DEPLOYR_GATHER_SUBTREE_TOPOLOGY_RPC_NAME, (fanout << 8) | encoding);
 
-    //  Finding out if a proper matching exists
-    auto matchCount = (size_t)graph.hopcroftKarpAlgorithm();
+    // Collecting the children's replies
+    for (const auto child : children)
+    {
+      // Getting return value as a memory slot
+      auto returnValue = getReturnValue(*child);
+      _tracer.record("Subtree Topology Request", "RPC", requestTime, Tracer::now(), returnValue->getSize(), child->getId());
 
-    // If the number of matchings is smaller than requested, return an empty vector
-    if (matchCount < pairingsVector.size()) return {};
+      // Parsing the child's batched reply
+      auto childTopologies = WireFormat::decode(returnValue->getPointer(), returnValue->getSize(), encoding);
 
-    // Getting the pairings from the graph
-    const auto graphPairings = graph.getLeftSidePairings();
-    for (size_t i = 0; i < pairingsVector.size(); i++)
-    {
-      const auto givenIdx = (size_t)graphPairings[i + 1];
-      pairingsVector[i]   = givenIdx;
+      // Freeing return value
+      _rpcEngine->getMemoryManager()->freeLocalMemorySlot(returnValue);
+
+      // Appending the child subtree's topologies to my own
+      for (auto &entry : childTopologies) subtreeTopologies.push_back(std::move(entry));
     }
 
-    return pairingsVector;
+    return subtreeTopologies;
   }
 
-  private:
-
-  __INLINE__ std::shared_ptr<HiCR::Instance> createInstance(const HiCR::InstanceTemplate t)
+  /**
+   * [Internal] Creates a new instance from a template. Failures are thrown as runtime exceptions, so that the caller can roll back
+   * 
+   * @param[in] t The template of the instance to create
+   * 
+   * @return The new instance
+   */
+  __INLINE__ std::shared_ptr<HiCR::Instance> createInstance(const HiCR::InstanceTemplate &t)
   {
     std::shared_ptr<HiCR::Instance> newInstance;
     try
@@ -286,11 +2994,12 @@ class DeployR final
     }
     catch (const std::exception &e)
     {
-      HICR_THROW_FATAL("[DeployR] Failed to create new instance. Reason: \n  + '%s'", e.what());
+      HICR_THROW_RUNTIME("[DeployR] Failed to create new instance. Reason: \n  + '%s'", e.what());
     }
 
-    if (newInstance.get() == nullptr) HICR_THROW_FATAL("Failed to create new instance with requested topology: %s\n", t.getTopology().serialize().dump(2).c_str());
+    if (newInstance.get() == nullptr) HICR_THROW_RUNTIME("[DeployR] Failed to create new instance with requested topology: %s\n", t.getTopology().serialize().dump(2).c_str());
 
+    indexInstance(newInstance);
     return newInstance;
   }
 
@@ -299,17 +3008,39 @@ class DeployR final
  */
   __INLINE__ void runInitialFunction()
   {
-    // Checking the requested function was registered
-    if (_registeredFunctions.contains(_initialFunction) == false)
-      HICR_THROW_FATAL("The requested function name '%s' is not registered. Please register it before initializing DeployR.\n", _initialFunction.c_str());
-
-    // Getting function pointer
-    const auto &initialFc = _registeredFunctions[_initialFunction];
+    // Getting function pointer, checking the requested function was registered
+    const auto &initialFc = getRegisteredFunction(_initialFunctionId);
 
     // Running initial function
     initialFc();
   }
 
+  /**
+   * [Internal] Gets a registered function by its id
+   * 
+   * @param[in] functionId The id of the function, as given by getFunctionId
+   * 
+   * @return The function
+   */
+  [[nodiscard]] __INLINE__ const std::function<void()> &getRegisteredFunction(const functionId_t functionId) const
+  {
+    const auto entry = _registeredFunctions.find(functionId);
+    if (entry == _registeredFunctions.end())
+      HICR_THROW_FATAL("The requested function (id %u) is not registered. Please register it before initializing DeployR.\n", functionId);
+    return entry->second.fc;
+  }
+
+  /**
+   * [Internal] Starts a single runner on this instance, as requested by the coordinator in the serial launch mode
+   * 
+   * @param[in] functionId The id of the initial function of the runner
+   * @param[in] runnerId The id of the runner
+   */
+  __INLINE__ void startRunner(const functionId_t functionId, const Runner::runnerId_t runnerId)
+  {
+    runLocalRunners({{runnerId}, {functionId}, {Runner::payload_t()}, {}, {}});
+  }
+
   /**
   * Registers a function as target for an RPC
   * 
@@ -318,11 +3049,43 @@ class DeployR final
   */
   __INLINE__ void registerRPC(const std::string &RPCName, std::function<void()> fc)
   {
+#ifdef _DEPLOYR_DISTRIBUTED_ENGINE_LOCAL
+    // The local engine runs the function directly on the listening thread
+    _rpcEngine->addRPCTarget(RPCName, fc);
+#else
     // Registering RPC
     auto RPCExecutionUnit = HiCR::backend::pthreads::ComputeManager::createExecutionUnit([fc](void *) { fc(); });
 
     // Adding RPC
     _rpcEngine->addRPCTarget(RPCName, RPCExecutionUnit);
+#endif
+  }
+
+  /**
+   * [Internal] Requests an RPC from an instance. All requests of DeployR go through here, so that the runners on the dedicated execution resources can
+   * send theirs from their own threads (see setRunnerExecutionResourceCount)
+   * 
+   * @param[in] instance The instance to request the RPC from
+   * @param[in] RPCName The name of the RPC
+   * @param[in] argument The argument of the request
+   */
+  __INLINE__ void requestRPC(HiCR::Instance &instance, const std::string &RPCName, const uint64_t argument = 0)
+  {
+    std::unique_lock lock(_rpcRequestMutex);
+    _rpcEngine->requestRPC(instance, RPCName, argument);
+  }
+
+  /**
+   * [Internal] Waits for the return value of the last RPC requested from an instance. It is serialized with the requests, as they are
+   * 
+   * @param[in] instance The instance the RPC was requested from
+   * 
+   * @return The return value
+   */
+  [[nodiscard]] __INLINE__ std::shared_ptr<HiCR::LocalMemorySlot> getReturnValue(HiCR::Instance &instance)
+  {
+    std::unique_lock lock(_rpcRequestMutex);
+    return _rpcEngine->getReturnValue(instance);
   }
 
   /**
@@ -333,23 +3096,158 @@ class DeployR final
   [[nodiscard]] __INLINE__ bool isRootInstance() const { return getCurrentHiCRInstance().getId() == _instanceManager->getRootInstanceId(); }
 
   /// Deployment instance id that this HiCR instance
-  Runner::runnerId_t _runnerId;
+  Runner::runnerId_t _runnerId = 0;
+
+  /// The payload of the runner run on the calling thread, when it is the only runner of this instance
+  Runner::payload_t _runnerPayload;
+
+  /**
+   * [Internal] A function registered as target for an instance's initial function
+   */
+  struct registeredFunction_t
+  {
+    /// The name it was registered with
+    std::string name;
+
+    /// The function itself
+    std::function<void()> fc;
+  };
 
-  /// The initial function this instance needs to run
-  std::string _initialFunction;
+  /// The id of the initial function this instance needs to run
+  functionId_t _initialFunctionId = 0;
 
-  /// A map of registered functions, targets for an instance's initial function
-  std::map<std::string, std::function<void()>> _registeredFunctions;
+  /// The registered functions, indexed by their id
+  std::unordered_map<functionId_t, registeredFunction_t> _registeredFunctions;
 
   // Externally-provided Instance Manager to use
-  HiCR::InstanceManager *const _instanceManager;
+  instanceManager_t *const _instanceManager;
+
+  /// Index of the instances known to the instance manager, by their id (see getInstance)
+  std::unordered_map<HiCR::Instance::instanceId_t, std::shared_ptr<HiCR::Instance>> _instanceIndex;
+
+  /// Number of instances the instance manager had when the index was last synchronized with it
+  size_t _instanceIndexSyncSize = 0;
+
+  /// Protects the instance index, which is also updated while provisioning instances concurrently
+  std::mutex _instanceIndexMutex;
 
   /// The RPC engine to use for all remote function requests
-  HiCR::frontend::RPCEngine *const _rpcEngine;
+  rpcEngine_t *const _rpcEngine;
+
+  /// Records the events of this instance, and those collected from others (see gatherTraces)
+  Tracer _tracer;
 
   /// Storage for the local system topology
   HiCR::Topology _localTopology;
 
+  /// Ordering of the instances in the topology gather tree, with the root instance first
+  std::vector<HiCR::Instance::instanceId_t> _topologyGatherTree;
+
+  /// Maximum number of children per instance in the topology gather tree
+  size_t _topologyGatherTreeFanout = __DEPLOYR_DEFAULT_TOPOLOGY_GATHER_TREE_FANOUT;
+
+  /// Number of worker threads used to deserialize topologies in the pipelined topology gather mode (zero means hardware concurrency)
+  size_t _topologyGatherThreadCount = 0;
+
+  /// Encoding requested from the remote instances when gathering their topologies
+  WireFormat::encoding_t _topologyWireFormat = WireFormat::encoding_t::json;
+
+  /// The verdict on the deployment plan being validated, as sent by the root
+  std::optional<bool> _deploymentPlanVerdict;
+
+  /// Fingerprint of the local topology, sent to the root when the topology cache is in use, or when validating a deployment plan
+  TopologyCache::fingerprint_t _localTopologyFingerprint = TopologyCache::noFingerprint;
+
+  /// Location of this instance in the system hierarchy (e.g., "rack0/switch1/node3")
+  std::string _localLocality;
+
+  /// Locality of each remote instance, as received during the last topology gathers
+  std::map<HiCR::Instance::instanceId_t, std::string> _hostLocalities;
+
+  /// Whether the root uses the topology cache when gathering topologies
+  bool _isTopologyCacheEnabled = false;
+
+  /// Last known topology of each remote instance, used by the root
+  TopologyCache _topologyCache;
+
+  /// Maximum number of children per instance in the launch tree
+  size_t _launchTreeFanout = __DEPLOYR_DEFAULT_LAUNCH_TREE_FANOUT;
+
+  /// Whether the runners of the deployments launched by this instance are pinned to the resources of their hosts
+  bool _isRunnerPinningEnabled = false;
+
+  /// Largest runner payload sent inline in the launch plan
+  size_t _payloadInlineMaxSize = __DEPLOYR_DEFAULT_PAYLOAD_INLINE_MAX_SIZE;
+
+  /// Payloads not sent inline of the remote runners launched by this instance, kept until their hosts request them or the runners complete
+  std::unordered_map<Runner::runnerId_t, Runner::payload_t> _pendingPayloads;
+
+  /// Launch plans of the children of this instance in the launch tree, kept until each child requests its own
+  std::map<HiCR::Instance::instanceId_t, nlohmann::json> _pendingLaunchPlans;
+
+  /// Shares of the runners of the hierarchical deployment launched by this instance as global coordinator, by partition coordinator id, kept until each requests its own
+  std::map<HiCR::Instance::instanceId_t, PartitionShare> _pendingPartitionShares;
+
+  /// Runners of each partition of the hierarchical deployment launched by this instance as global coordinator, by partition coordinator id, until the partition reports them
+  std::map<HiCR::Instance::instanceId_t, std::vector<Runner::runnerId_t>> _partitionRunnerIds;
+
+  /// Summary of the hosts of the partition coordinated by this instance, kept until the global coordinator requests it
+  std::optional<nlohmann::json> _pendingPartitionSummary;
+
+  /// Report of the completion of the partition coordinated by this instance, kept until the global coordinator requests it
+  std::optional<nlohmann::json> _pendingPartitionReport;
+
+  /// Time between the heartbeats of the hosts, or zero if leases are disabled
+  std::chrono::nanoseconds _heartbeatInterval = std::chrono::nanoseconds(0);
+
+  /// Time without heartbeats after which a host is considered failed
+  std::chrono::nanoseconds _leaseDuration = std::chrono::nanoseconds(0);
+
+  /// The leases held by this instance as coordinator, and the spare hosts to respawn the runners of failed hosts on
+  LeaseRegistry _leaseRegistry;
+
+  /// Statistics of the last deployment launched by this instance as coordinator
+  launchStatistics_t _launchStatistics{};
+
+  /// Coordinator of the last deployment this instance took part in, which its runners report their completion to
+  HiCR::Instance::instanceId_t _coordinatorInstanceId = 0;
+
+  /// Deployments launched by this instance as coordinator, until finalized
+  std::vector<std::shared_ptr<DeploymentHandle>> _activeDeployments;
+
+  /// Whether this instance is serving requests, until a shutdown request arrives
+  std::atomic<bool> _isServing = false;
+
+  /// Whether this instance, as a host of a hierarchical deployment, still awaits the start command or the release of its partition coordinator
+  bool _isAwaitingPartitionStart = false;
+
+  /// Serializes the RPC requests of the listening thread, the runner threads and the heartbeat threads
+  std::mutex _rpcRequestMutex;
+
+  /// Protects the state shared with the runner threads: the payload memory slots they release, and the leased runners among them
+  std::mutex _runnerReportMutex;
+
+  /// Compute manager for the processing units dedicated to running runners
+  HiCR::backend::pthreads::ComputeManager _runnerExecutionComputeManager;
+
+  /// Workers running runners on dedicated compute resources while serving, if any. Declared after their compute manager, so that they are destroyed first
+  std::unique_ptr<WorkerPool> _runnerExecutionPool;
+
+  /// Memory slots of the received payloads that their runners are done with, until the listening thread frees them
+  std::vector<std::shared_ptr<HiCR::LocalMemorySlot>> _releasedPayloadSlots;
+
+  /// Runners handed over to the dedicated execution resources that the coordinator holds a lease for, until they complete
+  std::unordered_set<Runner::runnerId_t> _leasedOffloadedRunnerIds;
+
+  /// Whether a lease check was requested by the lease monitor and not served yet
+  std::atomic<bool> _isLeaseCheckPending = false;
+
+  /// Requests the periodic lease checks, while any lease is held. Declared after what it uses, so that it is stopped first
+  std::unique_ptr<Heartbeat> _leaseMonitor;
+
+  /// Sends the heartbeats for the leased runners on the dedicated execution resources, while serving. Declared after what it uses, so that it is stopped first
+  std::unique_ptr<Heartbeat> _offloadedRunnerHeartbeat;
+
 }; // class DeployR
 
 } // namespace deployr
\ No newline at end of file
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <vector>
+
+namespace deployr
+{
+
+/**
+ * A directed flow network with integer capacities and costs, used to solve class-level assignment (transportation) problems.
+ *
+ * The maximum flow is computed with Dinic's algorithm, and the minimum-cost maximum flow by successive shortest paths (Dijkstra with potentials).
+ * It is intended for small networks (e.g., one vertex per equivalence class of runners and hosts), where large capacities do not affect the running time.
+ */
+class FlowNetwork final
+{
+  public:
+
+  /// Type for edge capacities and flows
+  typedef int64_t capacity_t;
+
+  /// Type for edge costs
+  typedef int64_t cost_t;
+
+  /// Capacity value to use for edges without a capacity limit
+  static constexpr capacity_t unlimited = std::numeric_limits<capacity_t>::max() / 4;
+
+  FlowNetwork() = delete;
+
+  /**
+   * Constructor for the flow network
+   *
+   * @param[in] vertexCount The number of vertices in the network. They are identified by indexes in [0, vertexCount)
+   */
+  FlowNetwork(const size_t vertexCount)
+    : _adjacency(vertexCount)
+  {}
+
+  ~FlowNetwork() = default;
+
+  /**
+   * Adds a directed edge to the network
+   *
+   * @param[in] from The source vertex of the edge
+   * @param[in] to The destination vertex of the edge
+   * @param[in] capacity The maximum flow the edge can carry
+   * @param[in] cost The cost per unit of flow through the edge. Must not be negative. Only used by computeMinCostMaxFlow
+   *
+   * @return An identifier for the edge, to retrieve its flow later
+   */
+  __INLINE__ size_t addEdge(const size_t from, const size_t to, const capacity_t capacity, const cost_t cost = 0)
+  {
+    if (cost < 0) HICR_THROW_LOGIC("[DeployR] Flow network edge (%lu, %lu) has a negative cost (%ld).\n", from, to, cost);
+    if (from >= _adjacency.size() || to >= _adjacency.size()) HICR_THROW_LOGIC("[DeployR] Flow network edge (%lu, %lu) out of bounds (%lu vertices).\n", from, to, _adjacency.size());
+
+    // Each edge is stored next to its residual (reverse) edge, so that edge ^ 1 gives one from the other
+    const size_t edgeId = _edges.size();
+    _edges.push_back({to, capacity, 0, cost});
+    _edges.push_back({from, 0, 0, -cost});
+    _adjacency[from].push_back(edgeId);
+    _adjacency[to].push_back(edgeId + 1);
+
+    return edgeId;
+  }
+
+  /**
+   * Computes the maximum flow between two vertices. The flow of each edge can be retrieved afterwards with getFlow
+   *
+   * @param[in] source The source vertex
+   * @param[in] sink The sink vertex
+   *
+   * @return The value of the maximum flow
+   */
+  __INLINE__ capacity_t computeMaxFlow(const size_t source, const size_t sink)
+  {
+    capacity_t totalFlow = 0;
+
+    // Augmenting along shortest paths while the sink is reachable in the residual network
+    while (buildLevels(source, sink))
+    {
+      std::vector<size_t> nextEdge(_adjacency.size(), 0);
+      while (const auto flow = augment(source, sink, nextEdge)) totalFlow += flow;
+    }
+
+    return totalFlow;
+  }
+
+  /**
+   * Computes, among all maximum flows between two vertices, one of minimum total cost. The flow of each edge can be retrieved afterwards with getFlow
+   *
+   * @param[in] source The source vertex
+   * @param[in] sink The sink vertex
+   *
+   * @return The value of the maximum flow. Its cost can be retrieved with getTotalCost
+   */
+  __INLINE__ capacity_t computeMinCostMaxFlow(const size_t source, const size_t sink)
+  {
+    constexpr cost_t unreachable = std::numeric_limits<cost_t>::max();
+
+    capacity_t          totalFlow = 0;
+    std::vector<cost_t> potentials(_adjacency.size(), 0);
+    std::vector<cost_t> distances(_adjacency.size());
+    std::vector<size_t> parentEdge(_adjacency.size());
+    _totalCost = 0;
+
+    while (true)
+    {
+      // Finding the cheapest residual path with Dijkstra over reduced costs, which the potentials keep non-negative
+      std::fill(distances.begin(), distances.end(), unreachable);
+      distances[source] = 0;
+
+      typedef std::pair<cost_t, size_t>                                                      queueEntry_t;
+      std::priority_queue<queueEntry_t, std::vector<queueEntry_t>, std::greater<queueEntry_t>> queue;
+      queue.push({0, source});
+      while (queue.empty() == false)
+      {
+        const auto [distance, vertex] = queue.top();
+        queue.pop();
+        if (distance > distances[vertex]) continue;
+
+        for (const auto edgeId : _adjacency[vertex])
+        {
+          const auto &edge = _edges[edgeId];
+          if (edge.flow >= edge.capacity) continue;
+
+          const auto newDistance = distance + edge.cost + potentials[vertex] - potentials[edge.to];
+          if (newDistance < distances[edge.to])
+          {
+            distances[edge.to]  = newDistance;
+            parentEdge[edge.to] = edgeId;
+            queue.push({newDistance, edge.to});
+          }
+        }
+      }
+
+      // If the sink is not reachable anymore, the flow is maximum
+      if (distances[sink] == unreachable) break;
+
+      // Updating potentials with the new distances
+      for (size_t vertex = 0; vertex < _adjacency.size(); vertex++)
+        if (distances[vertex] != unreachable) potentials[vertex] += distances[vertex];
+
+      // Finding the bottleneck of the path and pushing that much flow through it
+      capacity_t flow = unlimited;
+      for (size_t vertex = sink; vertex != source; vertex = _edges[parentEdge[vertex] ^ 1].to)
+        flow = std::min(flow, _edges[parentEdge[vertex]].capacity - _edges[parentEdge[vertex]].flow);
+      for (size_t vertex = sink; vertex != source; vertex = _edges[parentEdge[vertex] ^ 1].to)
+      {
+        _edges[parentEdge[vertex]].flow += flow;
+        _edges[parentEdge[vertex] ^ 1].flow -= flow;
+        _totalCost += flow * _edges[parentEdge[vertex]].cost;
+      }
+
+      totalFlow += flow;
+    }
+
+    return totalFlow;
+  }
+
+  /**
+   * Gets the total cost of the flow computed by the last call to computeMinCostMaxFlow
+   *
+   * @return The sum, over all edges, of their flow times their cost
+   */
+  [[nodiscard]] __INLINE__ cost_t getTotalCost() const { return _totalCost; }
+
+  /**
+   * Gets the flow assigned to an edge by the last call to computeMaxFlow or computeMinCostMaxFlow
+   *
+   * @param[in] edgeId The edge identifier, as returned by addEdge
+   *
+   * @return The flow through the edge
+   */
+  [[nodiscard]] __INLINE__ capacity_t getFlow(const size_t edgeId) const { return _edges[edgeId].flow; }
+
+  private:
+
+  /**
+   * [Internal] An edge of the network
+   */
+  struct edge_t
+  {
+    /// Destination vertex
+    size_t to;
+
+    /// Maximum flow
+    capacity_t capacity;
+
+    /// Current flow
+    capacity_t flow;
+
+    /// Cost per unit of flow
+    cost_t cost;
+  };
+
+  /**
+   * [Internal] Computes the BFS level of every vertex in the residual network
+   *
+   * @param[in] source The source vertex
+   * @param[in] sink The sink vertex
+   *
+   * @return true, if the sink is reachable from the source; false, otherwise
+   */
+  __INLINE__ bool buildLevels(const size_t source, const size_t sink)
+  {
+    _levels.assign(_adjacency.size(), -1);
+    _levels[source] = 0;
+
+    std::queue<size_t> queue;
+    queue.push(source);
+    while (queue.empty() == false)
+    {
+      const auto vertex = queue.front();
+      queue.pop();
+      for (const auto edgeId : _adjacency[vertex])
+      {
+        const auto &edge = _edges[edgeId];
+        if (_levels[edge.to] < 0 && edge.flow < edge.capacity)
+        {
+          _levels[edge.to] = _levels[vertex] + 1;
+          queue.push(edge.to);
+        }
+      }
+    }
+
+    return _levels[sink] >= 0;
+  }
+
+  /**
+   * [Internal] Pushes flow along one path of increasing levels from the source to the sink.
+   *
+   * The path is searched iteratively, so that long paths cannot overflow the call stack.
+   *
+   * @param[in] source The source vertex
+   * @param[in] sink The sink vertex
+   * @param[in,out] nextEdge The next edge to explore for each vertex, so that saturated edges and dead ends are not explored again
+   *
+   * @return The flow pushed, or zero if the sink cannot be reached anymore in this phase
+   */
+  __INLINE__ capacity_t augment(const size_t source, const size_t sink, std::vector<size_t> &nextEdge)
+  {
+    std::vector<size_t> path;
+    size_t              vertex = source;
+
+    while (vertex != sink)
+    {
+      // Advancing through the next admissible edge, if any
+      bool advanced = false;
+      for (; nextEdge[vertex] < _adjacency[vertex].size(); nextEdge[vertex]++)
+      {
+        const auto  edgeId = _adjacency[vertex][nextEdge[vertex]];
+        const auto &edge   = _edges[edgeId];
+        if (_levels[edge.to] != _levels[vertex] + 1 || edge.flow >= edge.capacity) continue;
+
+        path.push_back(edgeId);
+        vertex   = edge.to;
+        advanced = true;
+        break;
+      }
+      if (advanced) continue;
+
+      // Dead end: if at the source, there are no more paths in this phase
+      if (path.empty()) return 0;
+
+      // Otherwise, retreating to the previous vertex and skipping the edge that led here
+      vertex = _edges[path.back() ^ 1].to;
+      path.pop_back();
+      nextEdge[vertex]++;
+    }
+
+    // Finding the bottleneck of the path and pushing that much flow through it
+    capacity_t flow = unlimited;
+    for (const auto edgeId : path) flow = std::min(flow, _edges[edgeId].capacity - _edges[edgeId].flow);
+    for (const auto edgeId : path)
+    {
+      _edges[edgeId].flow += flow;
+      _edges[edgeId ^ 1].flow -= flow;
+    }
+
+    return flow;
+  }
+
+  /// All edges, each followed by its residual edge
+  std::vector<edge_t> _edges;
+
+  /// Outgoing edges (including residual ones) of each vertex
+  std::vector<std::vector<size_t>> _adjacency;
+
+  /// BFS level of each vertex in the current phase
+  std::vector<int64_t> _levels;
+
+  /// Total cost of the last minimum-cost flow computed
+  cost_t _totalCost = 0;
+
+}; // class FlowNetwork
+
+} // namespace deployr
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace deployr
+{
+
+/**
+ * Calls a function at a fixed interval on a background thread, from its construction until its destruction. The first call happens right away.
+ *
+ * DeployR uses it on the hosts, to send heartbeats to the coordinator while the runners on their dedicated execution resources run, and on the coordinator,
+ * to request the periodic checks of the leases from itself. It only sends requests, through the lock DeployR serializes its requests with.
+ */
+class Heartbeat final
+{
+  public:
+
+  Heartbeat() = delete;
+
+  /**
+   * Constructor for the heartbeat, which starts the background thread
+   *
+   * @param[in] interval The time between the start of consecutive calls
+   * @param[in] fc The function to call. If it throws, the heartbeat stops, as if its instance had failed
+   */
+  Heartbeat(const std::chrono::nanoseconds interval, std::function<void()> fc)
+    : _interval(interval),
+      _fc(std::move(fc)),
+      _thread([this]() { beat(); })
+  {}
+
+  /**
+   * The destructor stops the background thread, waiting for the current call to finish, if any
+   */
+  ~Heartbeat()
+  {
+    {
+      std::unique_lock lock(_mutex);
+      _isStopping = true;
+    }
+    _stopRequested.notify_all();
+    _thread.join();
+  }
+
+  private:
+
+  /**
+   * [Internal] Calls the function at every interval until stopped. Run by the background thread
+   */
+  __INLINE__ void beat()
+  {
+    auto             nextBeatTime = std::chrono::steady_clock::now();
+    std::unique_lock lock(_mutex);
+    while (_isStopping == false)
+    {
+      lock.unlock();
+      try
+      {
+        _fc();
+      }
+      catch (...)
+      {
+        return;
+      }
+      lock.lock();
+
+      nextBeatTime += _interval;
+      _stopRequested.wait_until(lock, nextBeatTime, [this]() { return _isStopping; });
+    }
+  }
+
+  /// The time between the start of consecutive calls
+  const std::chrono::nanoseconds _interval;
+
+  /// The function to call
+  const std::function<void()> _fc;
+
+  /// Protects the stop flag
+  std::mutex _mutex;
+
+  /// Notified when the heartbeat is to stop
+  std::condition_variable _stopRequested;
+
+  /// Whether the heartbeat is to stop
+  bool _isStopping = false;
+
+  /// The background thread. Declared last, so that it starts once everything else is initialized
+  std::thread _thread;
+
+}; // class Heartbeat
+
+} // namespace deployr
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/topology.hpp>
+#include <limits>
+#include <vector>
+#include "bipartiteMatcher.hpp"
+#include "deployr.hpp"
+
+namespace deployr
+{
+
+/**
+ * Keeps a matching of runners to hosts, along with its compatibility graph, and repairs it as hosts leave or join, for elastic deployments.
+ *
+ * The initial matching is computed as in DeployR::doBipartiteMatching. Afterwards, removing or adding a host does not recompute the matching from scratch:
+ * a single breadth-first search for an augmenting path, starting from the affected vertex, restores a maximum matching, and only the runners whose host changed are reported.
+ * Since the path found is a shortest one, as few runners as possible are moved. Adding a host only checks its compatibility with each runner, rather than rebuilding the whole graph.
+ *
+ * Hosts are referred to by their index: the initial hosts take their position in the given topologies, and each added host takes the next index. Removed hosts keep their index, which is never reused.
+ */
+class IncrementalMatcher final
+{
+  public:
+
+  /// Represents the absence of a host (e.g., for a runner that could not be assigned)
+  static constexpr size_t noHost = std::numeric_limits<size_t>::max();
+
+  /**
+   * A change in the host assigned to a runner
+   */
+  struct assignment_t
+  {
+    /// The index of the runner
+    size_t runnerIdx;
+
+    /// The index of its new host, or noHost if it could not be reassigned
+    size_t hostIdx;
+  };
+
+  IncrementalMatcher() = delete;
+
+  /**
+   * Constructor for the matcher, which computes the initial matching
+   *
+   * @param[in] requested The topologies requested by the runners
+   * @param[in] given The topologies of the initial hosts
+   * @param[in] threadCount The number of threads used to build the compatibility graph. Zero means using the hardware concurrency of the system
+   */
+  IncrementalMatcher(const std::vector<HiCR::Topology> &requested, const std::vector<HiCR::Topology> &given, const size_t threadCount = 0)
+    : _requested(requested),
+      _runnerHosts(DeployR::buildCompatibilityGraph(requested, given, threadCount)),
+      _hostRunners(given.size()),
+      _isHostActive(given.size(), true),
+      _leftPairs(requested.size(), noHost),
+      _rightPairs(given.size(), noHost),
+      _runnerVisits(requested.size(), 0),
+      _hostVisits(given.size(), 0),
+      _parents(std::max(requested.size(), given.size()), noHost)
+  {
+    // Keeping the hosts compatible with each runner, and the runners compatible with each host
+    for (size_t runnerIdx = 0; runnerIdx < _runnerHosts.size(); runnerIdx++)
+      for (const auto hostIdx : _runnerHosts[runnerIdx]) _hostRunners[hostIdx].push_back(runnerIdx);
+
+    // Computing the initial matching
+    BipartiteMatcher matcher;
+    matcher.loadGraph(_runnerHosts, given.size());
+    matcher.computeMaximumMatching();
+
+    const auto &pairings = matcher.getLeftPairings();
+    for (size_t runnerIdx = 0; runnerIdx < pairings.size(); runnerIdx++)
+      if (pairings[runnerIdx] != BipartiteMatcher::NIL) assign(runnerIdx, pairings[runnerIdx]);
+  }
+
+  ~IncrementalMatcher() = default;
+
+  /**
+   * Gets the host assigned to each runner
+   *
+   * @return A vector of size size(requested), containing the host index assigned to each runner, or noHost
+   */
+  [[nodiscard]] __INLINE__ const std::vector<size_t> &getMatching() const { return _leftPairs; }
+
+  /**
+   * Indicates whether every runner is assigned to a host
+   *
+   * @return true, if the matching is complete; false, otherwise
+   */
+  [[nodiscard]] __INLINE__ bool isComplete() const { return _assignedCount == _leftPairs.size(); }
+
+  /**
+   * Gets the number of hosts ever known to the matcher, including removed ones
+   *
+   * @return The number of hosts
+   */
+  [[nodiscard]] __INLINE__ size_t getHostCount() const { return _isHostActive.size(); }
+
+  /**
+   * Indicates whether a host is available (it was not removed)
+   *
+   * @param[in] hostIdx The index of the host
+   *
+   * @return true, if the host is available; false, otherwise
+   */
+  [[nodiscard]] __INLINE__ bool isHostActive(const size_t hostIdx) const { return hostIdx < _isHostActive.size() && _isHostActive[hostIdx]; }
+
+  /**
+   * Removes a host. If a runner was assigned to it, the matching is repaired by moving it (and possibly others) to the remaining hosts
+   *
+   * @param[in] hostIdx The index of the host to remove
+   *
+   * @return The runners whose host changed. If the displaced runner could not be reassigned, it is reported with noHost
+   */
+  [[nodiscard]] __INLINE__ std::vector<assignment_t> removeHost(const size_t hostIdx)
+  {
+    if (isHostActive(hostIdx) == false) HICR_THROW_LOGIC("[DeployR] Host %lu cannot be removed from the matching, since it is not active.\n", hostIdx);
+    _isHostActive[hostIdx] = false;
+
+    // Nothing to repair if the host was not in use
+    const auto runnerIdx = _rightPairs[hostIdx];
+    if (runnerIdx == noHost) return {};
+    unassign(runnerIdx);
+
+    // Looking for another host for the displaced runner
+    std::vector<assignment_t> changes;
+    if (augmentFromRunner(runnerIdx, changes) == false) changes.push_back({runnerIdx, noHost});
+    return changes;
+  }
+
+  /**
+   * Adds a host. If any runner is not assigned, the matching is repaired by giving the new host to one of them, possibly moving others
+   *
+   * @param[in] topology The topology of the new host, whose index is the previous getHostCount
+   *
+   * @return The runners whose host changed
+   */
+  [[nodiscard]] __INLINE__ std::vector<assignment_t> addHost(const HiCR::Topology &topology)
+  {
+    const auto hostIdx = _isHostActive.size();
+
+    // Checking the compatibility of the new host with each runner
+    _hostRunners.emplace_back();
+    for (size_t runnerIdx = 0; runnerIdx < _requested.size(); runnerIdx++)
+      if (HiCR::Topology::isSubset(topology, _requested[runnerIdx]))
+      {
+        _runnerHosts[runnerIdx].push_back(hostIdx);
+        _hostRunners[hostIdx].push_back(runnerIdx);
+      }
+
+    _isHostActive.push_back(true);
+    _rightPairs.push_back(noHost);
+    _hostVisits.push_back(0);
+    if (_parents.size() < _isHostActive.size()) _parents.resize(_isHostActive.size(), noHost);
+
+    // A complete matching cannot be improved
+    std::vector<assignment_t> changes;
+    if (isComplete() == false) augmentFromHost(hostIdx, changes);
+    return changes;
+  }
+
+  private:
+
+  /**
+   * [Internal] Pairs a runner with a host
+   *
+   * @param[in] runnerIdx The runner
+   * @param[in] hostIdx The host
+   */
+  __INLINE__ void assign(const size_t runnerIdx, const size_t hostIdx)
+  {
+    if (_leftPairs[runnerIdx] == noHost) _assignedCount++;
+    _leftPairs[runnerIdx] = hostIdx;
+    _rightPairs[hostIdx]  = runnerIdx;
+  }
+
+  /**
+   * [Internal] Unpairs a runner from its host
+   *
+   * @param[in] runnerIdx The runner
+   */
+  __INLINE__ void unassign(const size_t runnerIdx)
+  {
+    _rightPairs[_leftPairs[runnerIdx]] = noHost;
+    _leftPairs[runnerIdx]              = noHost;
+    _assignedCount--;
+  }
+
+  /**
+   * [Internal] Breadth-first search for a shortest augmenting path from an unassigned runner to a free active host. If one is found, the matching is flipped along it
+   *
+   * @param[in] rootRunnerIdx The unassigned runner to start from
+   * @param[out] changes The runners whose host changed are appended to it
+   *
+   * @return true, if an augmenting path was found; false, otherwise
+   */
+  __INLINE__ bool augmentFromRunner(const size_t rootRunnerIdx, std::vector<assignment_t> &changes)
+  {
+    _searchEpoch++;
+    _queue.clear();
+    _queue.push_back(rootRunnerIdx);
+    _runnerVisits[rootRunnerIdx] = _searchEpoch;
+
+    // Here, the parent of a host is the runner it was reached from, which would move onto it
+    for (size_t head = 0; head < _queue.size(); head++)
+    {
+      const auto runnerIdx = _queue[head];
+      for (const auto hostIdx : _runnerHosts[runnerIdx])
+      {
+        if (_isHostActive[hostIdx] == false || _hostVisits[hostIdx] == _searchEpoch) continue;
+        _hostVisits[hostIdx] = _searchEpoch;
+        _parents[hostIdx]    = runnerIdx;
+
+        // Found a free host: moving each runner on the path onto the host it reached
+        const auto ownerIdx = _rightPairs[hostIdx];
+        if (ownerIdx == noHost)
+        {
+          for (auto freeHostIdx = hostIdx; freeHostIdx != noHost;)
+          {
+            const auto movingRunnerIdx = _parents[freeHostIdx];
+            const auto previousHostIdx = _leftPairs[movingRunnerIdx];
+            if (previousHostIdx != noHost) unassign(movingRunnerIdx);
+            assign(movingRunnerIdx, freeHostIdx);
+            changes.push_back({movingRunnerIdx, freeHostIdx});
+            freeHostIdx = previousHostIdx;
+          }
+          return true;
+        }
+
+        // Otherwise, its current runner would have to move elsewhere
+        if (_runnerVisits[ownerIdx] != _searchEpoch)
+        {
+          _runnerVisits[ownerIdx] = _searchEpoch;
+          _queue.push_back(ownerIdx);
+        }
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * [Internal] Breadth-first search for a shortest augmenting path from a free host to an unassigned runner. If one is found, the matching is flipped along it
+   *
+   * @param[in] rootHostIdx The free host to start from
+   * @param[out] changes The runners whose host changed are appended to it
+   *
+   * @return true, if an augmenting path was found; false, otherwise
+   */
+  __INLINE__ bool augmentFromHost(const size_t rootHostIdx, std::vector<assignment_t> &changes)
+  {
+    _searchEpoch++;
+    _queue.clear();
+    _queue.push_back(rootHostIdx);
+    _hostVisits[rootHostIdx] = _searchEpoch;
+
+    // Here, the parent of a runner is the host it was reached from, which it would move onto
+    for (size_t head = 0; head < _queue.size(); head++)
+    {
+      const auto hostIdx = _queue[head];
+      for (const auto runnerIdx : _hostRunners[hostIdx])
+      {
+        if (_runnerVisits[runnerIdx] == _searchEpoch) continue;
+        _runnerVisits[runnerIdx] = _searchEpoch;
+        _parents[runnerIdx]      = hostIdx;
+
+        // Found an unassigned runner: moving each runner on the path onto the host it was reached from
+        if (_leftPairs[runnerIdx] == noHost)
+        {
+          for (auto movingRunnerIdx = runnerIdx; movingRunnerIdx != noHost;)
+          {
+            // The moving runner is unassigned at this point: either the one found, or one displaced in the previous step
+            const auto targetHostIdx = _parents[movingRunnerIdx];
+            const auto displacedIdx  = _rightPairs[targetHostIdx];
+            if (displacedIdx != noHost) unassign(displacedIdx);
+            assign(movingRunnerIdx, targetHostIdx);
+            changes.push_back({movingRunnerIdx, targetHostIdx});
+            movingRunnerIdx = displacedIdx;
+          }
+          return true;
+        }
+
+        // Otherwise, the host it frees by moving could take another runner
+        const auto freedHostIdx = _leftPairs[runnerIdx];
+        if (_hostVisits[freedHostIdx] != _searchEpoch)
+        {
+          _hostVisits[freedHostIdx] = _searchEpoch;
+          _queue.push_back(freedHostIdx);
+        }
+      }
+    }
+
+    return false;
+  }
+
+  /// The topologies requested by the runners, to check the compatibility of added hosts
+  const std::vector<HiCR::Topology> _requested;
+
+  /// The hosts compatible with each runner, including removed ones
+  std::vector<std::vector<size_t>> _runnerHosts;
+
+  /// The runners compatible with each host
+  std::vector<std::vector<size_t>> _hostRunners;
+
+  /// Whether each host is available
+  std::vector<bool> _isHostActive;
+
+  /// The host assigned to each runner, or noHost
+  std::vector<size_t> _leftPairs;
+
+  /// The runner assigned to each host, or noHost
+  std::vector<size_t> _rightPairs;
+
+  /// Number of runners assigned to a host
+  size_t _assignedCount = 0;
+
+  /// Search in which each runner was last visited, so that visits need not be cleared between searches
+  std::vector<size_t> _runnerVisits;
+
+  /// Search in which each host was last visited
+  std::vector<size_t> _hostVisits;
+
+  /// The vertex each vertex was reached from in the last search. Runners and hosts share it, since a search only records parents of one side
+  std::vector<size_t> _parents;
+
+  /// The current search
+  size_t _searchEpoch = 0;
+
+  /// BFS queue
+  std::vector<size_t> _queue;
+
+}; // class IncrementalMatcher
+
+} // namespace deployr
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/instance.hpp>
+#include <hicr/core/topology.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "bipartiteMatcher.hpp"
+#include "deployr.hpp"
+
+namespace deployr
+{
+
+/**
+ * Keeps a set of pre-created (warm) instances ready to be handed out to deployments, so that their creation latency is not paid when a job starts.
+ *
+ * The pool is described by one topology per warm slot. Each slot holds at most one idle instance created from that topology, which is also the topology the instance is matched by.
+ * A deployment acquires instances for its requested topologies: those that fit an idle instance are drawn from the pool, and only the remainder are created on demand.
+ * Slots emptied by acquisitions stay empty until the next call to fill, which the caller can make off its critical path (e.g., while the deployment runs). Releasing
+ * instances back to the pool terminates them and fills the empty slots.
+ *
+ * Instances are created and terminated through DeployR::provisionInstances and DeployR::terminateInstances, always on the calling thread and while holding the
+ * pool's lock, so that the slots are never updated concurrently and the pool never calls the instance manager from a thread of its own.
+ */
+class InstancePool final
+{
+  public:
+
+  InstancePool() = delete;
+
+  /**
+   * Constructor for the instance pool. It does not create any instance until fill is called
+   *
+   * @param[in] deployr The DeployR object used to create and terminate instances
+   * @param[in] warmTopologies The topology of each warm slot
+   * @param[in] maxConcurrency The maximum number of instances being created or terminated at the same time
+   */
+  InstancePool(DeployR &deployr, const std::vector<HiCR::Topology> &warmTopologies, const size_t maxConcurrency = __DEPLOYR_DEFAULT_PROVISIONING_CONCURRENCY)
+    : _deployr(deployr),
+      _warmTopologies(warmTopologies),
+      _maxConcurrency(maxConcurrency),
+      _slots(warmTopologies.size())
+  {}
+
+  /**
+   * The destructor keeps idle instances alive; use drain to terminate them
+   */
+  ~InstancePool() = default;
+
+  /**
+   * Creates the instances of all empty slots, and waits for them to be ready. If their creation fails, the slots are left empty and the exception is re-thrown
+   */
+  __INLINE__ void fill()
+  {
+    std::unique_lock lock(_mutex);
+    fillSlots();
+  }
+
+  /**
+   * Gets instances for a set of requested topologies. Idle instances that fit the requests are drawn from the pool, and the rest are created on demand.
+   * The slots drawn from stay empty until the next call to fill. If the creation of the remaining instances fails, the drawn instances are returned to their slots
+   *
+   * @param[in] requestedTopologies The topologies requested, usually one per runner of a deployment
+   *
+   * @return The instances assigned to each requested topology, in the same order
+   */
+  [[nodiscard]] __INLINE__ std::vector<std::shared_ptr<HiCR::Instance>> acquire(const std::vector<HiCR::Topology> &requestedTopologies)
+  {
+    // The lock is held until the drawn instances are either handed out or back in their slots
+    std::unique_lock lock(_mutex);
+
+    std::vector<std::shared_ptr<HiCR::Instance>> instances(requestedTopologies.size());
+    std::vector<size_t>                          drawnSlots;
+
+    // Matching the requests against the idle instances, as many as possible
+    std::vector<size_t>         idleSlots;
+    std::vector<HiCR::Topology> idleTopologies;
+    for (size_t slot = 0; slot < _slots.size(); slot++)
+      if (_slots[slot].instance != nullptr)
+      {
+        idleSlots.push_back(slot);
+        idleTopologies.push_back(_warmTopologies[slot]);
+      }
+
+    BipartiteMatcher matcher;
+    matcher.loadGraph(DeployR::buildCompatibilityGraph(requestedTopologies, idleTopologies), idleTopologies.size());
+    matcher.computeMaximumMatching();
+
+    // Taking the matched instances out of their slots
+    const auto &pairings = matcher.getLeftPairings();
+    for (size_t i = 0; i < requestedTopologies.size(); i++)
+      if (pairings[i] != BipartiteMatcher::NIL)
+      {
+        auto &slot   = _slots[idleSlots[pairings[i]]];
+        instances[i] = std::move(slot.instance);
+        drawnSlots.push_back(idleSlots[pairings[i]]);
+      }
+
+    // Creating the remaining instances on demand
+    std::vector<size_t>         remainingIdxs;
+    std::vector<HiCR::Topology> remainingTopologies;
+    for (size_t i = 0; i < requestedTopologies.size(); i++)
+      if (instances[i] == nullptr)
+      {
+        remainingIdxs.push_back(i);
+        remainingTopologies.push_back(requestedTopologies[i]);
+      }
+
+    std::vector<std::shared_ptr<HiCR::Instance>> newInstances;
+    try
+    {
+      newInstances = _deployr.provisionInstances(remainingTopologies, _maxConcurrency);
+    }
+    catch (...)
+    {
+      // Returning the drawn instances to their slots before failing. Nothing else can have filled them, since the lock is still held
+      for (size_t i = 0, d = 0; i < requestedTopologies.size(); i++)
+        if (instances[i] != nullptr) _slots[drawnSlots[d++]].instance = std::move(instances[i]);
+      throw;
+    }
+    for (size_t k = 0; k < remainingIdxs.size(); k++) instances[remainingIdxs[k]] = newInstances[k];
+
+    return instances;
+  }
+
+  /**
+   * Terminates instances acquired from the pool once a deployment is done with them, and fills the empty slots of the pool
+   *
+   * @param[in] instances The instances to release
+   */
+  __INLINE__ void release(const std::vector<std::shared_ptr<HiCR::Instance>> &instances)
+  {
+    std::unique_lock lock(_mutex);
+    _deployr.terminateInstances(instances, _maxConcurrency);
+    fillSlots();
+  }
+
+  /**
+   * Terminates all idle instances in the pool
+   */
+  __INLINE__ void drain()
+  {
+    std::unique_lock lock(_mutex);
+
+    std::vector<std::shared_ptr<HiCR::Instance>> idleInstances;
+    for (auto &slot : _slots)
+      if (slot.instance != nullptr) idleInstances.push_back(std::move(slot.instance));
+
+    _deployr.terminateInstances(idleInstances, _maxConcurrency);
+  }
+
+  /**
+   * Gets the number of idle instances in the pool
+   *
+   * @return The number of slots holding a ready instance
+   */
+  [[nodiscard]] __INLINE__ size_t getIdleCount()
+  {
+    std::unique_lock lock(_mutex);
+    size_t           idleCount = 0;
+    for (const auto &slot : _slots)
+      if (slot.instance != nullptr) idleCount++;
+    return idleCount;
+  }
+
+  /**
+   * Gets the number of warm slots in the pool
+   *
+   * @return The number of slots
+   */
+  [[nodiscard]] __INLINE__ size_t getSize() const { return _slots.size(); }
+
+  private:
+
+  /**
+   * [Internal] A warm slot of the pool
+   */
+  struct slot_t
+  {
+    /// The idle instance held by the slot, if any
+    std::shared_ptr<HiCR::Instance> instance;
+  };
+
+  /**
+   * [Internal] Creates the instances of all empty slots. Must be called while holding the pool's lock
+   */
+  __INLINE__ void fillSlots()
+  {
+    std::vector<size_t>         emptySlots;
+    std::vector<HiCR::Topology> emptyTopologies;
+    for (size_t slot = 0; slot < _slots.size(); slot++)
+      if (_slots[slot].instance == nullptr)
+      {
+        emptySlots.push_back(slot);
+        emptyTopologies.push_back(_warmTopologies[slot]);
+      }
+
+    if (emptySlots.empty()) return;
+
+    // Creating their instances. If that fails, provisionInstances has already terminated those it created, so the slots are left empty
+    const auto newInstances = _deployr.provisionInstances(emptyTopologies, _maxConcurrency);
+    for (size_t k = 0; k < emptySlots.size(); k++) _slots[emptySlots[k]].instance = newInstances[k];
+  }
+
+  /// The DeployR object used to create and terminate instances
+  DeployR &_deployr;
+
+  /// The topology of each warm slot
+  const std::vector<HiCR::Topology> _warmTopologies;
+
+  /// The maximum number of instances being created or terminated at the same time
+  const size_t _maxConcurrency;
+
+  /// Protects the slots, and serializes the instance creations and terminations of the pool
+  std::mutex _mutex;
+
+  /// The warm slots
+  std::vector<slot_t> _slots;
+
+}; // class InstancePool
+
+} // namespace deployr
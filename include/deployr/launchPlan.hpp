@@ -0,0 +1,360 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/instance.hpp>
+#include <hicr/core/topology.hpp>
+#include <nlohmann_json/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "deployment.hpp"
+#include "runner.hpp"
+
+namespace deployr
+{
+
+/**
+ * Builds the start commands of a deployment, as sent by its coordinator to the hosts in the batched and tree launch modes, and reads them back on the hosts.
+ *
+ * The plan has one entry per host, in order of first appearance, with all of its runners. Each field of the runners is kept in its own array of the entry, with one
+ * element per runner, so that the entry is encoded and decoded as a few contiguous arrays rather than as one object per runner. The payloads up to a size are
+ * concatenated in a single binary field, in runner order, while larger ones are left for the coordinator to serve (see getServedPayloads). When pinning, each entry
+ * holds the distinct topologies requested by its runners once each, which the runners refer to by index.
+ *
+ * The runners of the instance building the plan are kept apart, ready to run. Sending the entries, either from the coordinator or down the launch tree
+ * (see splitRange), is left to DeployR.
+ */
+class LaunchPlan final
+{
+  public:
+
+  /// Type for the numeric ids function names are interned into, so that start commands carry an integer rather than the name
+  typedef uint32_t functionId_t;
+
+  /**
+   * The runners assigned to a host, with one element per runner in each field
+   */
+  struct hostRunners_t
+  {
+    /// The id of each runner
+    std::vector<Runner::runnerId_t> runnerIds;
+
+    /// The id of the initial function of each runner
+    std::vector<functionId_t> functionIds;
+
+    /// The payload of each runner, empty if none
+    std::vector<Runner::payload_t> payloads;
+
+    /// The distinct serialized topologies requested by the runners, when pinning
+    std::vector<nlohmann::json> topologies;
+
+    /// The index of the topology requested by each runner among them, or Deployment::noTopology if it is not to be pinned. Empty when not pinning
+    std::vector<Deployment::topologyIdx_t> topologyIdxs;
+  };
+
+  LaunchPlan() = delete;
+
+  /**
+   * Constructor for an empty launch plan
+   *
+   * @param[in] localInstanceId The id of the instance building the plan, whose runners are kept apart (see getLocalRunners)
+   * @param[in] topologies The topologies the runners refer to by index, e.g., those of their deployment. They must outlive the plan
+   * @param[in] payloadInlineMaxSize The size up to which payloads are sent inside the entries
+   * @param[in] isRunnerPinningEnabled Whether the topologies requested by the runners are sent along, for their hosts to pin them
+   * @param[in] heartbeatInterval The time between the heartbeats the hosts are to send while their runners run, or zero if no lease is held on them
+   */
+  LaunchPlan(const HiCR::Instance::instanceId_t localInstanceId,
+             const std::vector<HiCR::Topology> &topologies,
+             const size_t                       payloadInlineMaxSize,
+             const bool                         isRunnerPinningEnabled,
+             const std::chrono::nanoseconds     heartbeatInterval)
+    : _localInstanceId(localInstanceId),
+      _topologies(topologies),
+      _payloadInlineMaxSize(payloadInlineMaxSize),
+      _isRunnerPinningEnabled(isRunnerPinningEnabled),
+      _heartbeatInterval(heartbeatInterval),
+      _serializedTopologies(isRunnerPinningEnabled ? topologies.size() : 0)
+  {}
+
+  ~LaunchPlan() = default;
+
+  /**
+   * Adds a runner to the entry of its host, creating the entry if the host had none
+   *
+   * @param[in] instanceId The id of the host
+   * @param[in] runnerId The id of the runner
+   * @param[in] functionId The id of its initial function
+   * @param[in] payload Its payload, empty if none
+   * @param[in] topologyIdx The index of its requested topology among those of the plan, or Deployment::noTopology if it is not to be pinned. Ignored when pinning is disabled
+   */
+  __INLINE__ void addRunner(const HiCR::Instance::instanceId_t instanceId,
+                            const Runner::runnerId_t           runnerId,
+                            const functionId_t                 functionId,
+                            const Runner::payload_t           &payload,
+                            const Deployment::topologyIdx_t    topologyIdx = Deployment::noTopology)
+  {
+    // The runners of this instance are kept apart, along with their payloads
+    if (instanceId == _localInstanceId)
+    {
+      _localRunners.runnerIds.push_back(runnerId);
+      _localRunners.functionIds.push_back(functionId);
+      _localRunners.payloads.push_back(payload);
+      if (_isRunnerPinningEnabled) _localRunners.topologyIdxs.push_back(addHostTopology(_localRunners.topologies, _localTopologyIdxs, topologyIdx));
+      return;
+    }
+
+    const auto [host, isNewHost] = _hostIdxs.try_emplace(instanceId, _entries.size());
+    if (isNewHost)
+    {
+      _entries.push_back(createEntry(instanceId));
+      _hostTopologyIdxs.emplace_back();
+    }
+    auto &entry = _entries[host->second];
+
+    entry["Runner Ids"].push_back(runnerId);
+    entry["Function Ids"].push_back(functionId);
+    entry["Payload Sizes"].push_back(payload.size);
+    if (_isRunnerPinningEnabled) entry["Topology Idxs"].push_back(addHostTopology(entry["Topologies"], _hostTopologyIdxs[host->second], topologyIdx));
+
+    // Small payloads are sent inline, while larger ones are kept for the host to request them
+    if (payload.size > 0 && payload.size <= _payloadInlineMaxSize)
+    {
+      auto &inlinePayloads = entry["Inline Payloads"].get_binary();
+      inlinePayloads.insert(inlinePayloads.end(), payload.data.get(), payload.data.get() + payload.size);
+    }
+    if (payload.size > _payloadInlineMaxSize) _servedPayloads.push_back({runnerId, payload});
+  }
+
+  /**
+   * Checks that the plan can be sent in the serial launch mode, whose start command only carries the runner and function ids of a single runner per host
+   */
+  __INLINE__ void checkSerialLaunch() const
+  {
+    bool hasRepeatedInstance = _localRunners.runnerIds.size() > 1;
+    for (const auto &entry : _entries) hasRepeatedInstance |= entry["Runner Ids"].size() > 1;
+    if (hasRepeatedInstance) HICR_THROW_LOGIC("[DeployR] A repeated HiCR instance was provided. Use the batched or tree launch modes to run more than one runner per instance.\n");
+
+    bool hasPinnedRemoteRunner = false;
+    for (const auto &entry : _entries) hasPinnedRemoteRunner |= entry.contains("Topologies") && entry["Topologies"].empty() == false;
+    if (hasPinnedRemoteRunner) HICR_THROW_LOGIC("[DeployR] Runner pinning needs the batched or tree launch modes, whose start commands carry the requested topologies.\n");
+
+    bool hasRemotePayload = false;
+    for (const auto &entry : _entries) hasRemotePayload |= entry["Payload Sizes"][0].get<size_t>() > 0;
+    if (hasRemotePayload) HICR_THROW_LOGIC("[DeployR] Runner payloads need the batched or tree launch modes, whose start commands carry them.\n");
+  }
+
+  /**
+   * Gets the entries of the remote hosts
+   *
+   * @return The entries, one per host in order of first appearance
+   */
+  [[nodiscard]] __INLINE__ const nlohmann::json &getEntries() const { return _entries; }
+
+  /**
+   * Gets the runners of the instance building the plan
+   *
+   * @return The runners, along with their payloads
+   */
+  [[nodiscard]] __INLINE__ const hostRunners_t &getLocalRunners() const { return _localRunners; }
+
+  /**
+   * Gets the payloads too large to be sent inline, which their hosts request from the coordinator once started
+   *
+   * @return The payloads, along with the ids of their runners
+   */
+  [[nodiscard]] __INLINE__ const std::vector<std::pair<Runner::runnerId_t, Runner::payload_t>> &getServedPayloads() const { return _servedPayloads; }
+
+  /**
+   * Reads the runners of a host back from its entry
+   *
+   * The inline payloads refer to a single copy of their concatenation, kept until the last of them is released. The payloads left out of the entry are left
+   * empty, for the host to request them from the coordinator
+   *
+   * @param[in] entry The entry of the host, as built by addRunner
+   * @param[out] servedPayloads The index of each runner whose payload was left out of the entry, along with the size of its payload
+   *
+   * @return The runners
+   */
+  [[nodiscard]] __INLINE__ static hostRunners_t parseEntry(const nlohmann::json &entry, std::vector<std::pair<size_t, size_t>> &servedPayloads)
+  {
+    hostRunners_t runners;
+    runners.runnerIds   = entry["Runner Ids"].get<std::vector<Runner::runnerId_t>>();
+    runners.functionIds = entry["Function Ids"].get<std::vector<functionId_t>>();
+    if (entry.contains("Topologies"))
+    {
+      runners.topologies   = entry["Topologies"].get<std::vector<nlohmann::json>>();
+      runners.topologyIdxs = entry["Topology Idxs"].get<std::vector<Deployment::topologyIdx_t>>();
+    }
+    runners.payloads.resize(runners.runnerIds.size());
+
+    const auto &payloadSizes         = entry["Payload Sizes"];
+    const auto  payloadInlineMaxSize = entry["Payload Inline Max Size"].get<size_t>();
+    const auto  inlinePayloads       = std::make_shared<const std::vector<uint8_t>>(entry["Inline Payloads"].get_binary());
+    size_t      inlineOffset         = 0;
+    for (size_t i = 0; i < runners.runnerIds.size(); i++)
+    {
+      const auto payloadSize = payloadSizes[i].get<size_t>();
+      if (payloadSize == 0) continue;
+      if (payloadSize > payloadInlineMaxSize)
+      {
+        servedPayloads.push_back({i, payloadSize});
+        continue;
+      }
+
+      if (inlineOffset + payloadSize > inlinePayloads->size())
+        HICR_THROW_RUNTIME("[DeployR] The inline payload of runner %lu is past the end of those received.\n", runners.runnerIds[i]);
+      runners.payloads[i] = {std::shared_ptr<const uint8_t>(inlinePayloads, inlinePayloads->data() + inlineOffset), payloadSize};
+      inlineOffset += payloadSize;
+    }
+    return runners;
+  }
+
+  /**
+   * Gets how often a host is to send heartbeats while its runners run
+   *
+   * @param[in] entry The entry of the host
+   *
+   * @return The time between heartbeats, or zero if no lease is held on the host
+   */
+  [[nodiscard]] __INLINE__ static std::chrono::nanoseconds getHeartbeatInterval(const nlohmann::json &entry)
+  {
+    return std::chrono::nanoseconds(entry.value("Heartbeat Interval", (int64_t)0));
+  }
+
+  /**
+   * Splits a range of entries into the subtrees of the launch tree below the instance sending them: up to fanout contiguous chunks of nearly equal size.
+   * The host of the first entry of each chunk becomes a child of that instance, and is in charge of the rest of its chunk
+   *
+   * @param[in] begin The first entry of the range
+   * @param[in] end One past the last entry of the range
+   * @param[in] fanout The maximum number of children per instance in the launch tree
+   *
+   * @return The first and one past the last entry of each chunk
+   */
+  [[nodiscard]] __INLINE__ static std::vector<std::pair<size_t, size_t>> splitRange(const size_t begin, const size_t end, const size_t fanout)
+  {
+    if (begin >= end) return {};
+
+    const size_t entryCount = end - begin;
+    const size_t childCount = std::min(fanout, entryCount);
+
+    std::vector<std::pair<size_t, size_t>> chunks;
+    size_t                                 chunkBegin = begin;
+    for (size_t child = 0; child < childCount; child++)
+    {
+      const size_t chunkEnd = chunkBegin + entryCount / childCount + (child < entryCount % childCount ? 1 : 0);
+      chunks.push_back({chunkBegin, chunkEnd});
+      chunkBegin = chunkEnd;
+    }
+    return chunks;
+  }
+
+  /**
+   * Computes the depth of the launch tree for a given number of hosts, as split by splitRange
+   *
+   * @param[in] entryCount The number of hosts in the launch plan
+   * @param[in] fanout The maximum number of children per instance in the launch tree
+   *
+   * @return The maximum number of forwarding hops between the coordinator and a host
+   */
+  [[nodiscard]] __INLINE__ static size_t computeTreeDepth(const size_t entryCount, const size_t fanout)
+  {
+    // At each level, the largest chunk has ceil(n / fanout) entries, one of which is the child itself
+    size_t depth = 0;
+    for (size_t remaining = entryCount; remaining > 0; remaining = (remaining + fanout - 1) / fanout - 1) depth++;
+    return depth;
+  }
+
+  private:
+
+  /**
+   * [Internal] Creates the entry of a host, to which its runners are then added
+   *
+   * @param[in] instanceId The id of the host
+   *
+   * @return The entry, which tells the host how often to send heartbeats when leasing
+   */
+  [[nodiscard]] __INLINE__ nlohmann::json createEntry(const HiCR::Instance::instanceId_t instanceId) const
+  {
+    nlohmann::json entry = {{"Instance Id", instanceId},
+                            {"Runner Ids", nlohmann::json::array()},
+                            {"Function Ids", nlohmann::json::array()},
+                            {"Payload Sizes", nlohmann::json::array()},
+                            {"Payload Inline Max Size", _payloadInlineMaxSize},
+                            {"Inline Payloads", nlohmann::json::binary({})}};
+    if (_isRunnerPinningEnabled)
+    {
+      entry["Topologies"]    = nlohmann::json::array();
+      entry["Topology Idxs"] = nlohmann::json::array();
+    }
+    if (_heartbeatInterval.count() > 0) entry["Heartbeat Interval"] = _heartbeatInterval.count();
+    return entry;
+  }
+
+  /**
+   * [Internal] Adds a topology of the plan to those of a host the first time one of its runners requests it. Each topology is serialized once for all hosts
+   *
+   * @param[in] hostTopologies The serialized topologies of the host
+   * @param[in] knownTopologyIdxs The index among them of each topology of the plan added so far
+   * @param[in] topologyIdx The index of the topology among those of the plan, or Deployment::noTopology
+   *
+   * @return The index of the topology among those of the host, or Deployment::noTopology
+   */
+  template <typename T>
+  [[nodiscard]] __INLINE__ Deployment::topologyIdx_t addHostTopology(T                                                                        &hostTopologies,
+                                                                     std::unordered_map<Deployment::topologyIdx_t, Deployment::topologyIdx_t> &knownTopologyIdxs,
+                                                                     const Deployment::topologyIdx_t                                           topologyIdx)
+  {
+    if (topologyIdx == Deployment::noTopology) return Deployment::noTopology;
+    const auto [entry, isNewTopology] = knownTopologyIdxs.try_emplace(topologyIdx, (Deployment::topologyIdx_t)hostTopologies.size());
+    if (isNewTopology == false) return entry->second;
+    auto &serializedTopology = _serializedTopologies[topologyIdx];
+    if (serializedTopology.is_null()) serializedTopology = _topologies[topologyIdx].serialize();
+    hostTopologies.push_back(serializedTopology);
+    return entry->second;
+  }
+
+  /// The id of the instance building the plan
+  const HiCR::Instance::instanceId_t _localInstanceId;
+
+  /// The topologies the runners refer to by index
+  const std::vector<HiCR::Topology> &_topologies;
+
+  /// The size up to which payloads are sent inline
+  const size_t _payloadInlineMaxSize;
+
+  /// Whether the requested topologies are sent along
+  const bool _isRunnerPinningEnabled;
+
+  /// The time between the heartbeats of the hosts, or zero if no lease is held on them
+  const std::chrono::nanoseconds _heartbeatInterval;
+
+  /// The serialized form of each topology, serialized on first use
+  std::vector<nlohmann::json> _serializedTopologies;
+
+  /// The entries of the remote hosts
+  nlohmann::json _entries = nlohmann::json::array();
+
+  /// The index of the entry of each remote host
+  std::unordered_map<HiCR::Instance::instanceId_t, size_t> _hostIdxs;
+
+  /// The index among those of each entry of the topologies of the plan added to it
+  std::vector<std::unordered_map<Deployment::topologyIdx_t, Deployment::topologyIdx_t>> _hostTopologyIdxs;
+
+  /// The runners of the instance building the plan
+  hostRunners_t _localRunners;
+
+  /// The index among those of the local runners of the topologies of the plan added to them
+  std::unordered_map<Deployment::topologyIdx_t, Deployment::topologyIdx_t> _localTopologyIdxs;
+
+  /// The payloads too large to be sent inline
+  std::vector<std::pair<Runner::runnerId_t, Runner::payload_t>> _servedPayloads;
+
+}; // class LaunchPlan
+
+} // namespace deployr
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/instance.hpp>
+#include <hicr/core/topology.hpp>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "bipartiteMatcher.hpp"
+#include "deploymentHandle.hpp"
+#include "launchPlan.hpp"
+#include "runner.hpp"
+
+namespace deployr
+{
+
+/**
+ * Keeps the leases a coordinator holds on the hosts of its remote runners, and the spare hosts to respawn those runners on when a host fails (see DeployR::setLeases).
+ *
+ * A host holds a lease while any of its runners did not complete, and renews it with every heartbeat. The registry only does the bookkeeping: the heartbeats, the
+ * checks for expired leases and the launch of the respawned runners are driven by DeployR, from its listening thread.
+ */
+class LeaseRegistry final
+{
+  public:
+
+  /**
+   * A remote runner covered by the lease of its host, as kept by the coordinator in case it needs to be respawned
+   */
+  struct leasedRunner_t
+  {
+    /// The id of the host the runner was started on
+    HiCR::Instance::instanceId_t instanceId;
+
+    /// The id of the runner
+    Runner::runnerId_t runnerId;
+
+    /// The id of its initial function
+    LaunchPlan::functionId_t functionId;
+
+    /// Its payload, empty if none
+    Runner::payload_t payload;
+
+    /// The topology it requested, if any
+    std::shared_ptr<const HiCR::Topology> topology;
+
+    /// The handle of the deployment the runner belongs to
+    std::shared_ptr<DeploymentHandle> handle;
+  };
+
+  LeaseRegistry()  = default;
+  ~LeaseRegistry() = default;
+
+  /**
+   * Adds a remote runner to the lease of its host, granting the lease if the host had none
+   *
+   * @param[in] runner The runner, along with what is needed to respawn it
+   */
+  __INLINE__ void grant(leasedRunner_t &&runner)
+  {
+    const auto runnerId            = runner.runnerId;
+    const auto [lease, isNewLease] = _leases.try_emplace(runner.instanceId);
+    if (isNewLease) lease->second.lastHeartbeatTime = std::chrono::steady_clock::now();
+    lease->second.runnerIds.push_back(runnerId);
+    _leasedRunners[runnerId] = std::move(runner);
+  }
+
+  /**
+   * Removes a completed runner from the lease of its host, releasing the lease once the host has no runners left
+   *
+   * @param[in] runnerId The id of the runner. Nothing is done if it is not leased
+   */
+  __INLINE__ void release(const Runner::runnerId_t runnerId)
+  {
+    const auto runner = _leasedRunners.find(runnerId);
+    if (runner == _leasedRunners.end()) return;
+
+    const auto lease = _leases.find(runner->second.instanceId);
+    _leasedRunners.erase(runner);
+    if (lease != _leases.end())
+    {
+      std::erase(lease->second.runnerIds, runnerId);
+      if (lease->second.runnerIds.empty()) _leases.erase(lease);
+    }
+  }
+
+  /**
+   * Renews the lease of a host, upon receiving its heartbeat
+   *
+   * @param[in] instanceId The id of the host. Nothing is done if it holds no lease
+   */
+  __INLINE__ void renew(const HiCR::Instance::instanceId_t instanceId)
+  {
+    const auto lease = _leases.find(instanceId);
+    if (lease != _leases.end()) lease->second.lastHeartbeatTime = std::chrono::steady_clock::now();
+  }
+
+  /**
+   * Indicates whether no lease is held
+   *
+   * @return true, if none is; false, otherwise
+   */
+  [[nodiscard]] __INLINE__ bool empty() const { return _leases.empty(); }
+
+  /**
+   * Indicates whether a host holds a lease
+   *
+   * @param[in] instanceId The id of the host
+   *
+   * @return true, if it does; false, otherwise
+   */
+  [[nodiscard]] __INLINE__ bool isLeased(const HiCR::Instance::instanceId_t instanceId) const { return _leases.contains(instanceId); }
+
+  /**
+   * Finds the hosts that did not renew their lease for longer than its duration
+   *
+   * @param[in] checkTime The time to check the leases at
+   * @param[in] leaseDuration The time without heartbeats after which a host is considered failed
+   *
+   * @return The ids of the hosts
+   */
+  [[nodiscard]] __INLINE__ std::vector<HiCR::Instance::instanceId_t> getExpiredInstanceIds(const std::chrono::steady_clock::time_point checkTime,
+                                                                                           const std::chrono::nanoseconds              leaseDuration) const
+  {
+    std::vector<HiCR::Instance::instanceId_t> expiredInstanceIds;
+    for (const auto &[instanceId, lease] : _leases)
+      if (checkTime - lease.lastHeartbeatTime > leaseDuration) expiredInstanceIds.push_back(instanceId);
+    return expiredInstanceIds;
+  }
+
+  /**
+   * Revokes the lease of a failed host, which is remembered as failed
+   *
+   * @param[in] instanceId The id of the host. It must hold a lease
+   *
+   * @return The runners of the host that did not complete
+   */
+  [[nodiscard]] __INLINE__ std::vector<leasedRunner_t> revoke(const HiCR::Instance::instanceId_t instanceId)
+  {
+    const auto lease = _leases.extract(instanceId);
+    if (lease.empty()) HICR_THROW_LOGIC("[DeployR] Instance %lu holds no lease to revoke.\n", instanceId);
+    _failedInstanceIds.insert(instanceId);
+
+    std::vector<leasedRunner_t> runners;
+    for (const auto runnerId : lease.mapped().runnerIds) runners.push_back(std::move(_leasedRunners.extract(runnerId).mapped()));
+    return runners;
+  }
+
+  /**
+   * Adds hosts to respawn runners on. Each of them takes a single runner, after which it is no longer spare
+   *
+   * @param[in] instanceIds The ids of the spare hosts
+   * @param[in] topologies The topology of each spare host
+   */
+  __INLINE__ void addSpareHosts(const std::vector<HiCR::Instance::instanceId_t> &instanceIds, const std::vector<HiCR::Topology> &topologies)
+  {
+    if (instanceIds.size() != topologies.size()) HICR_THROW_LOGIC("[DeployR] Provided %lu spare host ids, but %lu topologies.\n", instanceIds.size(), topologies.size());
+    for (size_t i = 0; i < instanceIds.size(); i++) _spareHosts.push_back({instanceIds[i], topologies[i]});
+  }
+
+  /**
+   * Takes a spare host for as many runners as possible. The runners are matched to the spare hosts whose topology satisfies the one they requested (or any,
+   * if they requested none), one runner per spare host. The runners that got a spare host are remembered as respawned
+   *
+   * @param[in] runners The runners to respawn
+   *
+   * @return The id of the spare host taken for each runner, or nothing if no spare host can take it
+   */
+  [[nodiscard]] __INLINE__ std::vector<std::optional<HiCR::Instance::instanceId_t>> takeSpareHosts(const std::vector<leasedRunner_t> &runners)
+  {
+    // Matching the runners to the spare hosts
+    std::vector<std::vector<size_t>> compatibleSpareHosts(runners.size());
+    for (size_t i = 0; i < runners.size(); i++)
+      for (size_t j = 0; j < _spareHosts.size(); j++)
+        if (runners[i].topology == nullptr || HiCR::Topology::isSubset(_spareHosts[j].topology, *runners[i].topology)) compatibleSpareHosts[i].push_back(j);
+
+    BipartiteMatcher matcher;
+    matcher.loadGraph(compatibleSpareHosts, _spareHosts.size());
+    matcher.computeMaximumMatching();
+    const auto &pairings = matcher.getLeftPairings();
+
+    std::vector<std::optional<HiCR::Instance::instanceId_t>> spareInstanceIds(runners.size());
+    std::vector<bool>                                        isSpareHostTaken(_spareHosts.size(), false);
+    for (size_t i = 0; i < runners.size(); i++)
+    {
+      if (pairings[i] == BipartiteMatcher::NIL) continue;
+      spareInstanceIds[i]           = _spareHosts[pairings[i]].instanceId;
+      isSpareHostTaken[pairings[i]] = true;
+      _respawnedRunnerIds.insert(runners[i].runnerId);
+    }
+
+    // The spare hosts taken are no longer spare
+    std::vector<spareHost_t> spareHosts;
+    for (size_t j = 0; j < _spareHosts.size(); j++)
+      if (isSpareHostTaken[j] == false) spareHosts.push_back(std::move(_spareHosts[j]));
+    _spareHosts = std::move(spareHosts);
+
+    return spareInstanceIds;
+  }
+
+  /**
+   * Indicates whether a runner was respawned. Its first host may still report it, if it was only late to renew its lease
+   *
+   * @param[in] runnerId The id of the runner
+   *
+   * @return true, if it was; false, otherwise
+   */
+  [[nodiscard]] __INLINE__ bool isRespawned(const Runner::runnerId_t runnerId) const { return _respawnedRunnerIds.contains(runnerId); }
+
+  /**
+   * Gets the number of spare hosts left
+   *
+   * @return The number of spare hosts
+   */
+  [[nodiscard]] __INLINE__ size_t getSpareHostCount() const { return _spareHosts.size(); }
+
+  /**
+   * Gets the hosts whose lease was revoked
+   *
+   * @return The ids of the failed hosts
+   */
+  [[nodiscard]] __INLINE__ const std::unordered_set<HiCR::Instance::instanceId_t> &getFailedInstanceIds() const { return _failedInstanceIds; }
+
+  private:
+
+  /**
+   * [Internal] The lease the coordinator holds on a host, while the host runs any of its runners
+   */
+  struct lease_t
+  {
+    /// When the last heartbeat of the host was received, or the lease was granted
+    std::chrono::steady_clock::time_point lastHeartbeatTime;
+
+    /// The runners of the host that did not complete yet
+    std::vector<Runner::runnerId_t> runnerIds;
+  };
+
+  /**
+   * [Internal] A host runners can be respawned on
+   */
+  struct spareHost_t
+  {
+    /// The id of the host
+    HiCR::Instance::instanceId_t instanceId;
+
+    /// Its topology
+    HiCR::Topology topology;
+  };
+
+  /// The leases held, by host instance id
+  std::unordered_map<HiCR::Instance::instanceId_t, lease_t> _leases;
+
+  /// The runners covered by the leases, by runner id
+  std::unordered_map<Runner::runnerId_t, leasedRunner_t> _leasedRunners;
+
+  /// The hosts available to respawn runners on
+  std::vector<spareHost_t> _spareHosts;
+
+  /// The hosts whose lease was revoked
+  std::unordered_set<HiCR::Instance::instanceId_t> _failedInstanceIds;
+
+  /// The runners that were respawned, whose first host may still report them
+  std::unordered_set<Runner::runnerId_t> _respawnedRunnerIds;
+
+}; // class LeaseRegistry
+
+} // namespace deployr
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/topology.hpp>
+#include <nlohmann_json/json.hpp>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "instanceManager.hpp"
+#include "network.hpp"
+#include "rpcEngine.hpp"
+
+namespace deployr::local
+{
+
+/**
+ * In-process distributed engine, which simulates a set of instances as threads of the same process, exchanging messages through a Network with a configurable latency.
+ *
+ * Each simulated instance gets its own instance manager, RPC engine and (injected) local topology, and runs the same function, as the processes of an MPI job would.
+ * This allows exercising DeployR's coordinator logic with a large number of instances on a single machine. DeployR uses this engine when built with the
+ * _DEPLOYR_DISTRIBUTED_ENGINE_LOCAL flag.
+ */
+class Engine final
+{
+  public:
+
+  /// Type for the function run by every simulated instance
+  typedef std::function<void(InstanceManager &instanceManager, RPCEngine &rpcEngine, const HiCR::Topology &localTopology)> instanceFc_t;
+
+  Engine() = delete;
+
+  /**
+   * Constructor for the engine
+   *
+   * @param[in] topologies The local topology of each instance to simulate. Instance ids follow their order, and instance 0 is the root
+   */
+  Engine(std::vector<HiCR::Topology> topologies)
+    : _topologies(std::move(topologies)),
+      _network(_topologies.size())
+  {
+    if (_topologies.empty()) HICR_THROW_LOGIC("[DeployR] The local engine needs at least one instance to simulate.\n");
+    for (size_t i = 0; i < _topologies.size(); i++) _instances.push_back(std::make_shared<Instance>(i));
+  }
+
+  ~Engine() = default;
+
+  /**
+   * Reads a list of topologies in the format of the CloudR configuration files: a root object with a "Topologies" array
+   *
+   * @param[in] filePath The path of the file to read
+   * @param[in] instanceCount The number of topologies to return. The ones in the file are repeated cyclically. Zero means as many as in the file
+   *
+   * @return The topologies
+   */
+  [[nodiscard]] __INLINE__ static std::vector<HiCR::Topology> loadTopologies(const std::string &filePath, const size_t instanceCount = 0)
+  {
+    std::ifstream file(filePath);
+    if (file.good() == false) HICR_THROW_RUNTIME("[DeployR] Could not open topology file '%s'.\n", filePath.c_str());
+
+    const auto fileJs = nlohmann::json::parse(file);
+    if (fileJs.contains("Topologies") == false || fileJs["Topologies"].is_array() == false || fileJs["Topologies"].empty())
+      HICR_THROW_LOGIC("[DeployR] Topology file '%s' does not contain a non-empty \"Topologies\" array.\n", filePath.c_str());
+
+    // Deserializing each distinct topology once
+    std::vector<HiCR::Topology> fileTopologies;
+    for (const auto &topologyJs : fileJs["Topologies"]) fileTopologies.push_back(HiCR::Topology(topologyJs));
+
+    const auto                  topologyCount = instanceCount == 0 ? fileTopologies.size() : instanceCount;
+    std::vector<HiCR::Topology> topologies;
+    topologies.reserve(topologyCount);
+    for (size_t i = 0; i < topologyCount; i++) topologies.push_back(fileTopologies[i % fileTopologies.size()]);
+    return topologies;
+  }
+
+  /**
+   * Sets the latency added to every message. Must be called before run
+   *
+   * @param[in] latency The one-way latency of a message
+   */
+  __INLINE__ void setMessageLatency(const std::chrono::nanoseconds latency) { _network.setLatency(latency); }
+
+  /**
+   * Gets the number of simulated instances
+   *
+   * @return The number of instances
+   */
+  [[nodiscard]] __INLINE__ size_t getInstanceCount() const { return _instances.size(); }
+
+  /**
+   * Gets the network connecting the simulated instances, e.g., to retrieve its message statistics after run
+   *
+   * @return The network
+   */
+  [[nodiscard]] __INLINE__ const Network &getNetwork() const { return _network; }
+
+  /**
+   * Simulates the failure of an instance during run (see Network::crash), e.g., to exercise the detection of failed hosts by a coordinator
+   *
+   * @param[in] instanceId The instance to crash
+   */
+  __INLINE__ void crashInstance(const HiCR::Instance::instanceId_t instanceId) { _network.crash(instanceId); }
+
+  /**
+   * Runs a function on every simulated instance, each on its own thread, and waits for all of them to finish
+   *
+   * @param[in] fc The function to run, which receives the instance manager, the RPC engine and the local topology of its instance
+   */
+  __INLINE__ void run(const instanceFc_t &fc)
+  {
+    std::vector<std::thread> threads;
+    threads.reserve(_instances.size());
+    for (size_t i = 0; i < _instances.size(); i++)
+      threads.emplace_back([this, &fc, i]() {
+        InstanceManager instanceManager(_instances, i);
+        RPCEngine       rpcEngine(_network, instanceManager);
+        fc(instanceManager, rpcEngine, _topologies[i]);
+      });
+
+    for (auto &thread : threads) thread.join();
+  }
+
+  private:
+
+  /// The local topology of each instance
+  const std::vector<HiCR::Topology> _topologies;
+
+  /// The simulated instances, by id
+  InstanceManager::instanceList_t _instances;
+
+  /// The network connecting the instances
+  Network _network;
+
+}; // class Engine
+
+} // namespace deployr::local
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/instance.hpp>
+#include <hicr/core/instanceTemplate.hpp>
+#include <hicr/core/topology.hpp>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace deployr::local
+{
+
+/**
+ * An instance simulated by the local engine. Instance 0 is the root
+ */
+class Instance final : public HiCR::Instance
+{
+  public:
+
+  /**
+   * Constructor for the instance
+   *
+   * @param[in] instanceId The id of the instance
+   */
+  Instance(const HiCR::Instance::instanceId_t instanceId)
+    : HiCR::Instance(instanceId)
+  {}
+
+  ~Instance() override = default;
+
+  [[nodiscard]] bool isRootInstance() const override { return getId() == 0; }
+
+}; // class Instance
+
+/**
+ * Instance manager of an instance simulated by the local engine. It provides the subset of the HiCR instance manager interface used by DeployR.
+ *
+ * Every simulated instance has its own instance manager, all of which share the same list of instances. The set of instances is fixed when the
+ * local engine starts, so instances cannot be created or terminated.
+ */
+class InstanceManager final
+{
+  public:
+
+  /// Type for the list of instances
+  typedef std::vector<std::shared_ptr<HiCR::Instance>> instanceList_t;
+
+  InstanceManager() = delete;
+
+  /**
+   * Constructor for the instance manager
+   *
+   * @param[in] instances The instances simulated by the local engine, shared with the other instance managers. Must outlive this instance manager
+   * @param[in] currentInstanceId The id of the instance this instance manager belongs to
+   */
+  InstanceManager(const instanceList_t &instances, const HiCR::Instance::instanceId_t currentInstanceId)
+    : _instances(instances),
+      _currentInstance(instances.at(currentInstanceId))
+  {}
+
+  ~InstanceManager() = default;
+
+  /**
+   * Gets the instances simulated by the local engine
+   *
+   * @return The instances, ordered by id
+   */
+  [[nodiscard]] __INLINE__ const instanceList_t &getInstances() const { return _instances; }
+
+  /**
+   * Gets the instance this instance manager belongs to
+   *
+   * @return The current instance
+   */
+  [[nodiscard]] __INLINE__ std::shared_ptr<HiCR::Instance> getCurrentInstance() const { return _currentInstance; }
+
+  /**
+   * Gets an instance by its id
+   *
+   * @param[in] instanceId The id of the instance
+   *
+   * @return The instance, or nullptr if it does not exist
+   */
+  [[nodiscard]] __INLINE__ HiCR::Instance *getInstance(const HiCR::Instance::instanceId_t instanceId) const
+  {
+    return instanceId < _instances.size() ? _instances[instanceId].get() : nullptr;
+  }
+
+  /**
+   * Gets the id of the root instance
+   *
+   * @return The id of the root instance, which is always 0
+   */
+  [[nodiscard]] __INLINE__ HiCR::Instance::instanceId_t getRootInstanceId() const { return 0; }
+
+  /**
+   * Creates an instance template from a topology
+   *
+   * @param[in] topology The topology of the template
+   *
+   * @return The instance template
+   */
+  [[nodiscard]] __INLINE__ std::shared_ptr<HiCR::InstanceTemplate> createInstanceTemplate(const HiCR::Topology &topology)
+  {
+    return std::make_shared<HiCR::InstanceTemplate>(topology);
+  }
+
+  /**
+   * Creating instances is not supported by the local engine
+   *
+   * @param[in] instanceTemplate The template of the instance to create
+   *
+   * @return Nothing, it always throws
+   */
+  __INLINE__ std::shared_ptr<HiCR::Instance> createInstance([[maybe_unused]] const HiCR::InstanceTemplate &instanceTemplate)
+  {
+    HICR_THROW_LOGIC("[DeployR] The local engine does not support creating instances.\n");
+  }
+
+  /**
+   * Terminating instances is not supported by the local engine
+   *
+   * @param[in] instance The instance to terminate
+   */
+  __INLINE__ void terminateInstance(const std::shared_ptr<HiCR::Instance> instance)
+  {
+    HICR_THROW_LOGIC("[DeployR] The local engine does not support terminating instance %lu.\n", instance->getId());
+  }
+
+  /**
+   * Aborts the whole process, and with it every simulated instance
+   *
+   * @param[in] errorCode The exit code of the process
+   */
+  __INLINE__ void abort(const int errorCode) { std::quick_exit(errorCode); }
+
+  /**
+   * Finalizes the instance. Nothing needs to be done, since the local engine joins the threads of the instances when they finish
+   */
+  __INLINE__ void finalize() {}
+
+  private:
+
+  /// The instances simulated by the local engine
+  const instanceList_t &_instances;
+
+  /// The instance this instance manager belongs to
+  const std::shared_ptr<HiCR::Instance> _currentInstance;
+
+}; // class InstanceManager
+
+} // namespace deployr::local
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/instance.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace deployr::local
+{
+
+/**
+ * Carries the messages exchanged by the instances simulated by the local engine, which are threads of the same process.
+ *
+ * Each instance has a mailbox, holding the RPC requests sent to it and the return values sent back to it (one queue per sender). A configurable latency is added to every
+ * message: it becomes visible to its receiver only once the latency has elapsed since it was sent. Senders never block, as with a real network.
+ * The failure of an instance can be simulated with crash, after which the messages it sends, and those sent to it, are dropped.
+ */
+class Network final
+{
+  public:
+
+  /// Clock used to time message deliveries
+  typedef std::chrono::steady_clock clock_t;
+
+  /**
+   * An RPC request, as received by its target
+   */
+  struct request_t
+  {
+    /// The name of the requested RPC
+    std::string name;
+
+    /// The argument of the request
+    uint64_t argument;
+
+    /// The instance that sent the request
+    HiCR::Instance::instanceId_t sourceId;
+
+    /// When the request becomes visible to its target
+    clock_t::time_point deliveryTime;
+  };
+
+  Network() = delete;
+
+  /**
+   * Constructor for the network
+   *
+   * @param[in] instanceCount The number of instances, whose ids are 0 to instanceCount - 1
+   */
+  Network(const size_t instanceCount)
+    : _mailboxes(instanceCount),
+      _isCrashed(instanceCount)
+  {}
+
+  ~Network() = default;
+
+  /**
+   * Sets the latency added to every message sent from now on
+   *
+   * @param[in] latency The one-way latency of a message
+   */
+  __INLINE__ void setLatency(const std::chrono::nanoseconds latency) { _latency = latency; }
+
+  /**
+   * Gets the latency added to every message
+   *
+   * @return The one-way latency of a message
+   */
+  [[nodiscard]] __INLINE__ std::chrono::nanoseconds getLatency() const { return _latency; }
+
+  /**
+   * Simulates the failure of an instance. Its thread keeps running, but the messages it sends from now on are dropped, as are those sent to it
+   *
+   * @param[in] instanceId The instance to crash
+   */
+  __INLINE__ void crash(const HiCR::Instance::instanceId_t instanceId)
+  {
+    if (instanceId >= _isCrashed.size()) HICR_THROW_LOGIC("[DeployR] Instance %lu does not exist in the local engine, which has %lu instances.\n", instanceId, _isCrashed.size());
+    _isCrashed[instanceId] = true;
+  }
+
+  /**
+   * Sends an RPC request to an instance
+   *
+   * @param[in] targetId The instance to send the request to
+   * @param[in] sourceId The instance sending the request
+   * @param[in] name The name of the requested RPC
+   * @param[in] argument The argument of the request
+   */
+  __INLINE__ void sendRequest(const HiCR::Instance::instanceId_t targetId, const HiCR::Instance::instanceId_t sourceId, const std::string &name, const uint64_t argument)
+  {
+    auto &mailbox = getMailbox(targetId);
+    if (_isCrashed[targetId] || _isCrashed[sourceId]) return;
+    {
+      std::unique_lock lock(mailbox.mutex);
+      mailbox.requests.push_back({name, argument, sourceId, clock_t::now() + _latency});
+    }
+    mailbox.messageArrived.notify_all();
+    _messageCount++;
+  }
+
+  /**
+   * Waits for the next RPC request sent to an instance, in the order they were sent
+   *
+   * @param[in] targetId The instance receiving the request
+   *
+   * @return The request
+   */
+  [[nodiscard]] __INLINE__ request_t receiveRequest(const HiCR::Instance::instanceId_t targetId)
+  {
+    auto &mailbox = getMailbox(targetId);
+    return receive(mailbox, mailbox.requests);
+  }
+
+  /**
+   * Sends the return value of an RPC back to the instance that requested it
+   *
+   * @param[in] targetId The instance that requested the RPC
+   * @param[in] sourceId The instance that executed the RPC
+   * @param[in] payload The return value
+   */
+  __INLINE__ void sendReturnValue(const HiCR::Instance::instanceId_t targetId, const HiCR::Instance::instanceId_t sourceId, std::string &&payload)
+  {
+    const auto payloadSize = payload.size();
+    auto      &mailbox     = getMailbox(targetId);
+    if (_isCrashed[targetId] || _isCrashed[sourceId]) return;
+    {
+      std::unique_lock lock(mailbox.mutex);
+      mailbox.returnValues[sourceId].push_back({std::move(payload), clock_t::now() + _latency});
+    }
+    mailbox.messageArrived.notify_all();
+    _messageCount++;
+    _byteCount += payloadSize;
+  }
+
+  /**
+   * Waits for the next return value sent by an instance to another, in the order they were sent
+   *
+   * @param[in] targetId The instance receiving the return value
+   * @param[in] sourceId The instance that executed the RPC
+   *
+   * @return The return value
+   */
+  [[nodiscard]] __INLINE__ std::string receiveReturnValue(const HiCR::Instance::instanceId_t targetId, const HiCR::Instance::instanceId_t sourceId)
+  {
+    auto &mailbox = getMailbox(targetId);
+
+    // Getting the queue of the sender. References to the elements of an unordered_map remain valid while others are inserted
+    std::deque<returnValue_t> *queue;
+    {
+      std::unique_lock lock(mailbox.mutex);
+      queue = &mailbox.returnValues[sourceId];
+    }
+
+    return receive(mailbox, *queue).payload;
+  }
+
+  /**
+   * Gets the number of messages (requests and return values) sent so far
+   *
+   * @return The number of messages
+   */
+  [[nodiscard]] __INLINE__ size_t getMessageCount() const { return _messageCount; }
+
+  /**
+   * Gets the number of payload bytes carried by return values so far
+   *
+   * @return The number of bytes
+   */
+  [[nodiscard]] __INLINE__ size_t getByteCount() const { return _byteCount; }
+
+  private:
+
+  /**
+   * [Internal] A return value, as received by the instance that requested the RPC
+   */
+  struct returnValue_t
+  {
+    /// The return value itself
+    std::string payload;
+
+    /// When it becomes visible to its receiver
+    clock_t::time_point deliveryTime;
+  };
+
+  /**
+   * [Internal] The messages sent to an instance, not yet received
+   */
+  struct mailbox_t
+  {
+    /// Protects the queues
+    std::mutex mutex;
+
+    /// Notified whenever a message is added to any of the queues
+    std::condition_variable messageArrived;
+
+    /// The RPC requests, in the order they were sent
+    std::deque<request_t> requests;
+
+    /// The return values, by the instance that sent them
+    std::unordered_map<HiCR::Instance::instanceId_t, std::deque<returnValue_t>> returnValues;
+  };
+
+  /**
+   * [Internal] Gets the mailbox of an instance
+   *
+   * @param[in] instanceId The id of the instance
+   *
+   * @return The mailbox
+   */
+  [[nodiscard]] __INLINE__ mailbox_t &getMailbox(const HiCR::Instance::instanceId_t instanceId)
+  {
+    if (instanceId >= _mailboxes.size()) HICR_THROW_LOGIC("[DeployR] Instance %lu does not exist in the local engine, which has %lu instances.\n", instanceId, _mailboxes.size());
+    return _mailboxes[instanceId];
+  }
+
+  /**
+   * [Internal] Waits until the first message of a queue is delivered, and takes it
+   *
+   * @param[in] mailbox The mailbox the queue belongs to
+   * @param[in] queue The queue
+   *
+   * @return The message
+   */
+  template <typename T>
+  [[nodiscard]] __INLINE__ static T receive(mailbox_t &mailbox, std::deque<T> &queue)
+  {
+    std::unique_lock lock(mailbox.mutex);
+    while (true)
+    {
+      // Waiting for a message to be sent
+      if (queue.empty())
+      {
+        mailbox.messageArrived.wait(lock);
+        continue;
+      }
+
+      // Waiting for its latency to elapse. Messages are sent with the same latency, so the first one is always delivered first
+      const auto deliveryTime = queue.front().deliveryTime;
+      if (clock_t::now() < deliveryTime)
+      {
+        mailbox.messageArrived.wait_until(lock, deliveryTime);
+        continue;
+      }
+
+      auto message = std::move(queue.front());
+      queue.pop_front();
+      return message;
+    }
+  }
+
+  /// The mailbox of each instance, by instance id
+  std::vector<mailbox_t> _mailboxes;
+
+  /// Whether each instance crashed, by instance id
+  std::vector<std::atomic<bool>> _isCrashed;
+
+  /// The latency added to every message
+  std::chrono::nanoseconds _latency = std::chrono::nanoseconds(0);
+
+  /// Number of messages sent so far
+  std::atomic<size_t> _messageCount = 0;
+
+  /// Number of return value bytes sent so far
+  std::atomic<size_t> _byteCount = 0;
+
+}; // class Network
+
+} // namespace deployr::local
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/instance.hpp>
+#include <hicr/core/localMemorySlot.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "instanceManager.hpp"
+#include "network.hpp"
+
+namespace deployr::local
+{
+
+/**
+ * Allocates the memory slots holding the return values received by the local RPC engine. It provides the subset of the HiCR memory manager interface used by DeployR
+ */
+class MemoryManager final
+{
+  public:
+
+  MemoryManager()  = default;
+  ~MemoryManager() = default;
+
+  /**
+   * Allocates a memory slot holding a copy of a buffer
+   *
+   * @param[in] buffer The contents of the memory slot
+   *
+   * @return The memory slot
+   */
+  [[nodiscard]] __INLINE__ std::shared_ptr<HiCR::LocalMemorySlot> allocateLocalMemorySlot(const std::string &buffer)
+  {
+    if (buffer.empty()) return std::make_shared<HiCR::LocalMemorySlot>(nullptr, 0);
+
+    auto pointer = malloc(buffer.size());
+    if (pointer == nullptr) HICR_THROW_RUNTIME("[DeployR] Could not allocate %lu bytes for a return value.\n", buffer.size());
+    memcpy(pointer, buffer.data(), buffer.size());
+    return std::make_shared<HiCR::LocalMemorySlot>(pointer, buffer.size());
+  }
+
+  /**
+   * Frees a memory slot allocated by this memory manager
+   *
+   * @param[in] memorySlot The memory slot to free
+   */
+  __INLINE__ void freeLocalMemorySlot(const std::shared_ptr<HiCR::LocalMemorySlot> &memorySlot) { free(memorySlot->getPointer()); }
+
+}; // class MemoryManager
+
+/**
+ * RPC engine of an instance simulated by the local engine. It provides the subset of the HiCR RPC engine interface used by DeployR, on top of the messages of a Network.
+ *
+ * As with the HiCR RPC engine, each call to listen executes a single incoming RPC on the calling thread and the requester waits for its return value, if any, with getReturnValue.
+ */
+class RPCEngine final
+{
+  public:
+
+  RPCEngine() = delete;
+
+  /**
+   * Constructor for the RPC engine
+   *
+   * @param[in] network The network connecting the simulated instances. Must outlive this RPC engine
+   * @param[in] instanceManager The instance manager of the instance this RPC engine belongs to. Must outlive this RPC engine
+   */
+  RPCEngine(Network &network, InstanceManager &instanceManager)
+    : _network(network),
+      _instanceManager(instanceManager),
+      _currentInstanceId(instanceManager.getCurrentInstance()->getId())
+  {}
+
+  ~RPCEngine() = default;
+
+  /**
+   * Initializes the RPC engine. Nothing needs to be done, since the network is shared by all instances from the start
+   */
+  __INLINE__ void initialize() {}
+
+  /**
+   * Registers a function as target for an RPC
+   *
+   * @param[in] RPCName The name of the RPC
+   * @param[in] fc The function to execute when the RPC is requested
+   */
+  __INLINE__ void addRPCTarget(const std::string &RPCName, std::function<void()> fc) { _targets[RPCName] = std::move(fc); }
+
+  /**
+   * Requests the execution of an RPC on another instance. It does not wait for the RPC to execute
+   *
+   * @param[in] instance The instance to execute the RPC on
+   * @param[in] RPCName The name of the RPC
+   * @param[in] argument The argument of the request, which the target reads with getRPCArgument
+   */
+  __INLINE__ void requestRPC(HiCR::Instance &instance, const std::string &RPCName, const uint64_t argument = 0)
+  {
+    _network.sendRequest(instance.getId(), _currentInstanceId, RPCName, argument);
+  }
+
+  /**
+   * Waits for the next incoming RPC and executes it on the calling thread
+   */
+  __INLINE__ void listen()
+  {
+    auto request = _network.receiveRequest(_currentInstanceId);
+
+    const auto target = _targets.find(request.name);
+    if (target == _targets.end()) HICR_THROW_RUNTIME("[DeployR] Instance %lu received a request for unknown RPC '%s'.\n", _currentInstanceId, request.name.c_str());
+
+    // Keeping the request being served, restoring the previous one afterwards in case RPCs are served from within an RPC
+    const auto previousArgument    = _argument;
+    const auto previousRequesterId = _requesterId;
+    _argument                      = request.argument;
+    _requesterId                   = request.sourceId;
+
+    target->second();
+
+    _argument    = previousArgument;
+    _requesterId = previousRequesterId;
+  }
+
+  /**
+   * Gets the argument of the RPC being executed
+   *
+   * @return The argument given by the requester
+   */
+  [[nodiscard]] __INLINE__ uint64_t getRPCArgument() const { return _argument; }
+
+  /**
+   * Sends a return value to the requester of the RPC being executed
+   *
+   * @param[in] pointer The start of the return value
+   * @param[in] size The size in bytes of the return value
+   */
+  __INLINE__ void submitReturnValue(void *pointer, const size_t size) { _network.sendReturnValue(_requesterId, _currentInstanceId, std::string((const char *)pointer, size)); }
+
+  /**
+   * Waits for the return value of an RPC requested from an instance
+   *
+   * @param[in] instance The instance the RPC was requested from
+   *
+   * @return A memory slot holding the return value, to be freed with the memory manager of this RPC engine
+   */
+  [[nodiscard]] __INLINE__ std::shared_ptr<HiCR::LocalMemorySlot> getReturnValue(HiCR::Instance &instance)
+  {
+    return _memoryManager.allocateLocalMemorySlot(_network.receiveReturnValue(_currentInstanceId, instance.getId()));
+  }
+
+  /**
+   * Gets the memory manager that allocates the return values
+   *
+   * @return The memory manager
+   */
+  [[nodiscard]] __INLINE__ MemoryManager *getMemoryManager() { return &_memoryManager; }
+
+  /**
+   * Gets the instance manager of the instance this RPC engine belongs to
+   *
+   * @return The instance manager
+   */
+  [[nodiscard]] __INLINE__ InstanceManager *getInstanceManager() const { return &_instanceManager; }
+
+  private:
+
+  /// The network connecting the simulated instances
+  Network &_network;
+
+  /// The instance manager of the instance this RPC engine belongs to
+  InstanceManager &_instanceManager;
+
+  /// The id of the instance this RPC engine belongs to
+  const HiCR::Instance::instanceId_t _currentInstanceId;
+
+  /// Allocates the memory slots of the return values
+  MemoryManager _memoryManager;
+
+  /// The registered RPC targets, by name
+  std::unordered_map<std::string, std::function<void()>> _targets;
+
+  /// The argument of the RPC being executed
+  uint64_t _argument = 0;
+
+  /// The requester of the RPC being executed
+  HiCR::Instance::instanceId_t _requesterId = 0;
+
+}; // class RPCEngine
+
+} // namespace deployr::local
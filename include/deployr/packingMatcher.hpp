@@ -0,0 +1,495 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/topology.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "resourceSignatures.hpp"
+
+namespace deployr
+{
+
+/**
+ * Packs several runners into each host, treating the host topologies as divisible capacity rather than consuming a whole host per runner (as doBipartiteMatching does).
+ *
+ * Each compute resource of a host is given out to a single runner, and each memory space is divided among runners by size. The requested devices of a runner are
+ * placed as in HiCR::Topology::isSubset: in order, each on a different host device of the same type, which must have enough free compute resources (by type) and free
+ * memory (by memory space type) for it. Several runners may share a host device, as long as its capacity lasts.
+ *
+ * Runners are packed first-fit decreasing: runners requesting more resources (normalized by the largest amount found among the hosts) are placed first, each on the first
+ * host with enough capacity left. Identical requests are handled as a class, whose search resumes from the last host that fitted it, so that packing takes close to
+ * O(runners + hosts x classes) capacity checks. Like any first-fit heuristic, it may fail to pack a set of runners that fits in some other arrangement.
+ *
+ * The remaining capacity is kept between calls to pack, so that several deployments can be packed into the same hosts.
+ */
+class PackingMatcher final
+{
+  public:
+
+  /**
+   * A compute resource of a host, given out to a runner
+   */
+  struct computeResourceRef_t
+  {
+    /// The index of the device, in the host topology
+    size_t deviceIdx;
+
+    /// The index of the compute resource, in the device
+    size_t computeResourceIdx;
+  };
+
+  /**
+   * A part of a memory space of a host, given out to a runner
+   */
+  struct memoryShare_t
+  {
+    /// The index of the device, in the host topology
+    size_t deviceIdx;
+
+    /// The index of the memory space, in the device
+    size_t memorySpaceIdx;
+
+    /// The size given out, in bytes
+    size_t size;
+  };
+
+  /**
+   * The host and resources assigned to a runner
+   */
+  struct partition_t
+  {
+    /// The index of the host, among the given topologies
+    size_t hostIdx;
+
+    /// The compute resources given out to the runner, in the order they were requested
+    std::vector<computeResourceRef_t> computeResources;
+
+    /// The memory given out to the runner, in the order it was requested
+    std::vector<memoryShare_t> memoryShares;
+  };
+
+  PackingMatcher() = delete;
+
+  /**
+   * Constructor for the packing matcher. All the resources of the given hosts start free
+   *
+   * @param[in] given The topologies of the available hosts
+   */
+  PackingMatcher(const std::vector<HiCR::Topology> &given)
+  {
+    _hosts.resize(given.size());
+    for (size_t h = 0; h < given.size(); h++)
+      for (const auto &device : given[h].getDevices())
+      {
+        deviceCapacity_t capacity;
+        capacity.type = internDeviceType(device->getType());
+        for (const auto &computeResource : device->getComputeResourceList())
+          capacity.computeResourceDimensions.push_back(internDimension("Compute Resources/" + device->getType() + "/" + computeResource->getType()));
+        for (const auto &memorySpace : device->getMemorySpaceList())
+        {
+          capacity.memorySpaceDimensions.push_back(internDimension("Memory Spaces/" + device->getType() + "/" + memorySpace->getType()));
+          capacity.freeMemory.push_back(memorySpace->getSize());
+        }
+        capacity.isComputeResourceFree.assign(capacity.computeResourceDimensions.size(), true);
+        _hosts[h].push_back(std::move(capacity));
+      }
+
+    // Adding up the free resources of every host, by kind
+    _freeResources.assign(given.size() * _dimensionNames.size(), 0);
+    for (size_t h = 0; h < given.size(); h++)
+      for (const auto &device : _hosts[h])
+      {
+        for (const auto dimension : device.computeResourceDimensions) getFreeResources(h)[dimension]++;
+        for (size_t m = 0; m < device.memorySpaceDimensions.size(); m++) getFreeResources(h)[device.memorySpaceDimensions[m]] += device.freeMemory[m];
+      }
+  }
+
+  ~PackingMatcher() = default;
+
+  /**
+   * Packs a set of runners into the remaining capacity of the hosts. If not all of them fit, none is packed
+   *
+   * @param[in] requested The topologies requested by the runners
+   *
+   * @return If successful, a vector of size size(requested) containing the partition of each runner. Otherwise, an empty vector.
+   */
+  [[nodiscard]] __INLINE__ std::vector<partition_t> pack(const std::vector<HiCR::Topology> &requested)
+  {
+    // Grouping identical requests, and finding out their shape over the resource kinds of the hosts
+    std::vector<std::vector<size_t>> classes;
+    std::vector<requestShape_t>      shapes;
+    std::map<std::string, size_t>    classIndexes;
+    for (size_t i = 0; i < requested.size(); i++)
+    {
+      const auto [entry, isNewKey] = classIndexes.try_emplace(requested[i].serialize().dump(), classes.size());
+      if (isNewKey)
+      {
+        classes.emplace_back();
+        shapes.push_back(getShape(requested[i]));
+      }
+      classes[entry->second].push_back(i);
+    }
+
+    // Placing the largest classes first
+    std::vector<size_t> classOrder(classes.size());
+    std::iota(classOrder.begin(), classOrder.end(), 0);
+    const auto sizes = getNormalizedSizes(shapes);
+    std::stable_sort(classOrder.begin(), classOrder.end(), [&](const size_t a, const size_t b) { return sizes[a] > sizes[b]; });
+
+    // Placing every runner of each class on the first host that fits it. Since capacity only decreases, hosts that did not fit a class are not tried again for it
+    std::vector<partition_t> partitions(requested.size());
+    for (const auto c : classOrder)
+    {
+      size_t firstHostIdx = 0;
+      for (const auto runnerIdx : classes[c])
+      {
+        auto &partition = partitions[runnerIdx];
+        while (firstHostIdx < _hosts.size() && tryFit(firstHostIdx, shapes[c], partition) == false) firstHostIdx++;
+
+        // If a runner does not fit, giving back the resources of those already placed
+        if (firstHostIdx == _hosts.size())
+        {
+          for (auto &placed : partitions) release(placed);
+          return {};
+        }
+      }
+    }
+
+    return partitions;
+  }
+
+  /**
+   * Gives the resources of a partition back to its host, e.g., once its runner finishes
+   *
+   * @param[in] partition The partition, as returned by pack
+   */
+  __INLINE__ void release(partition_t &partition)
+  {
+    if (partition.computeResources.empty() && partition.memoryShares.empty()) return;
+
+    auto &host = _hosts[partition.hostIdx];
+    for (const auto &[deviceIdx, computeResourceIdx] : partition.computeResources)
+    {
+      host[deviceIdx].isComputeResourceFree[computeResourceIdx] = true;
+      getFreeResources(partition.hostIdx)[host[deviceIdx].computeResourceDimensions[computeResourceIdx]]++;
+    }
+    for (const auto &[deviceIdx, memorySpaceIdx, size] : partition.memoryShares)
+    {
+      host[deviceIdx].freeMemory[memorySpaceIdx] += size;
+      getFreeResources(partition.hostIdx)[host[deviceIdx].memorySpaceDimensions[memorySpaceIdx]] += size;
+    }
+    partition.computeResources.clear();
+    partition.memoryShares.clear();
+  }
+
+  /**
+   * Gets the number of free compute resources of a host
+   *
+   * @param[in] hostIdx The index of the host
+   *
+   * @return The number of compute resources not given out to any runner
+   */
+  [[nodiscard]] __INLINE__ size_t getFreeComputeResourceCount(const size_t hostIdx) const
+  {
+    size_t count = 0;
+    for (const auto &device : _hosts.at(hostIdx)) count += std::count(device.isComputeResourceFree.begin(), device.isComputeResourceFree.end(), true);
+    return count;
+  }
+
+  private:
+
+  /// Type for the indexes of the kinds of resources (compute resource type, or memory space type, per device type) found among the hosts
+  typedef uint32_t dimension_t;
+
+  /// Type for the indexes of the device types found among the hosts
+  typedef uint32_t deviceType_t;
+
+  /// Dimension or device type of the resources that no host has
+  static constexpr uint32_t unknown = std::numeric_limits<uint32_t>::max();
+
+  /**
+   * [Internal] The capacity of a host device
+   */
+  struct deviceCapacity_t
+  {
+    /// The type of the device
+    deviceType_t type;
+
+    /// The kind of each of its compute resources
+    std::vector<dimension_t> computeResourceDimensions;
+
+    /// Whether each of its compute resources is still free
+    std::vector<bool> isComputeResourceFree;
+
+    /// The kind of each of its memory spaces
+    std::vector<dimension_t> memorySpaceDimensions;
+
+    /// The free size of each of its memory spaces
+    std::vector<ResourceSignatures::counter_t> freeMemory;
+  };
+
+  /**
+   * [Internal] A requested device, over the resource kinds of the hosts
+   */
+  struct requestedDevice_t
+  {
+    /// The type of the device
+    deviceType_t type;
+
+    /// The kind of each of its compute resources
+    std::vector<dimension_t> computeResourceDimensions;
+
+    /// The kind and size of each of its memory spaces
+    std::vector<std::pair<dimension_t, ResourceSignatures::counter_t>> memorySpaces;
+  };
+
+  /**
+   * [Internal] A requested topology, over the resource kinds of the hosts
+   */
+  struct requestShape_t
+  {
+    /// The requested devices
+    std::vector<requestedDevice_t> devices;
+
+    /// The total amount requested of each resource kind
+    std::vector<ResourceSignatures::counter_t> totals;
+
+    /// Whether it requests a resource that no host has
+    bool isUnsatisfiable = false;
+  };
+
+  /**
+   * [Internal] Converts a requested topology into its shape over the resource kinds of the hosts
+   *
+   * @param[in] topology The requested topology
+   *
+   * @return The shape of the request
+   */
+  [[nodiscard]] __INLINE__ requestShape_t getShape(const HiCR::Topology &topology) const
+  {
+    requestShape_t shape;
+    shape.totals.assign(_dimensionNames.size(), 0);
+
+    for (const auto &device : topology.getDevices())
+    {
+      requestedDevice_t requestedDevice;
+      requestedDevice.type = findIndex(_deviceTypes, device->getType());
+      for (const auto &computeResource : device->getComputeResourceList())
+        requestedDevice.computeResourceDimensions.push_back(findIndex(_dimensionIndexes, "Compute Resources/" + device->getType() + "/" + computeResource->getType()));
+      for (const auto &memorySpace : device->getMemorySpaceList())
+        requestedDevice.memorySpaces.push_back({findIndex(_dimensionIndexes, "Memory Spaces/" + device->getType() + "/" + memorySpace->getType()), memorySpace->getSize()});
+
+      // Adding up the totals, noting whether any kind of resource is missing from all hosts. Empty memory spaces of a missing kind take nothing, and are skipped when placing
+      shape.isUnsatisfiable |= requestedDevice.type == unknown;
+      for (const auto dimension : requestedDevice.computeResourceDimensions)
+        if (dimension == unknown) shape.isUnsatisfiable = true;
+        else shape.totals[dimension]++;
+      for (const auto &[dimension, size] : requestedDevice.memorySpaces)
+        if (dimension == unknown) shape.isUnsatisfiable |= size > 0;
+        else shape.totals[dimension] += size;
+
+      shape.devices.push_back(std::move(requestedDevice));
+    }
+
+    return shape;
+  }
+
+  /**
+   * [Internal] Computes the size of each request, as the sum of the amounts of each resource kind it requests, normalized by the largest amount found among the hosts
+   *
+   * @param[in] shapes The shapes of the requests
+   *
+   * @return The size of each request
+   */
+  [[nodiscard]] __INLINE__ std::vector<double> getNormalizedSizes(const std::vector<requestShape_t> &shapes) const
+  {
+    std::vector<ResourceSignatures::counter_t> maxFree(_dimensionNames.size(), 0);
+    for (size_t h = 0; h < _hosts.size(); h++)
+      for (size_t d = 0; d < _dimensionNames.size(); d++) maxFree[d] = std::max(maxFree[d], getFreeResources(h)[d]);
+
+    std::vector<double> sizes(shapes.size(), 0.0);
+    for (size_t c = 0; c < shapes.size(); c++)
+      for (size_t d = 0; d < _dimensionNames.size(); d++)
+        if (maxFree[d] > 0) sizes[c] += (double)shapes[c].totals[d] / (double)maxFree[d];
+    return sizes;
+  }
+
+  /**
+   * [Internal] Places a request on a host, if it has enough free capacity, and takes its resources
+   *
+   * @param[in] hostIdx The index of the host
+   * @param[in] shape The shape of the request
+   * @param[out] partition The partition the taken resources are recorded in
+   *
+   * @return true, if the request was placed; false, otherwise
+   */
+  [[nodiscard]] __INLINE__ bool tryFit(const size_t hostIdx, const requestShape_t &shape, partition_t &partition)
+  {
+    if (shape.isUnsatisfiable) return false;
+
+    // Cheap necessary condition: the host has enough free resources of every kind in total
+    const auto freeResources = getFreeResources(hostIdx);
+    for (size_t d = 0; d < _dimensionNames.size(); d++)
+      if (freeResources[d] < shape.totals[d]) return false;
+
+    // Placing every requested device on a different host device
+    auto             &host = _hosts[hostIdx];
+    std::vector<bool> isDeviceUsed(host.size(), false);
+    partition.hostIdx = hostIdx;
+    for (const auto &requestedDevice : shape.devices)
+    {
+      bool isDeviceFound = false;
+      for (size_t i = 0; i < host.size() && isDeviceFound == false; i++)
+      {
+        if (isDeviceUsed[i] || host[i].type != requestedDevice.type) continue;
+        isDeviceFound   = tryFitDevice(hostIdx, i, requestedDevice, partition);
+        isDeviceUsed[i] = isDeviceFound;
+      }
+
+      if (isDeviceFound == false)
+      {
+        release(partition);
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * [Internal] Places a requested device on a host device, if it has enough free capacity, and takes its resources
+   *
+   * @param[in] hostIdx The index of the host
+   * @param[in] deviceIdx The index of the device, in the host
+   * @param[in] requestedDevice The requested device
+   * @param[out] partition The partition the taken resources are recorded in
+   *
+   * @return true, if the requested device was placed; false, otherwise, in which case no resources are taken
+   */
+  [[nodiscard]] __INLINE__ bool tryFitDevice(const size_t hostIdx, const size_t deviceIdx, const requestedDevice_t &requestedDevice, partition_t &partition)
+  {
+    auto &device = _hosts[hostIdx][deviceIdx];
+
+    // Taking the first free compute resource of each requested kind
+    const auto computeResourceCount = partition.computeResources.size();
+    const auto memoryShareCount     = partition.memoryShares.size();
+    bool       isFound              = true;
+    for (size_t r = 0; r < requestedDevice.computeResourceDimensions.size() && isFound; r++)
+    {
+      isFound = false;
+      for (size_t i = 0; i < device.computeResourceDimensions.size() && isFound == false; i++)
+        if (device.isComputeResourceFree[i] && device.computeResourceDimensions[i] == requestedDevice.computeResourceDimensions[r])
+        {
+          device.isComputeResourceFree[i] = false;
+          getFreeResources(hostIdx)[device.computeResourceDimensions[i]]--;
+          partition.computeResources.push_back({deviceIdx, i});
+          isFound = true;
+        }
+    }
+
+    // Taking each requested size from the first memory space of its kind with enough free memory
+    for (size_t m = 0; m < requestedDevice.memorySpaces.size() && isFound; m++)
+    {
+      const auto &[dimension, size] = requestedDevice.memorySpaces[m];
+      if (dimension == unknown) continue;
+      isFound = false;
+      for (size_t i = 0; i < device.memorySpaceDimensions.size() && isFound == false; i++)
+        if (device.memorySpaceDimensions[i] == dimension && device.freeMemory[i] >= size)
+        {
+          device.freeMemory[i] -= size;
+          getFreeResources(hostIdx)[dimension] -= size;
+          partition.memoryShares.push_back({deviceIdx, i, size});
+          isFound = true;
+        }
+    }
+    if (isFound) return true;
+
+    // Otherwise, giving back what was taken from this device
+    partition_t devicePartition{hostIdx, {}, {}};
+    devicePartition.computeResources.assign(partition.computeResources.begin() + computeResourceCount, partition.computeResources.end());
+    devicePartition.memoryShares.assign(partition.memoryShares.begin() + memoryShareCount, partition.memoryShares.end());
+    release(devicePartition);
+    partition.computeResources.resize(computeResourceCount);
+    partition.memoryShares.resize(memoryShareCount);
+    return false;
+  }
+
+  /**
+   * [Internal] Gets the free amount of each resource kind of a host
+   *
+   * @param[in] hostIdx The index of the host
+   *
+   * @return A pointer to the free amounts, indexed by resource kind
+   */
+  [[nodiscard]] __INLINE__ ResourceSignatures::counter_t *getFreeResources(const size_t hostIdx) { return &_freeResources[hostIdx * _dimensionNames.size()]; }
+
+  /**
+   * [Internal] Gets the free amount of each resource kind of a host, for reading
+   *
+   * @param[in] hostIdx The index of the host
+   *
+   * @return A pointer to the free amounts, indexed by resource kind
+   */
+  [[nodiscard]] __INLINE__ const ResourceSignatures::counter_t *getFreeResources(const size_t hostIdx) const { return &_freeResources[hostIdx * _dimensionNames.size()]; }
+
+  /**
+   * [Internal] Gets the index of a resource kind, adding it if not found yet
+   *
+   * @param[in] name The name of the resource kind
+   *
+   * @return The index of the resource kind
+   */
+  __INLINE__ dimension_t internDimension(const std::string &name)
+  {
+    const auto [entry, isNew] = _dimensionIndexes.try_emplace(name, (dimension_t)_dimensionNames.size());
+    if (isNew) _dimensionNames.push_back(name);
+    return entry->second;
+  }
+
+  /**
+   * [Internal] Gets the index of a device type, adding it if not found yet
+   *
+   * @param[in] type The device type
+   *
+   * @return The index of the device type
+   */
+  __INLINE__ deviceType_t internDeviceType(const std::string &type) { return _deviceTypes.try_emplace(type, (deviceType_t)_deviceTypes.size()).first->second; }
+
+  /**
+   * [Internal] Looks up a name in an index
+   *
+   * @param[in] index The index to look up
+   * @param[in] name The name to find
+   *
+   * @return The index of the name, or unknown if not found
+   */
+  [[nodiscard]] __INLINE__ static uint32_t findIndex(const std::map<std::string, uint32_t> &index, const std::string &name)
+  {
+    const auto entry = index.find(name);
+    return entry == index.end() ? unknown : entry->second;
+  }
+
+  /// The capacity of each device of each host
+  std::vector<std::vector<deviceCapacity_t>> _hosts;
+
+  /// The free amount of each resource kind of each host, row-major
+  std::vector<ResourceSignatures::counter_t> _freeResources;
+
+  /// The name of each resource kind found among the hosts
+  std::vector<std::string> _dimensionNames;
+
+  /// The index of each resource kind, by name
+  std::map<std::string, dimension_t> _dimensionIndexes;
+
+  /// The index of each device type found among the hosts
+  std::map<std::string, deviceType_t> _deviceTypes;
+
+}; // class PackingMatcher
+
+} // namespace deployr
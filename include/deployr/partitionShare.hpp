@@ -0,0 +1,175 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/instance.hpp>
+#include <hicr/core/topology.hpp>
+#include <nlohmann_json/json.hpp>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "deployment.hpp"
+#include "runner.hpp"
+
+namespace deployr
+{
+
+/**
+ * The runners of a hierarchical deployment (see DeployR::deployHierarchical) assigned to one of its partitions, as sent by the global coordinator to the coordinator of the partition.
+ *
+ * Each runner keeps its id, initial function, requested topology and payload, but not its host, which the partition coordinator decides by matching the share to
+ * the hosts of its partition. The requested topologies are held once per share, and the payloads travel inline as binary, so the share is meant to be encoded as CBOR.
+ */
+class PartitionShare final
+{
+  public:
+
+  PartitionShare() = delete;
+
+  /**
+   * Deserializing constructor for the partition share
+   *
+   * @param[in] serializedShare The share, as produced by serialize
+   */
+  PartitionShare(nlohmann::json serializedShare)
+    : _share(std::move(serializedShare))
+  {}
+
+  ~PartitionShare() = default;
+
+  /**
+   * Splits the runners of a deployment into the shares of the partitions they were assigned to. Each requested topology is serialized once for all shares
+   *
+   * @param[in] deployment The runners, each with its requested topology
+   * @param[in] runnerPartitions The index of the partition of each runner. Empty if no runner was assigned, in which case every share is empty
+   * @param[in] partitionCount The number of partitions
+   * @param[in] launchMode The launch mode for the partition coordinators to start their runners with (see DeployR::launchMode_t)
+   *
+   * @return The share of each partition
+   */
+  [[nodiscard]] __INLINE__ static std::vector<PartitionShare> split(const Deployment          &deployment,
+                                                                    const std::vector<size_t> &runnerPartitions,
+                                                                    const size_t               partitionCount,
+                                                                    const int                  launchMode)
+  {
+    std::vector<PartitionShare> shares;
+    shares.reserve(partitionCount);
+    for (size_t p = 0; p < partitionCount; p++)
+      shares.push_back(
+        PartitionShare({{"Launch Mode", launchMode}, {"Functions", deployment.getFunctions()}, {"Topologies", nlohmann::json::array()}, {"Runners", nlohmann::json::array()}}));
+
+    const auto                                                                            &runnerIds    = deployment.getRunnerIds();
+    const auto                                                                            &functionIdxs = deployment.getFunctionIdxs();
+    const auto                                                                            &topologyIdxs = deployment.getTopologyIdxs();
+    std::vector<nlohmann::json>                                                            serializedTopologies(deployment.getTopologies().size());
+    std::vector<std::unordered_map<Deployment::topologyIdx_t, Deployment::topologyIdx_t>> shareTopologyIdxs(partitionCount);
+    for (size_t i = 0; i < runnerPartitions.size(); i++)
+    {
+      const auto partitionIdx = runnerPartitions[i];
+      auto      &share        = shares[partitionIdx]._share;
+
+      // Adding the requested topology to the share the first time one of its runners needs it
+      const auto [entry, isNewTopology] = shareTopologyIdxs[partitionIdx].try_emplace(topologyIdxs[i], (Deployment::topologyIdx_t)share["Topologies"].size());
+      if (isNewTopology)
+      {
+        auto &serializedTopology = serializedTopologies[topologyIdxs[i]];
+        if (serializedTopology.is_null()) serializedTopology = deployment.getTopologies()[topologyIdxs[i]].serialize();
+        share["Topologies"].push_back(serializedTopology);
+      }
+
+      share["Runners"].push_back({runnerIds[i], functionIdxs[i], entry->second});
+      const auto &payload = deployment.getPayload(i);
+      if (payload.size > 0) share["Runners"].back().push_back(nlohmann::json::binary(std::vector<uint8_t>(payload.data.get(), payload.data.get() + payload.size)));
+    }
+
+    return shares;
+  }
+
+  /**
+   * Serializes the share
+   *
+   * @return The serialized share
+   */
+  [[nodiscard]] __INLINE__ const nlohmann::json &serialize() const { return _share; }
+
+  /**
+   * Gets the launch mode for the partition coordinator to start the runners with
+   *
+   * @return The launch mode (see DeployR::launchMode_t)
+   */
+  [[nodiscard]] __INLINE__ int getLaunchMode() const { return _share["Launch Mode"].get<int>(); }
+
+  /**
+   * Gets the number of runners in the share
+   *
+   * @return The number of runners
+   */
+  [[nodiscard]] __INLINE__ size_t getRunnerCount() const { return _share["Runners"].size(); }
+
+  /**
+   * Gets the ids of the runners in the share
+   *
+   * @return The id of each runner
+   */
+  [[nodiscard]] __INLINE__ std::vector<Runner::runnerId_t> getRunnerIds() const
+  {
+    std::vector<Runner::runnerId_t> runnerIds;
+    runnerIds.reserve(getRunnerCount());
+    for (const auto &runner : _share["Runners"]) runnerIds.push_back(runner[0].get<Runner::runnerId_t>());
+    return runnerIds;
+  }
+
+  /**
+   * Gets the topology requested by each runner in the share, for the partition coordinator to match them to its hosts
+   *
+   * @return The requested topology of each runner
+   */
+  [[nodiscard]] __INLINE__ std::vector<HiCR::Topology> getRequestedTopologies() const
+  {
+    std::vector<HiCR::Topology> shareTopologies;
+    for (const auto &topology : _share["Topologies"]) shareTopologies.push_back(HiCR::Topology(topology));
+
+    std::vector<HiCR::Topology> requestedTopologies;
+    requestedTopologies.reserve(getRunnerCount());
+    for (const auto &runner : _share["Runners"]) requestedTopologies.push_back(shareTopologies[runner[2].get<Deployment::topologyIdx_t>()]);
+    return requestedTopologies;
+  }
+
+  /**
+   * Creates the deployment of the share, once its runners are matched to the hosts of the partition
+   *
+   * @param[in] instanceIds The id of the host of each runner
+   *
+   * @return The deployment
+   */
+  [[nodiscard]] __INLINE__ Deployment createDeployment(const std::vector<HiCR::Instance::instanceId_t> &instanceIds) const
+  {
+    const auto &functions = _share["Functions"];
+    const auto &runners   = _share["Runners"];
+    if (instanceIds.size() != runners.size())
+      HICR_THROW_LOGIC("[DeployR] A partition share needs one host per runner, but %lu were given for %lu runners.\n", instanceIds.size(), runners.size());
+
+    Deployment deployment;
+    for (const auto &topology : _share["Topologies"]) deployment.addTopology(HiCR::Topology(topology));
+    deployment.reserve(runners.size());
+    for (size_t i = 0; i < runners.size(); i++)
+    {
+      const auto &runner = runners[i];
+      deployment.emplaceRunner(runner[0].get<Runner::runnerId_t>(),
+                               functions[runner[1].get<Deployment::functionIdx_t>()].get<std::string>(),
+                               instanceIds[i],
+                               runner[2].get<Deployment::topologyIdx_t>());
+      if (runner.size() > 3) deployment.setPayload(i, Runner::createPayload(std::string(runner[3].get_binary().begin(), runner[3].get_binary().end())));
+    }
+    return deployment;
+  }
+
+  private:
+
+  /// The share, in its serialized form
+  nlohmann::json _share;
+
+}; // class PartitionShare
+
+} // namespace deployr
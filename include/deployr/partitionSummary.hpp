@@ -0,0 +1,109 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/topology.hpp>
+#include <nlohmann_json/json.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace deployr
+{
+
+/**
+ * Summarizes the hosts of a partition of a hierarchical deployment (see DeployR::deployHierarchical), as sent by its coordinator to the global coordinator.
+ *
+ * Identical host topologies are grouped into classes, and only one topology per class is kept, along with the number of hosts in it.
+ * For partitions of a few host types, the summary is nearly independent of the number of hosts, so the global coordinator never holds the topology of every host.
+ */
+class PartitionSummary final
+{
+  public:
+
+  /**
+   * Creates the summary of a partition without hosts
+   */
+  PartitionSummary() = default;
+
+  /**
+   * Constructor for the partition summary
+   *
+   * @param[in] topologies The topology of each class of identical hosts
+   * @param[in] hostCounts The number of hosts in each class
+   */
+  PartitionSummary(std::vector<HiCR::Topology> topologies, std::vector<size_t> hostCounts)
+    : _topologies(std::move(topologies)),
+      _hostCounts(std::move(hostCounts))
+  {
+    if (_topologies.size() != _hostCounts.size())
+      HICR_THROW_LOGIC("[DeployR] A partition summary needs one host count per topology, but %lu were given for %lu topologies.\n", _hostCounts.size(), _topologies.size());
+  }
+
+  /**
+   * Deserializing constructor for the partition summary
+   *
+   * @param[in] serializedSummary The summary, as produced by serialize
+   */
+  PartitionSummary(const nlohmann::json &serializedSummary)
+  {
+    for (const auto &hostClass : serializedSummary["Classes"])
+    {
+      _topologies.push_back(HiCR::Topology(hostClass["Topology"]));
+      _hostCounts.push_back(hostClass["Host Count"].get<size_t>());
+    }
+  }
+
+  ~PartitionSummary() = default;
+
+  /**
+   * Serializes the summary
+   *
+   * @return The JSON-encoded summary
+   */
+  [[nodiscard]] __INLINE__ nlohmann::json serialize() const
+  {
+    auto classes = nlohmann::json::array();
+    for (size_t i = 0; i < _topologies.size(); i++) classes.push_back({{"Topology", _topologies[i].serialize()}, {"Host Count", _hostCounts[i]}});
+
+    nlohmann::json serializedSummary;
+    serializedSummary["Classes"] = std::move(classes);
+    return serializedSummary;
+  }
+
+  /**
+   * Gets the topology of each class of identical hosts
+   *
+   * @return The topologies, one per class
+   */
+  [[nodiscard]] __INLINE__ const std::vector<HiCR::Topology> &getTopologies() const { return _topologies; }
+
+  /**
+   * Gets the number of hosts in each class
+   *
+   * @return The host counts, indexed like getTopologies
+   */
+  [[nodiscard]] __INLINE__ const std::vector<size_t> &getHostCounts() const { return _hostCounts; }
+
+  /**
+   * Gets the total number of hosts in the partition
+   *
+   * @return The sum of the host counts of all classes
+   */
+  [[nodiscard]] __INLINE__ size_t getHostCount() const
+  {
+    size_t hostCount = 0;
+    for (const auto count : _hostCounts) hostCount += count;
+    return hostCount;
+  }
+
+  private:
+
+  /// The topology of each class of identical hosts
+  std::vector<HiCR::Topology> _topologies;
+
+  /// The number of hosts in each class
+  std::vector<size_t> _hostCounts;
+
+}; // class PartitionSummary
+
+} // namespace deployr
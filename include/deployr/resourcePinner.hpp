@@ -0,0 +1,240 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/topology.hpp>
+#include <hicr/backends/hwloc/computeResource.hpp>
+#include <pthread.h>
+#include <sched.h>
+#include <memory>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+namespace deployr
+{
+
+/**
+ * Finds out which concrete compute resources and memory spaces of a host satisfy the topologies requested by the runners assigned to it, so that they can be pinned to them.
+ *
+ * A placement is found with the same rules as HiCR::Topology::isSubset (see Host::checkCompatibility). The requested devices are checked in order, and each takes the first
+ * host device of the same type that contains all of its compute resources (by type) and memory spaces (by type, with at least the requested size).
+ * Within a request, a host device satisfies a single requested device, as in isSubset. Across the runners of a host, compute resources are given out exclusively while
+ * there are enough of them, and shared round-robin otherwise. Memory spaces are always shared.
+ */
+class ResourcePinner final
+{
+  public:
+
+  /**
+   * The resources of the host assigned to a runner
+   */
+  struct placement_t
+  {
+    /// The compute resources matched to the requested ones, in the order they were requested
+    std::vector<std::shared_ptr<HiCR::ComputeResource>> computeResources;
+
+    /// The memory spaces matched to the requested ones, in the order they were requested
+    std::vector<std::shared_ptr<HiCR::MemorySpace>> memorySpaces;
+  };
+
+  ResourcePinner() = delete;
+
+  /**
+   * Constructor for the resource pinner
+   *
+   * @param[in] hostTopology The topology of the host. Must outlive the resource pinner
+   */
+  ResourcePinner(const HiCR::Topology &hostTopology)
+    : _hostTopology(hostTopology)
+  {}
+
+  ~ResourcePinner() = default;
+
+  /**
+   * Finds the resources of the host for a requested topology, preferring compute resources not given to any previous request.
+   *
+   * Once the request no longer fits in the compute resources still free, a new round starts, in which all of them are given out again in the same order.
+   * The runners beyond the host's capacity are thus spread over its compute resources, rather than all sharing the first ones
+   *
+   * @param[in] requestedTopology The topology requested by the runner
+   *
+   * @return The placement of the runner, or nothing if the host does not satisfy the requested topology
+   */
+  [[nodiscard]] __INLINE__ std::optional<placement_t> pin(const HiCR::Topology &requestedTopology)
+  {
+    // Trying with the compute resources still free first, and starting a new round otherwise
+    auto placement = findPlacement(requestedTopology, _pinnedComputeResources);
+    if (placement.has_value() == false && _pinnedComputeResources.empty() == false)
+    {
+      placement = findPlacement(requestedTopology, {});
+      if (placement.has_value()) _pinnedComputeResources.clear();
+    }
+    if (placement.has_value() == false) return std::nullopt;
+
+    for (const auto &computeResource : placement->computeResources) _pinnedComputeResources.insert(computeResource.get());
+    return placement;
+  }
+
+  /**
+   * Binds the calling thread to the processors of a placement. Compute resources that are not hwloc processors (e.g., accelerators) are not bound to.
+   *
+   * Memory is then allocated on first touch by the calling thread, by default on the NUMA domain of those processors, which is the host device the matched memory spaces belong to.
+   *
+   * @param[in] placement The placement to bind to. If it has no processors, the affinity of the calling thread is not changed
+   */
+  __INLINE__ static void bindCurrentThread(const placement_t &placement)
+  {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    size_t processorCount = 0;
+    for (const auto &computeResource : placement.computeResources)
+    {
+      const auto processor = dynamic_cast<const HiCR::backend::hwloc::ComputeResource *>(computeResource.get());
+      if (processor == nullptr) continue;
+      CPU_SET(processor->getProcessorId(), &cpuSet);
+      processorCount++;
+    }
+    if (processorCount == 0) return;
+
+    const auto status = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+    if (status != 0) HICR_THROW_RUNTIME("[DeployR] Could not bind a runner to its %lu matched processors (error %d).\n", processorCount, status);
+  }
+
+  /**
+   * Gets the processors the calling thread may run on, e.g., to restore them after binding it with bindCurrentThread
+   *
+   * @return The affinity of the calling thread
+   */
+  [[nodiscard]] __INLINE__ static cpu_set_t getCurrentThreadAffinity()
+  {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    const auto status = pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+    if (status != 0) HICR_THROW_RUNTIME("[DeployR] Could not get the affinity of the calling thread (error %d).\n", status);
+    return cpuSet;
+  }
+
+  /**
+   * Sets the processors the calling thread may run on
+   *
+   * @param[in] cpuSet The affinity of the calling thread, as returned by getCurrentThreadAffinity
+   */
+  __INLINE__ static void setCurrentThreadAffinity(const cpu_set_t &cpuSet)
+  {
+    const auto status = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+    if (status != 0) HICR_THROW_RUNTIME("[DeployR] Could not restore the affinity of the calling thread (error %d).\n", status);
+  }
+
+  private:
+
+  /**
+   * [Internal] Finds the resources of the host for a requested topology, following the rules of HiCR::Topology::isSubset
+   *
+   * @param[in] requestedTopology The topology requested by the runner
+   * @param[in] excludedComputeResources The compute resources of the host not to use
+   *
+   * @return The placement of the runner, or nothing if it is not found
+   */
+  [[nodiscard]] __INLINE__ std::optional<placement_t> findPlacement(const HiCR::Topology                           &requestedTopology,
+                                                                    const std::unordered_set<HiCR::ComputeResource *> &excludedComputeResources) const
+  {
+    placement_t placement;
+
+    const auto       &hostDevices = _hostTopology.getDevices();
+    std::vector<bool> isDeviceUsed(hostDevices.size(), false);
+    for (const auto &requestedDevice : requestedTopology.getDevices())
+    {
+      bool isDeviceFound = false;
+      for (size_t i = 0; i < hostDevices.size() && isDeviceFound == false; i++)
+      {
+        if (isDeviceUsed[i] || hostDevices[i]->getType() != requestedDevice->getType()) continue;
+
+        // Matching every requested resource of the device, or none of them
+        placement_t devicePlacement;
+        if (matchComputeResources(*requestedDevice, *hostDevices[i], excludedComputeResources, devicePlacement) == false) continue;
+        if (matchMemorySpaces(*requestedDevice, *hostDevices[i], devicePlacement) == false) continue;
+
+        placement.computeResources.insert(placement.computeResources.end(), devicePlacement.computeResources.begin(), devicePlacement.computeResources.end());
+        placement.memorySpaces.insert(placement.memorySpaces.end(), devicePlacement.memorySpaces.begin(), devicePlacement.memorySpaces.end());
+        isDeviceUsed[i] = true;
+        isDeviceFound   = true;
+      }
+
+      if (isDeviceFound == false) return std::nullopt;
+    }
+
+    return placement;
+  }
+
+  /**
+   * [Internal] Matches each requested compute resource of a device to the first compute resource of the same type of a host device not matched yet
+   *
+   * @param[in] requestedDevice The requested device
+   * @param[in] hostDevice The host device
+   * @param[in] excludedComputeResources The compute resources of the host not to use
+   * @param[out] placement The placement the matched compute resources are added to
+   *
+   * @return true, if every requested compute resource was matched; false, otherwise
+   */
+  [[nodiscard]] __INLINE__ static bool matchComputeResources(const HiCR::Device                                &requestedDevice,
+                                                             const HiCR::Device                                &hostDevice,
+                                                             const std::unordered_set<HiCR::ComputeResource *> &excludedComputeResources,
+                                                             placement_t                                       &placement)
+  {
+    const auto       &hostComputeResources = hostDevice.getComputeResourceList();
+    std::vector<bool> isMatched(hostComputeResources.size(), false);
+    for (const auto &requestedComputeResource : requestedDevice.getComputeResourceList())
+    {
+      bool isFound = false;
+      for (size_t i = 0; i < hostComputeResources.size() && isFound == false; i++)
+      {
+        if (isMatched[i] || excludedComputeResources.contains(hostComputeResources[i].get())) continue;
+        if (hostComputeResources[i]->getType() != requestedComputeResource->getType()) continue;
+        placement.computeResources.push_back(hostComputeResources[i]);
+        isMatched[i] = true;
+        isFound      = true;
+      }
+      if (isFound == false) return false;
+    }
+    return true;
+  }
+
+  /**
+   * [Internal] Matches each requested memory space of a device to the first memory space of the same type and at least the same size of a host device not matched yet
+   *
+   * @param[in] requestedDevice The requested device
+   * @param[in] hostDevice The host device
+   * @param[out] placement The placement the matched memory spaces are added to
+   *
+   * @return true, if every requested memory space was matched; false, otherwise
+   */
+  [[nodiscard]] __INLINE__ static bool matchMemorySpaces(const HiCR::Device &requestedDevice, const HiCR::Device &hostDevice, placement_t &placement)
+  {
+    const auto       &hostMemorySpaces = hostDevice.getMemorySpaceList();
+    std::vector<bool> isMatched(hostMemorySpaces.size(), false);
+    for (const auto &requestedMemorySpace : requestedDevice.getMemorySpaceList())
+    {
+      bool isFound = false;
+      for (size_t i = 0; i < hostMemorySpaces.size() && isFound == false; i++)
+      {
+        if (isMatched[i] || hostMemorySpaces[i]->getType() != requestedMemorySpace->getType()) continue;
+        if (hostMemorySpaces[i]->getSize() < requestedMemorySpace->getSize()) continue;
+        placement.memorySpaces.push_back(hostMemorySpaces[i]);
+        isMatched[i] = true;
+        isFound      = true;
+      }
+      if (isFound == false) return false;
+    }
+    return true;
+  }
+
+  /// The topology of the host
+  const HiCR::Topology &_hostTopology;
+
+  /// The compute resources given to the previous requests
+  std::unordered_set<HiCR::ComputeResource *> _pinnedComputeResources;
+
+}; // class ResourcePinner
+
+} // namespace deployr
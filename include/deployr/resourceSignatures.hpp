@@ -0,0 +1,193 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/topology.hpp>
+#include <algorithm>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace deployr
+{
+
+/**
+ * Canonicalizes a set of requested and given topologies into compact resource-count signatures.
+ *
+ * A signature is a dense vector of counters over the same list of dimensions for all topologies:
+ * the number of devices of each type, the number of compute resources of each type per device type, and the size of the largest memory space of each type per device type.
+ *
+ * A given topology that contains a requested one has at least as many devices and compute resources of every kind, and, since every requested memory space must fit within a single given memory space of the same type,
+ * its largest memory space of every kind is at least as large as the requested one. Memory sizes are deliberately not added up, as a given memory space may satisfy several requested ones.
+ * Comparing signatures thus provides a cheap necessary condition for HiCR::Topology::isSubset.
+ */
+class ResourceSignatures final
+{
+  public:
+
+  /// Type for each of the signature counters
+  typedef uint64_t counter_t;
+
+  ResourceSignatures() = delete;
+
+  /**
+   * Constructor for the resource signatures. Builds the signatures of all requested and given topologies over a common set of dimensions
+   *
+   * @param[in] requested The requested topologies
+   * @param[in] given The given (existing) topologies
+   */
+  ResourceSignatures(const std::vector<HiCR::Topology> &requested, const std::vector<HiCR::Topology> &given)
+    : _requestedCount(requested.size()),
+      _givenCount(given.size())
+  {
+    // Counting the resources of every topology
+    std::vector<std::map<std::string, counter_t>> requestedCounts, givenCounts;
+    for (const auto &topology : requested) requestedCounts.push_back(countResources(topology));
+    for (const auto &topology : given) givenCounts.push_back(countResources(topology));
+
+    // Assigning an index to every dimension found
+    std::map<std::string, size_t> dimensionIndexes;
+    for (const auto &counts : {&requestedCounts, &givenCounts})
+      for (const auto &topologyCounts : *counts)
+        for (const auto &[dimension, count] : topologyCounts)
+          if (dimensionIndexes.contains(dimension) == false)
+          {
+            dimensionIndexes[dimension] = _dimensions.size();
+            _dimensions.push_back(dimension);
+          }
+
+    // Filling in the dense signatures
+    _requested = flatten(requestedCounts, dimensionIndexes);
+    _given     = flatten(givenCounts, dimensionIndexes);
+  }
+
+  ~ResourceSignatures() = default;
+
+  /**
+   * Checks whether the given topology has at least as many resources of every kind as the requested one.
+   *
+   * This is a necessary (but not sufficient) condition for the given topology to be a superset of the requested one.
+   *
+   * @param[in] requestedIdx The index of the requested topology
+   * @param[in] givenIdx The index of the given topology
+   *
+   * @return true, if the given topology may contain the requested one; false, if it certainly does not.
+   */
+  [[nodiscard]] __INLINE__ bool mayContain(const size_t requestedIdx, const size_t givenIdx) const
+  {
+    const auto requestedSignature = getRequestedSignature(requestedIdx);
+    const auto givenSignature     = getGivenSignature(givenIdx);
+
+    // Branch-free comparison over all dimensions, so that the compiler can vectorize it
+    bool fits = true;
+    for (size_t d = 0; d < _dimensions.size(); d++) fits &= givenSignature[d] >= requestedSignature[d];
+    return fits;
+  }
+
+  /**
+   * Gets the signature of a requested topology
+   *
+   * @param[in] requestedIdx The index of the requested topology
+   *
+   * @return The counters of the requested topology, one per dimension
+   */
+  [[nodiscard]] __INLINE__ std::span<const counter_t> getRequestedSignature(const size_t requestedIdx) const
+  {
+    return std::span<const counter_t>(_requested.data() + requestedIdx * _dimensions.size(), _dimensions.size());
+  }
+
+  /**
+   * Gets the signature of a given topology
+   *
+   * @param[in] givenIdx The index of the given topology
+   *
+   * @return The counters of the given topology, one per dimension
+   */
+  [[nodiscard]] __INLINE__ std::span<const counter_t> getGivenSignature(const size_t givenIdx) const
+  {
+    return std::span<const counter_t>(_given.data() + givenIdx * _dimensions.size(), _dimensions.size());
+  }
+
+  /**
+   * Gets the names of the signature dimensions, in the order they appear in the signatures
+   *
+   * @return The names of the dimensions
+   */
+  [[nodiscard]] __INLINE__ const std::vector<std::string> &getDimensions() const { return _dimensions; }
+
+  /**
+   * Gets the number of requested topologies
+   *
+   * @return The number of requested topologies
+   */
+  [[nodiscard]] __INLINE__ size_t getRequestedCount() const { return _requestedCount; }
+
+  /**
+   * Gets the number of given topologies
+   *
+   * @return The number of given topologies
+   */
+  [[nodiscard]] __INLINE__ size_t getGivenCount() const { return _givenCount; }
+
+  /**
+   * Counts the resources of a topology, by kind. For memory spaces, the count is the size of the largest one of each kind
+   *
+   * @param[in] topology The topology to count the resources of
+   *
+   * @return A map from resource kind to its count in the topology
+   */
+  [[nodiscard]] __INLINE__ static std::map<std::string, counter_t> countResources(const HiCR::Topology &topology)
+  {
+    std::map<std::string, counter_t> counts;
+
+    for (const auto &device : topology.getDevices())
+    {
+      const auto deviceType = device->getType();
+      counts["Devices/" + deviceType]++;
+      for (const auto &computeResource : device->getComputeResourceList()) counts["Compute Resources/" + deviceType + "/" + computeResource->getType()]++;
+      for (const auto &memorySpace : device->getMemorySpaceList())
+      {
+        auto &largestSize = counts["Largest Memory Space/" + deviceType + "/" + memorySpace->getType()];
+        largestSize       = std::max(largestSize, (counter_t)memorySpace->getSize());
+      }
+    }
+
+    return counts;
+  }
+
+  private:
+
+  /**
+   * [Internal] Converts a set of resource count maps into a dense, row-major signature matrix
+   *
+   * @param[in] counts The resource counts of each topology
+   * @param[in] dimensionIndexes The index of each dimension in the signatures
+   *
+   * @return The signature matrix
+   */
+  [[nodiscard]] __INLINE__ std::vector<counter_t> flatten(const std::vector<std::map<std::string, counter_t>> &counts, const std::map<std::string, size_t> &dimensionIndexes) const
+  {
+    std::vector<counter_t> signatures(counts.size() * _dimensions.size(), 0);
+    for (size_t i = 0; i < counts.size(); i++)
+      for (const auto &[dimension, count] : counts[i]) signatures[i * _dimensions.size() + dimensionIndexes.at(dimension)] = count;
+    return signatures;
+  }
+
+  /// Number of requested topologies
+  const size_t _requestedCount;
+
+  /// Number of given topologies
+  const size_t _givenCount;
+
+  /// Name of each signature dimension
+  std::vector<std::string> _dimensions;
+
+  /// Row-major signatures of the requested topologies
+  std::vector<counter_t> _requested;
+
+  /// Row-major signatures of the given topologies
+  std::vector<counter_t> _given;
+
+}; // class ResourceSignatures
+
+} // namespace deployr
@@ -1,5 +1,12 @@
 #pragma once
 
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/localMemorySlot.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
 namespace deployr
 {
 
@@ -12,6 +19,43 @@ class Runner
 
   typedef uint64_t runnerId_t;
 
+  /**
+   * An opaque binary payload delivered to a runner along with its launch (e.g., its configuration or input shard)
+   */
+  struct payload_t
+  {
+    /// The start of the payload. It keeps the memory it points to alive
+    std::shared_ptr<const uint8_t> data;
+
+    /// The size of the payload, in bytes
+    size_t size = 0;
+  };
+
+  /**
+   * Creates a payload that owns a copy of its contents
+   * 
+   * @param[in] bytes The contents of the payload
+   * 
+   * @return The payload
+   */
+  [[nodiscard]] __INLINE__ static payload_t createPayload(std::string bytes)
+  {
+    const auto buffer = std::make_shared<const std::string>(std::move(bytes));
+    return {std::shared_ptr<const uint8_t>(buffer, (const uint8_t *)buffer->data()), buffer->size()};
+  }
+
+  /**
+   * Creates a payload that refers to the contents of a memory slot, without copying them. The memory slot is kept alive as long as the payload is
+   * 
+   * @param[in] memorySlot The memory slot holding the contents of the payload. Its memory must not be freed while the payload is in use
+   * 
+   * @return The payload
+   */
+  [[nodiscard]] __INLINE__ static payload_t createPayload(const std::shared_ptr<HiCR::LocalMemorySlot> &memorySlot)
+  {
+    return {std::shared_ptr<const uint8_t>(memorySlot, (const uint8_t *)memorySlot->getPointer()), memorySlot->getSize()};
+  }
+
   Runner()  = delete;
   ~Runner() = default;
 
@@ -19,18 +63,36 @@ class Runner
     * Deserializing constructor for the Runner class
     * 
     */
-  Runner(const runnerId_t id, const std::string &function, const HiCR::Instance::instanceId_t instanceId)
+  Runner(const runnerId_t id, std::string function, const HiCR::Instance::instanceId_t instanceId)
+    : Runner(id, std::move(function), instanceId, payload_t())
+  {}
+
+  /**
+    * Constructor for a runner that carries a payload
+    * 
+    * @param[in] id The id of the runner
+    * @param[in] function The name of its initial function
+    * @param[in] instanceId The id of the HiCR instance assigned to it
+    * @param[in] payload The payload delivered to it at launch
+    */
+  Runner(const runnerId_t id, std::string function, const HiCR::Instance::instanceId_t instanceId, payload_t payload)
     : _id(id),
-      _function(function),
-      _instanceId(instanceId)
+      _function(std::move(function)),
+      _instanceId(instanceId),
+      _payload(std::move(payload))
   {}
 
+  Runner(const Runner &)            = default;
+  Runner(Runner &&)                 = default;
+  Runner &operator=(const Runner &) = default;
+  Runner &operator=(Runner &&)      = default;
+
   /**
      * Gets the numerical id of the instance, as provided by the user
      * 
      * @return the id of the instance
      */
-  [[nodiscard]] __INLINE__ const runnerId_t getId() const { return _id; }
+  [[nodiscard]] __INLINE__ runnerId_t getId() const { return _id; }
 
   /**
      * Gets the initial function for this instance
@@ -44,18 +106,28 @@ class Runner
      * 
      * @return the topology required by this instance
      */
-  [[nodiscard]] __INLINE__ const HiCR::Instance::instanceId_t getInstanceId() const { return _instanceId; }
+  [[nodiscard]] __INLINE__ HiCR::Instance::instanceId_t getInstanceId() const { return _instanceId; }
+
+  /**
+     * Gets the payload delivered to this runner at launch
+     * 
+     * @return the payload of this runner, empty if none
+     */
+  [[nodiscard]] __INLINE__ const payload_t &getPayload() const { return _payload; }
 
   private:
 
   /// Id assigned to this runner
-  const runnerId_t _id;
+  runnerId_t _id;
 
   /// Function for this run to run as it is deployed
-  const std::string _function;
+  std::string _function;
 
   /// HiCR instance id assigned to this runner
-  const HiCR::Instance::instanceId_t _instanceId;
+  HiCR::Instance::instanceId_t _instanceId;
+
+  /// Payload delivered to this runner at launch
+  payload_t _payload;
 
 }; // class Runner
 
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/core/instance.hpp>
+#include <hicr/core/topology.hpp>
+#include <nlohmann_json/json.hpp>
+#include <map>
+#include <string>
+
+namespace deployr
+{
+
+/**
+ * Remembers the last known topology of each remote instance, together with a fingerprint of its contents.
+ *
+ * It allows the root to re-gather topologies by exchanging only fingerprints, fetching the full topology only from those instances whose fingerprint changed.
+ */
+class TopologyCache final
+{
+  public:
+
+  /// Type for topology fingerprints. Only the lower 56 bits are used, so that they fit in an RPC argument alongside the wire format encoding
+  typedef uint64_t fingerprint_t;
+
+  /// Fingerprint value reserved to indicate that no topology is known
+  static constexpr fingerprint_t noFingerprint = 0;
+
+  TopologyCache()  = default;
+  ~TopologyCache() = default;
+
+  /**
+   * Computes the fingerprint of a topology, as a 56-bit FNV-1a hash of its serialized contents
+   *
+   * @param[in] topology The topology to fingerprint
+   *
+   * @return The fingerprint of the topology. It is never equal to noFingerprint
+   */
+  [[nodiscard]] __INLINE__ static fingerprint_t fingerprint(const HiCR::Topology &topology) { return fingerprint(topology.serialize()); }
+
+  /**
+   * Computes the fingerprint of a serialized topology (possibly extended with additional information), as a 56-bit FNV-1a hash of its contents
+   *
+   * @param[in] serializedTopology The JSON-encoded topology to fingerprint
+   *
+   * @return The fingerprint of the topology. It is never equal to noFingerprint
+   */
+  [[nodiscard]] __INLINE__ static fingerprint_t fingerprint(const nlohmann::json &serializedTopology)
+  {
+    const auto serializedTopologyString = serializedTopology.dump();
+
+    uint64_t hash = 14695981039346656037ull;
+    for (const auto c : serializedTopologyString)
+    {
+      hash ^= (uint8_t)c;
+      hash *= 1099511628211ull;
+    }
+
+    // Folding the upper byte into the rest and trimming to 56 bits
+    const fingerprint_t fingerprint = (hash ^ (hash >> 56)) & 0x00FFFFFFFFFFFFFFull;
+    return fingerprint == noFingerprint ? 1 : fingerprint;
+  }
+
+  /**
+   * Gets the fingerprint of the topology known for a given instance
+   *
+   * @param[in] instanceId The id of the instance
+   *
+   * @return The fingerprint of the cached topology, or noFingerprint if none is cached for the instance
+   */
+  [[nodiscard]] __INLINE__ fingerprint_t getFingerprint(const HiCR::Instance::instanceId_t instanceId) const
+  {
+    const auto entry = _entries.find(instanceId);
+    return entry == _entries.end() ? noFingerprint : entry->second.first;
+  }
+
+  /**
+   * Gets the topology known for a given instance
+   *
+   * @param[in] instanceId The id of the instance
+   *
+   * @return The cached topology
+   */
+  [[nodiscard]] __INLINE__ const HiCR::Topology &getTopology(const HiCR::Instance::instanceId_t instanceId) const
+  {
+    const auto entry = _entries.find(instanceId);
+    if (entry == _entries.end()) HICR_THROW_LOGIC("[DeployR] No topology is cached for instance %lu.\n", instanceId);
+    return entry->second.second;
+  }
+
+  /**
+   * Stores (or replaces) the topology known for a given instance
+   *
+   * @param[in] instanceId The id of the instance
+   * @param[in] fingerprint The fingerprint of the topology, as computed by the instance itself
+   * @param[in] topology The topology to store
+   */
+  __INLINE__ void update(const HiCR::Instance::instanceId_t instanceId, const fingerprint_t fingerprint, const HiCR::Topology &topology)
+  {
+    _entries.insert_or_assign(instanceId, std::make_pair(fingerprint, topology));
+  }
+
+  /**
+   * Forgets the topology known for a given instance, if any
+   *
+   * @param[in] instanceId The id of the instance
+   */
+  __INLINE__ void erase(const HiCR::Instance::instanceId_t instanceId) { _entries.erase(instanceId); }
+
+  /**
+   * Forgets all known topologies
+   */
+  __INLINE__ void clear() { _entries.clear(); }
+
+  /**
+   * Gets the number of instances with a cached topology
+   *
+   * @return The number of cached topologies
+   */
+  [[nodiscard]] __INLINE__ size_t size() const { return _entries.size(); }
+
+  private:
+
+  /// Fingerprint and topology known for each instance
+  std::map<HiCR::Instance::instanceId_t, std::pair<fingerprint_t, HiCR::Topology>> _entries;
+
+}; // class TopologyCache
+
+} // namespace deployr
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/instance.hpp>
+#include <nlohmann_json/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace deployr
+{
+
+/**
+ * Records timed events (phases, RPCs, runner executions) of a DeployR instance, for performance analysis.
+ *
+ * Each event is a span with a name, a category, the instance and thread that recorded it, its start time and duration and, optionally, the number of payload bytes
+ * involved and the remote instance (peer) it relates to. The events of several instances can be merged into one tracer, shifting their timestamps onto its clock.
+ * The merged events can be exported as a Chrome trace (readable by chrome://tracing and Perfetto) or as CSV.
+ *
+ * Recording is disabled by default. When disabled, creating a span only checks a flag, and nothing is recorded.
+ */
+class Tracer final
+{
+  public:
+
+  /// Type for timestamps and durations, in nanoseconds
+  typedef int64_t timestamp_t;
+
+  /// Value of the peer field for events that do not relate to a remote instance
+  static constexpr HiCR::Instance::instanceId_t noPeer = std::numeric_limits<HiCR::Instance::instanceId_t>::max();
+
+  /**
+   * A recorded event
+   */
+  struct event_t
+  {
+    /// What the event measures
+    std::string name;
+
+    /// The kind of event (e.g., "Phase", "RPC", "Runner")
+    std::string category;
+
+    /// The instance that recorded it
+    HiCR::Instance::instanceId_t instanceId;
+
+    /// Index of the thread that recorded it, within its instance
+    size_t threadIdx;
+
+    /// Start time, on the clock of the tracer holding the event
+    timestamp_t startTime;
+
+    /// Duration
+    timestamp_t duration;
+
+    /// Payload bytes involved, if any
+    size_t bytes;
+
+    /// The remote instance the event relates to, or noPeer
+    HiCR::Instance::instanceId_t peer;
+  };
+
+  class Span;
+
+  Tracer()  = default;
+  ~Tracer() = default;
+
+  /**
+   * Enables or disables recording
+   *
+   * @param[in] isEnabled Whether to record events
+   */
+  __INLINE__ void setEnabled(const bool isEnabled) { _isEnabled = isEnabled; }
+
+  /**
+   * Indicates whether recording is enabled
+   *
+   * @return true, if recording; false, otherwise
+   */
+  [[nodiscard]] __INLINE__ bool isEnabled() const { return _isEnabled.load(std::memory_order_relaxed); }
+
+  /**
+   * Sets the id of the instance the events recorded from now on belong to
+   *
+   * @param[in] instanceId The id of the local instance
+   */
+  __INLINE__ void setInstanceId(const HiCR::Instance::instanceId_t instanceId) { _instanceId = instanceId; }
+
+  /**
+   * Gets the current time on the clock of this instance
+   *
+   * @return The current time
+   */
+  [[nodiscard]] __INLINE__ static timestamp_t now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  /**
+   * Records an event, if recording is enabled. It can be called from several threads at a time
+   *
+   * @param[in] name What the event measures
+   * @param[in] category The kind of event
+   * @param[in] startTime When the event started, as given by now
+   * @param[in] endTime When the event ended, as given by now
+   * @param[in] bytes Payload bytes involved, if any
+   * @param[in] peer The remote instance the event relates to, if any
+   */
+  __INLINE__ void record(const char *name, const char *category, const timestamp_t startTime, const timestamp_t endTime, const size_t bytes = 0, const HiCR::Instance::instanceId_t peer = noPeer)
+  {
+    if (isEnabled() == false) return;
+
+    std::unique_lock lock(_mutex);
+    const auto [entry, isNewThread] = _threadIdxs.try_emplace(std::this_thread::get_id(), _threadIdxs.size());
+    _events.push_back({name, category, _instanceId, entry->second, startTime, endTime - startTime, bytes, peer});
+  }
+
+  /**
+   * Starts a span that records an event when it goes out of scope. This is the usual way of timing a region of code
+   *
+   * @param[in] name What the span measures. Must outlive the span
+   * @param[in] category The kind of event. Must outlive the span
+   * @param[in] peer The remote instance the span relates to, if any
+   *
+   * @return The span
+   */
+  [[nodiscard]] __INLINE__ Span span(const char *name, const char *category = "User", const HiCR::Instance::instanceId_t peer = noPeer);
+
+  /**
+   * Gets a copy of the events recorded or merged so far
+   *
+   * @return The events, in the order they were recorded or merged
+   */
+  [[nodiscard]] __INLINE__ std::vector<event_t> getEvents() const
+  {
+    std::unique_lock lock(_mutex);
+    return _events;
+  }
+
+  /**
+   * Forgets all events
+   */
+  __INLINE__ void clear()
+  {
+    std::unique_lock lock(_mutex);
+    _events.clear();
+  }
+
+  /**
+   * Serializes the events, along with the current time, so that they can be merged into the tracer of another instance
+   *
+   * @return The JSON-encoded events
+   */
+  [[nodiscard]] __INLINE__ nlohmann::json serialize() const
+  {
+    std::unique_lock lock(_mutex);
+    auto             events = nlohmann::json::array();
+    for (const auto &event : _events)
+      events.push_back(
+        {event.name, event.category, event.instanceId, event.threadIdx, event.startTime, event.duration, event.bytes, event.peer == noPeer ? nlohmann::json() : nlohmann::json(event.peer)});
+    return {{"Clock", now()}, {"Events", std::move(events)}};
+  }
+
+  /**
+   * Adds the events serialized by another tracer to this one
+   *
+   * @param[in] serializedEvents The events, as returned by serialize
+   * @param[in] clockOffset The offset of the other tracer's clock with respect to this one's, subtracted from the merged timestamps
+   */
+  __INLINE__ void merge(const nlohmann::json &serializedEvents, const timestamp_t clockOffset)
+  {
+    std::unique_lock lock(_mutex);
+    for (const auto &event : serializedEvents["Events"])
+      _events.push_back({event[0].get<std::string>(),
+                         event[1].get<std::string>(),
+                         event[2].get<HiCR::Instance::instanceId_t>(),
+                         event[3].get<size_t>(),
+                         event[4].get<timestamp_t>() - clockOffset,
+                         event[5].get<timestamp_t>(),
+                         event[6].get<size_t>(),
+                         event[7].is_null() ? noPeer : event[7].get<HiCR::Instance::instanceId_t>()});
+  }
+
+  /**
+   * Writes the events in the Chrome trace event format, with one process per instance and one thread per recording thread.
+   * Timestamps are relative to the earliest event
+   *
+   * @param[out] stream The stream to write to
+   */
+  __INLINE__ void exportChromeTrace(std::ostream &stream) const
+  {
+    const auto events    = getEvents();
+    const auto startTime = getEarliestStartTime(events);
+
+    auto traceEvents = nlohmann::json::array();
+    for (const auto &event : events)
+    {
+      nlohmann::json traceEvent = {{"name", event.name},
+                                   {"cat", event.category},
+                                   {"ph", "X"},
+                                   {"pid", event.instanceId},
+                                   {"tid", event.threadIdx},
+                                   {"ts", (double)(event.startTime - startTime) / 1000.0},
+                                   {"dur", (double)event.duration / 1000.0}};
+      if (event.bytes > 0) traceEvent["args"]["Bytes"] = event.bytes;
+      if (event.peer != noPeer) traceEvent["args"]["Peer"] = event.peer;
+      traceEvents.push_back(std::move(traceEvent));
+    }
+
+    stream << nlohmann::json({{"traceEvents", std::move(traceEvents)}, {"displayTimeUnit", "ms"}}).dump();
+  }
+
+  /**
+   * Writes the events as CSV, with a header line. Timestamps and durations are in nanoseconds, relative to the earliest event. Events without peer leave it empty
+   *
+   * @param[out] stream The stream to write to
+   */
+  __INLINE__ void exportCsv(std::ostream &stream) const
+  {
+    const auto events    = getEvents();
+    const auto startTime = getEarliestStartTime(events);
+
+    stream << "Name,Category,Instance Id,Thread,Start (ns),Duration (ns),Bytes,Peer\n";
+    for (const auto &event : events)
+    {
+      stream << nlohmann::json(event.name).dump() << ',' << nlohmann::json(event.category).dump() << ',' << event.instanceId << ',' << event.threadIdx << ','
+             << event.startTime - startTime << ',' << event.duration << ',' << event.bytes << ',';
+      if (event.peer != noPeer) stream << event.peer;
+      stream << '\n';
+    }
+  }
+
+  private:
+
+  /**
+   * [Internal] Finds the earliest start time among a set of events
+   *
+   * @param[in] events The events
+   *
+   * @return The earliest start time, or zero if there are no events
+   */
+  [[nodiscard]] __INLINE__ static timestamp_t getEarliestStartTime(const std::vector<event_t> &events)
+  {
+    if (events.empty()) return 0;
+    timestamp_t startTime = events[0].startTime;
+    for (const auto &event : events) startTime = std::min(startTime, event.startTime);
+    return startTime;
+  }
+
+  /// Whether recording is enabled
+  std::atomic<bool> _isEnabled = false;
+
+  /// The instance the recorded events belong to
+  HiCR::Instance::instanceId_t _instanceId = 0;
+
+  /// Protects the events, which are recorded from several threads
+  mutable std::mutex _mutex;
+
+  /// Index of each thread that recorded events
+  std::unordered_map<std::thread::id, size_t> _threadIdxs;
+
+  /// The events recorded or merged so far
+  std::vector<event_t> _events;
+
+}; // class Tracer
+
+/**
+ * Times a region of code, recording it as an event in a tracer when it goes out of scope. Nothing is timed if the tracer is disabled when the span starts
+ */
+class Tracer::Span final
+{
+  public:
+
+  Span() = delete;
+
+  /**
+   * Constructor for the span, which starts timing
+   *
+   * @param[in] tracer The tracer to record the event in
+   * @param[in] name What the span measures. Must outlive the span
+   * @param[in] category The kind of event. Must outlive the span
+   * @param[in] peer The remote instance the span relates to, if any
+   */
+  Span(Tracer &tracer, const char *name, const char *category, const HiCR::Instance::instanceId_t peer)
+    : _tracer(tracer.isEnabled() ? &tracer : nullptr),
+      _name(name),
+      _category(category),
+      _peer(peer),
+      _startTime(_tracer != nullptr ? now() : 0)
+  {}
+
+  Span(const Span &)            = delete;
+  Span &operator=(const Span &) = delete;
+
+  /**
+   * The destructor records the event
+   */
+  ~Span()
+  {
+    if (_tracer != nullptr) _tracer->record(_name, _category, _startTime, now(), _bytes, _peer);
+  }
+
+  /**
+   * Sets the payload bytes involved in the span
+   *
+   * @param[in] bytes The payload bytes
+   */
+  __INLINE__ void setBytes(const size_t bytes) { _bytes = bytes; }
+
+  private:
+
+  /// The tracer to record the event in, or nullptr if disabled
+  Tracer *const _tracer;
+
+  /// What the span measures
+  const char *const _name;
+
+  /// The kind of event
+  const char *const _category;
+
+  /// The remote instance the span relates to, if any
+  const HiCR::Instance::instanceId_t _peer;
+
+  /// When the span started
+  const timestamp_t _startTime;
+
+  /// Payload bytes involved
+  size_t _bytes = 0;
+
+}; // class Tracer::Span
+
+__INLINE__ Tracer::Span Tracer::span(const char *name, const char *category, const HiCR::Instance::instanceId_t peer) { return Span(*this, name, category, peer); }
+
+} // namespace deployr
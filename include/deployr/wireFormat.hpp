@@ -0,0 +1,86 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <nlohmann_json/json.hpp>
+#include <cstdint>
+#include <string>
+
+namespace deployr
+{
+
+/**
+ * Encodes and decodes the JSON-based messages (e.g., topologies) that DeployR instances exchange among each other
+ */
+class WireFormat final
+{
+  public:
+
+  /**
+   * Encodings available for the exchanged messages. The numerical value is sent as part of the RPC argument to negotiate the encoding with the remote instance
+   */
+  enum encoding_t : uint8_t
+  {
+    /// Plain JSON text. This is the default, and it is the one produced by previous DeployR versions
+    json = 0,
+
+    /// Concise Binary Object Representation (RFC 8949), as implemented by nlohmann::json
+    cbor = 1
+  };
+
+  WireFormat()  = delete;
+  ~WireFormat() = delete;
+
+  /**
+   * Encodes a JSON object into a message buffer
+   *
+   * @param[in] message The JSON object to encode
+   * @param[in] encoding The encoding to use
+   *
+   * @return A buffer containing the encoded message. Its size is the exact size of the message; plain JSON messages are not NUL-terminated
+   */
+  [[nodiscard]] __INLINE__ static std::string encode(const nlohmann::json &message, const encoding_t encoding)
+  {
+    // Plain JSON is dumped directly, without NUL terminator, as the receiver takes the message size from the memory slot
+    if (encoding == encoding_t::json) return message.dump();
+
+    // Binary encodings are written straight into the buffer
+    if (encoding == encoding_t::cbor)
+    {
+      std::string buffer;
+      nlohmann::json::to_cbor(message, buffer);
+      return buffer;
+    }
+
+    HICR_THROW_LOGIC("[DeployR] Unknown wire format encoding: %u\n", (unsigned int)encoding);
+  }
+
+  /**
+   * Decodes a JSON object directly from a message buffer (e.g., a memory slot), without copying it first
+   *
+   * The message size is given explicitly, so the buffer needs not be NUL-terminated. A trailing NUL, as sent by previous DeployR versions, is ignored.
+   *
+   * @param[in] data A pointer to the start of the encoded message
+   * @param[in] size The size in bytes of the encoded message
+   * @param[in] encoding The encoding the message was encoded with
+   *
+   * @return The decoded JSON object
+   */
+  [[nodiscard]] __INLINE__ static nlohmann::json decode(const void *data, const size_t size, const encoding_t encoding)
+  {
+    const auto begin = (const uint8_t *)data;
+
+    if (encoding == encoding_t::cbor) return nlohmann::json::from_cbor(begin, begin + size);
+
+    if (encoding == encoding_t::json)
+    {
+      const size_t messageSize = (size > 0 && begin[size - 1] == '\0') ? size - 1 : size;
+      return nlohmann::json::parse(begin, begin + messageSize);
+    }
+
+    HICR_THROW_LOGIC("[DeployR] Unknown wire format encoding: %u\n", (unsigned int)encoding);
+  }
+
+}; // class WireFormat
+
+} // namespace deployr
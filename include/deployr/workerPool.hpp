@@ -0,0 +1,236 @@
+#pragma once
+
+#include <hicr/core/definitions.hpp>
+#include <hicr/core/exceptions.hpp>
+#include <hicr/backends/pthreads/computeManager.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace deployr
+{
+
+/**
+ * A fixed-size pool of worker threads that runs submitted tasks in the background.
+ *
+ * It is used by DeployR to overlap local work (e.g., deserialization) with communication on the coordinator.
+ * Workers are either plain threads or, to place them on specific compute resources, HiCR processing units created by a pthreads compute manager.
+ */
+class WorkerPool final
+{
+  public:
+
+  WorkerPool() = delete;
+
+  /**
+   * Constructor for the worker pool. It launches the worker threads immediately
+   *
+   * @param[in] threadCount The number of worker threads to launch. Zero is interpreted as the hardware concurrency of the system
+   */
+  WorkerPool(size_t threadCount)
+  {
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t i = 0; i < threadCount; i++) _workers.emplace_back([this]() { workerLoop(); });
+  }
+
+  /**
+   * Constructor for a worker pool whose workers run on HiCR processing units, one per given compute resource. It launches the workers immediately
+   *
+   * @param[in] computeManager The compute manager used to create, start and await the processing units. It must outlive the pool
+   * @param[in] computeResources The compute resources to run the workers on
+   */
+  WorkerPool(HiCR::backend::pthreads::ComputeManager &computeManager, const std::vector<std::shared_ptr<HiCR::ComputeResource>> &computeResources)
+    : _computeManager(&computeManager)
+  {
+    if (computeResources.empty()) HICR_THROW_LOGIC("[DeployR] A worker pool needs at least one compute resource.\n");
+
+    for (const auto &computeResource : computeResources)
+    {
+      auto processingUnit = computeManager.createProcessingUnit(computeResource);
+      computeManager.initialize(processingUnit);
+
+      auto executionUnit  = HiCR::backend::pthreads::ComputeManager::createExecutionUnit([this](void *) { workerLoop(); });
+      auto executionState = computeManager.createExecutionState(executionUnit);
+      computeManager.start(processingUnit, executionState);
+
+      _processingUnits.push_back(std::move(processingUnit));
+    }
+  }
+
+  /**
+   * The destructor waits for all pending tasks to finish before joining the workers
+   */
+  ~WorkerPool()
+  {
+    {
+      std::unique_lock lock(_mutex);
+      _isFinishing = true;
+    }
+    _taskAvailable.notify_all();
+    for (auto &worker : _workers) worker.join();
+    for (auto &processingUnit : _processingUnits)
+    {
+      _computeManager->await(processingUnit);
+      _computeManager->terminate(processingUnit);
+    }
+  }
+
+  /**
+   * Submits a task for background execution
+   *
+   * @param[in] task The task to run
+   */
+  __INLINE__ void submit(std::function<void()> task)
+  {
+    {
+      std::unique_lock lock(_mutex);
+      _tasks.push(std::move(task));
+      _pendingTaskCount++;
+    }
+    _taskAvailable.notify_one();
+  }
+
+  /**
+   * Blocks until all submitted tasks have finished. If any of them threw an exception, the first one is re-thrown here
+   */
+  __INLINE__ void wait()
+  {
+    std::unique_lock lock(_mutex);
+    _tasksFinished.wait(lock, [this]() { return _pendingTaskCount == 0; });
+
+    if (_exception != nullptr)
+    {
+      auto exception = _exception;
+      _exception     = nullptr;
+      std::rethrow_exception(exception);
+    }
+  }
+
+  /**
+   * Blocks until all submitted tasks have finished, or the timeout elapses. If they finished and any of them threw an exception, the first one is re-thrown here
+   *
+   * @param[in] timeout The longest time to wait
+   *
+   * @return true, if all tasks finished; false, if the timeout elapsed first
+   */
+  __INLINE__ bool waitFor(const std::chrono::nanoseconds timeout)
+  {
+    std::unique_lock lock(_mutex);
+    if (_tasksFinished.wait_for(lock, timeout, [this]() { return _pendingTaskCount == 0; }) == false) return false;
+
+    if (_exception != nullptr)
+    {
+      auto exception = _exception;
+      _exception     = nullptr;
+      std::rethrow_exception(exception);
+    }
+    return true;
+  }
+
+  /**
+   * Runs a function over the index range [0, count), split into contiguous chunks distributed among the workers, and waits for it to finish
+   *
+   * @param[in] count The number of indexes to process
+   * @param[in] fc The function to run. It receives the [begin, end) index range of a chunk
+   */
+  __INLINE__ void parallelFor(const size_t count, const std::function<void(const size_t, const size_t)> &fc)
+  {
+    // Using a few chunks per worker to balance uneven work
+    const size_t chunkCount = std::min(count, getThreadCount() * 4);
+    for (size_t chunk = 0; chunk < chunkCount; chunk++)
+    {
+      const size_t begin = count * chunk / chunkCount;
+      const size_t end   = count * (chunk + 1) / chunkCount;
+      submit([&fc, begin, end]() { fc(begin, end); });
+    }
+
+    wait();
+  }
+
+  /**
+   * Gets the number of worker threads in this pool
+   *
+   * @return The number of worker threads
+   */
+  [[nodiscard]] __INLINE__ size_t getThreadCount() const { return _workers.size() + _processingUnits.size(); }
+
+  private:
+
+  /**
+   * [Internal] Main loop of each worker thread: runs tasks until the pool is destroyed
+   */
+  __INLINE__ void workerLoop()
+  {
+    while (true)
+    {
+      std::function<void()> task;
+
+      // Waiting for a task to arrive, or for the pool to finish
+      {
+        std::unique_lock lock(_mutex);
+        _taskAvailable.wait(lock, [this]() { return _isFinishing || _tasks.empty() == false; });
+        if (_tasks.empty()) return;
+        task = std::move(_tasks.front());
+        _tasks.pop();
+      }
+
+      // Running task, remembering the first exception thrown
+      std::exception_ptr exception = nullptr;
+      try
+      {
+        task();
+      }
+      catch (...)
+      {
+        exception = std::current_exception();
+      }
+
+      // Notifying completion
+      {
+        std::unique_lock lock(_mutex);
+        if (exception != nullptr && _exception == nullptr) _exception = exception;
+        _pendingTaskCount--;
+      }
+      _tasksFinished.notify_all();
+    }
+  }
+
+  /// Worker threads
+  std::vector<std::thread> _workers;
+
+  /// Compute manager of the processing units, if the workers run on them
+  HiCR::backend::pthreads::ComputeManager *const _computeManager = nullptr;
+
+  /// Processing units running the workers, if created from compute resources
+  std::vector<std::unique_ptr<HiCR::ProcessingUnit>> _processingUnits;
+
+  /// Tasks waiting to be picked up by a worker
+  std::queue<std::function<void()>> _tasks;
+
+  /// Number of submitted tasks that have not yet finished
+  size_t _pendingTaskCount = 0;
+
+  /// Whether the pool is being destroyed
+  bool _isFinishing = false;
+
+  /// First exception thrown by a task, if any
+  std::exception_ptr _exception = nullptr;
+
+  /// Mutual exclusion for the internal state
+  std::mutex _mutex;
+
+  /// Signals workers that a task is available
+  std::condition_variable _taskAvailable;
+
+  /// Signals waiters that a task has finished
+  std::condition_variable _tasksFinished;
+
+}; // class WorkerPool
+
+} // namespace deployr
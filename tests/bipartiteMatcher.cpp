@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <functional>
+#include <random>
+#include <deployr/bipartiteMatcher.hpp>
+
+using deployr::BipartiteMatcher;
+
+// Both adjacency storages must produce the same results
+class BipartiteMatcherStorage : public ::testing::TestWithParam<BipartiteMatcher::adjacencyStorage_t>
+{};
+
+INSTANTIATE_TEST_SUITE_P(Storages, BipartiteMatcherStorage, ::testing::Values(BipartiteMatcher::adjacencyStorage_t::csr, BipartiteMatcher::adjacencyStorage_t::bitset));
+
+// Computes the size of a maximum matching with the simple augmenting path algorithm (Kuhn's), as reference
+size_t referenceMatchingSize(const std::vector<std::vector<size_t>> &adjacency, const size_t rightCount)
+{
+  std::vector<size_t>         rightPairs(rightCount, SIZE_MAX);
+  std::vector<bool>           visited;
+  std::function<bool(size_t)> augment = [&](const size_t u) {
+    for (const auto v : adjacency[u])
+      if (visited[v] == false)
+      {
+        visited[v] = true;
+        if (rightPairs[v] == SIZE_MAX || augment(rightPairs[v]))
+        {
+          rightPairs[v] = u;
+          return true;
+        }
+      }
+    return false;
+  };
+
+  size_t matchCount = 0;
+  for (size_t u = 0; u < adjacency.size(); u++)
+  {
+    visited.assign(rightCount, false);
+    if (augment(u)) matchCount++;
+  }
+  return matchCount;
+}
+
+// Checks that the pairings are consistent with each other and only use edges of the graph
+void checkPairings(const BipartiteMatcher &matcher, const std::vector<std::vector<size_t>> &adjacency, const size_t expectedCount)
+{
+  const auto &leftPairs  = matcher.getLeftPairings();
+  const auto &rightPairs = matcher.getRightPairings();
+
+  size_t matchCount = 0;
+  for (size_t u = 0; u < leftPairs.size(); u++)
+  {
+    if (leftPairs[u] == BipartiteMatcher::NIL) continue;
+    matchCount++;
+    EXPECT_EQ(rightPairs[leftPairs[u]], u);
+    EXPECT_NE(std::find(adjacency[u].begin(), adjacency[u].end(), leftPairs[u]), adjacency[u].end());
+  }
+  EXPECT_EQ(matchCount, expectedCount);
+}
+
+TEST_P(BipartiteMatcherStorage, PerfectMatchingNeedsAugmentation)
+{
+  // A greedy pass pairs 0-0 and leaves 1 unmatched; the perfect matching is 0-1, 1-0
+  const std::vector<std::vector<size_t>> adjacency = {{0, 1}, {0}};
+
+  BipartiteMatcher matcher;
+  matcher.loadGraph(adjacency, 2, GetParam());
+  EXPECT_EQ(matcher.computeMaximumMatching(), 2u);
+  checkPairings(matcher, adjacency, 2);
+}
+
+TEST_P(BipartiteMatcherStorage, NonPerfectMatching)
+{
+  // Three runners compete for a single host, and one host has no runner
+  const std::vector<std::vector<size_t>> adjacency = {{0}, {0}, {0, 1}};
+
+  BipartiteMatcher matcher;
+  matcher.loadGraph(adjacency, 3, GetParam());
+  EXPECT_EQ(matcher.computeMaximumMatching(), 2u);
+  checkPairings(matcher, adjacency, 2);
+  EXPECT_EQ(matcher.getRightPairings()[2], BipartiteMatcher::NIL);
+}
+
+TEST_P(BipartiteMatcherStorage, EmptyGraph)
+{
+  BipartiteMatcher matcher;
+  matcher.loadGraph({}, 0, GetParam());
+  EXPECT_EQ(matcher.computeMaximumMatching(), 0u);
+
+  matcher.loadGraph({{}, {}}, 3, GetParam());
+  EXPECT_EQ(matcher.computeMaximumMatching(), 0u);
+}
+
+TEST_P(BipartiteMatcherStorage, HasEdge)
+{
+  BipartiteMatcher matcher;
+  matcher.loadGraph({{1, 70}, {}}, 100, GetParam());
+  EXPECT_EQ(matcher.isUsingBitset(), GetParam() == BipartiteMatcher::adjacencyStorage_t::bitset);
+  EXPECT_TRUE(matcher.hasEdge(0, 1));
+  EXPECT_TRUE(matcher.hasEdge(0, 70));
+  EXPECT_FALSE(matcher.hasEdge(0, 0));
+  EXPECT_FALSE(matcher.hasEdge(1, 1));
+}
+
+TEST_P(BipartiteMatcherStorage, KeepsExistingMatchingAcrossCalls)
+{
+  const std::vector<std::vector<size_t>> adjacency = {{0, 1}, {1, 2}, {0}};
+
+  BipartiteMatcher matcher;
+  matcher.loadGraph(adjacency, 3, GetParam());
+  EXPECT_EQ(matcher.computeMaximumMatching(), 3u);
+
+  // Calling again on a maximum matching finds nothing more to augment
+  const auto pairings = matcher.getLeftPairings();
+  EXPECT_EQ(matcher.computeMaximumMatching(), 3u);
+  EXPECT_EQ(matcher.getLeftPairings(), pairings);
+
+  // Clearing the matching keeps the graph
+  matcher.clearMatching();
+  for (const auto v : matcher.getLeftPairings()) EXPECT_EQ(v, BipartiteMatcher::NIL);
+  EXPECT_EQ(matcher.computeMaximumMatching(), 3u);
+  checkPairings(matcher, adjacency, 3);
+}
+
+TEST_P(BipartiteMatcherStorage, MatchesReferenceOnRandomGraphs)
+{
+  std::mt19937     generator(1234);
+  BipartiteMatcher matcher;
+
+  // The same matcher is reused for all graphs, as DeployR does
+  for (size_t i = 0; i < 200; i++)
+  {
+    const size_t                     leftCount  = generator() % 40;
+    const size_t                     rightCount = 1 + generator() % 40;
+    const size_t                     density    = 1 + generator() % 30;
+    std::vector<std::vector<size_t>> adjacency(leftCount);
+    for (auto &neighbors : adjacency)
+      for (size_t v = 0; v < rightCount; v++)
+        if (generator() % 100 < density) neighbors.push_back(v);
+
+    const auto expectedCount = referenceMatchingSize(adjacency, rightCount);
+    matcher.loadGraph(adjacency, rightCount, GetParam());
+    EXPECT_EQ(matcher.computeMaximumMatching(), expectedCount);
+    checkPairings(matcher, adjacency, expectedCount);
+  }
+}
+
+TEST(BipartiteMatcher, AutomaticStoragePicksSmallerOne)
+{
+  BipartiteMatcher matcher;
+
+  // A complete graph takes less memory as bitsets
+  std::vector<std::vector<size_t>> complete(64, std::vector<size_t>(64));
+  for (auto &neighbors : complete)
+    for (size_t v = 0; v < neighbors.size(); v++) neighbors[v] = v;
+  matcher.loadGraph(complete, 64);
+  EXPECT_TRUE(matcher.isUsingBitset());
+  EXPECT_EQ(matcher.computeMaximumMatching(), 64u);
+
+  // A sparse graph over many hosts takes less memory in CSR form
+  matcher.loadGraph({{0}, {4095}}, 4096);
+  EXPECT_FALSE(matcher.isUsingBitset());
+  EXPECT_EQ(matcher.computeMaximumMatching(), 2u);
+}
+
+TEST(BipartiteMatcher, RejectsOutOfRangeVertex)
+{
+  BipartiteMatcher matcher;
+  EXPECT_ANY_THROW(matcher.loadGraph({{3}}, 3));
+}
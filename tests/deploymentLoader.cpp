@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <deployr/deploymentLoader.hpp>
+
+using deployr::DeploymentLoader;
+
+// A deployment file with repeated functions and topologies, keys to skip, and a communication group
+const std::string deploymentFile = R"({
+  "Name": "Test",
+  "Options": { "Nested": [ 1, { "Deep": [ 2, 3 ] } ] },
+  "Runners": [
+    { "Function": "LeaderFc", "Topology": { } },
+    { "Function": "WorkerFc", "Comment": { "Skipped": [ "yes" ] }, "Topology": { "Devices": [ { "Type": "NUMA Domain", "Compute Resources": [ { "Type": "Processing Unit" } ], "Memory Spaces": [ { "Type": "RAM", "Size": 1024 } ] } ] } },
+    { "Topology": { "Devices": [ { "Type": "NUMA Domain", "Compute Resources": [ { "Type": "Processing Unit" } ], "Memory Spaces": [ { "Type": "RAM", "Size": 1024 } ] } ] }, "Function": "WorkerFc" },
+    { "Function": "WorkerFc", "Topology": { "Devices": [ { "Type": "NUMA Domain", "Compute Resources": [ { "Type": "Processing Unit" } ], "Memory Spaces": [ { "Type": "RAM", "Size": 2048 } ] } ] } }
+  ],
+  "Communication": [ { "Runners": [ 1, 2, 3 ], "Weight": 0.5 } ]
+})";
+
+// Parses a deployment file given as a string
+DeploymentLoader load(const std::string &contents)
+{
+  DeploymentLoader   loader;
+  std::istringstream stream(contents);
+  loader.parse(stream);
+  return loader;
+}
+
+TEST(DeploymentLoader, DeduplicatesFunctionsAndTopologies)
+{
+  const auto  loader   = load(deploymentFile);
+  const auto &requests = loader.getRunnerRequests();
+
+  ASSERT_EQ(requests.size(), 4u);
+  EXPECT_EQ(loader.getFunctions(), std::vector<std::string>({"LeaderFc", "WorkerFc"}));
+  EXPECT_EQ(loader.getTopologies().size(), 3u);
+
+  for (size_t i = 0; i < requests.size(); i++) EXPECT_EQ(requests[i].id, i);
+  EXPECT_EQ(requests[0].functionIdx, 0u);
+  EXPECT_EQ(requests[1].functionIdx, 1u);
+  EXPECT_EQ(requests[3].functionIdx, 1u);
+
+  // Identical topology blocks share their entry, regardless of the order of the keys around them
+  EXPECT_NE(requests[0].topologyIdx, requests[1].topologyIdx);
+  EXPECT_EQ(requests[1].topologyIdx, requests[2].topologyIdx);
+  EXPECT_NE(requests[1].topologyIdx, requests[3].topologyIdx);
+  EXPECT_EQ(loader.getTopologies()[requests[3].topologyIdx].serialize()["Devices"][0]["Memory Spaces"][0]["Size"], 2048u);
+}
+
+TEST(DeploymentLoader, ReadsCommunicationGroups)
+{
+  const auto  loader = load(deploymentFile);
+  const auto &groups = loader.getCommunicationGroups();
+
+  ASSERT_EQ(groups.size(), 1u);
+  EXPECT_EQ(groups[0].runnerIds, std::vector<deployr::Runner::runnerId_t>({1, 2, 3}));
+  EXPECT_DOUBLE_EQ(groups[0].weight, 0.5);
+}
+
+TEST(DeploymentLoader, RequestedTopologiesFollowRunners)
+{
+  const auto loader              = load(deploymentFile);
+  const auto requestedTopologies = loader.getRequestedTopologies();
+
+  ASSERT_EQ(requestedTopologies.size(), 4u);
+  for (size_t i = 0; i < requestedTopologies.size(); i++)
+    EXPECT_EQ(requestedTopologies[i].serialize(), loader.getTopologies()[loader.getRunnerRequests()[i].topologyIdx].serialize());
+}
+
+TEST(DeploymentLoader, BuildsDeployment)
+{
+  const auto loader = load(deploymentFile);
+
+  // The deployment may already have topologies of its own, which the loaded ones are added after
+  deployr::Deployment deployment;
+  deployment.addTopology(HiCR::Topology());
+  loader.buildDeployment({10, 11, 12, 13}, deployment);
+
+  ASSERT_EQ(deployment.getRunnerCount(), 4u);
+  EXPECT_EQ(deployment.getTopologies().size(), 4u);
+  for (size_t i = 0; i < 4; i++)
+  {
+    const auto &request = loader.getRunnerRequests()[i];
+    EXPECT_EQ(deployment.getRunnerIds()[i], request.id);
+    EXPECT_EQ(deployment.getInstanceIds()[i], 10 + i);
+    EXPECT_EQ(deployment.getFunctions()[deployment.getFunctionIdxs()[i]], loader.getFunctions()[request.functionIdx]);
+    EXPECT_EQ(deployment.getTopologyIdxs()[i], 1 + request.topologyIdx);
+  }
+  EXPECT_EQ(deployment.getCommunicationGroups().size(), 1u);
+
+  // There must be one instance per runner
+  deployr::Deployment otherDeployment;
+  EXPECT_ANY_THROW(loader.buildDeployment({10, 11}, otherDeployment));
+}
+
+TEST(DeploymentLoader, AppendsFurtherFiles)
+{
+  // Runners of a second file continue the ids of the first, and share its distinct functions and topologies
+  auto               loader = load(deploymentFile);
+  std::istringstream stream(R"({ "Runners": [ { "Function": "LeaderFc", "Topology": { } } ] })");
+  loader.parse(stream);
+
+  const auto &requests = loader.getRunnerRequests();
+  ASSERT_EQ(requests.size(), 5u);
+  EXPECT_EQ(requests[4].id, 4u);
+  EXPECT_EQ(requests[4].functionIdx, requests[0].functionIdx);
+  EXPECT_EQ(requests[4].topologyIdx, requests[0].topologyIdx);
+}
+
+TEST(DeploymentLoader, RejectsInvalidFiles)
+{
+  EXPECT_ANY_THROW(load(R"({ "Runners": [ { "Topology": { } } ] })"));
+  EXPECT_ANY_THROW(load(R"({ "Runners": [ { "Function": "LeaderFc" } ] })"));
+  EXPECT_ANY_THROW(load(R"({ "Runners": [ { "Function": "LeaderFc", "Topology": { } } )"));
+  EXPECT_ANY_THROW(load(R"({ "Runners": [ ], "Communication": [ { "Runners": [ 0 ] } ] })"));
+
+  DeploymentLoader loader;
+  EXPECT_ANY_THROW(loader.parseFile("/nonexistent/deployment.json"));
+}
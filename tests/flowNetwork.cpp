@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <deployr/flowNetwork.hpp>
+
+using deployr::FlowNetwork;
+
+// An edge, as added to the network, to check the flows afterwards
+struct edge_t
+{
+  size_t                  from;
+  size_t                  to;
+  FlowNetwork::capacity_t capacity;
+  size_t                  id;
+};
+
+// Checks that the flows respect the capacities and are conserved at every vertex but the source and sink
+void checkFlows(const FlowNetwork &network, const std::vector<edge_t> &edges, const size_t vertexCount, const size_t source, const size_t sink, const FlowNetwork::capacity_t expectedFlow)
+{
+  std::vector<FlowNetwork::capacity_t> balance(vertexCount, 0);
+  for (const auto &edge : edges)
+  {
+    const auto flow = network.getFlow(edge.id);
+    EXPECT_GE(flow, 0);
+    EXPECT_LE(flow, edge.capacity);
+    balance[edge.from] -= flow;
+    balance[edge.to] += flow;
+  }
+
+  for (size_t vertex = 0; vertex < vertexCount; vertex++)
+  {
+    if (vertex == source || vertex == sink) continue;
+    EXPECT_EQ(balance[vertex], 0);
+  }
+  EXPECT_EQ(balance[sink], expectedFlow);
+  EXPECT_EQ(balance[source], -expectedFlow);
+}
+
+TEST(FlowNetwork, MaxFlow)
+{
+  // Classic textbook network, with a maximum flow of 23
+  const std::vector<std::tuple<size_t, size_t, FlowNetwork::capacity_t>> edgeList = {{0, 1, 16}, {0, 2, 13}, {1, 2, 10}, {2, 1, 4}, {1, 3, 12}, {3, 2, 9}, {2, 4, 14}, {4, 3, 7}, {3, 5, 20}, {4, 5, 4}};
+
+  FlowNetwork         network(6);
+  std::vector<edge_t> edges;
+  for (const auto &[from, to, capacity] : edgeList) edges.push_back({from, to, capacity, network.addEdge(from, to, capacity)});
+
+  EXPECT_EQ(network.computeMaxFlow(0, 5), 23);
+  checkFlows(network, edges, 6, 0, 5, 23);
+}
+
+TEST(FlowNetwork, DisconnectedSink)
+{
+  FlowNetwork network(3);
+  network.addEdge(0, 1, 5);
+  EXPECT_EQ(network.computeMaxFlow(0, 2), 0);
+  EXPECT_EQ(network.computeMinCostMaxFlow(0, 2), 0);
+  EXPECT_EQ(network.getTotalCost(), 0);
+}
+
+TEST(FlowNetwork, UnlimitedCapacities)
+{
+  // The flow is limited by the only finite edge
+  FlowNetwork network(3);
+  network.addEdge(0, 1, FlowNetwork::unlimited);
+  const auto edgeId = network.addEdge(1, 2, 7);
+  EXPECT_EQ(network.computeMaxFlow(0, 2), 7);
+  EXPECT_EQ(network.getFlow(edgeId), 7);
+}
+
+TEST(FlowNetwork, MinCostPrefersCheaperPaths)
+{
+  // Two parallel paths from 0 to 3; only 3 units fit through the cheap one
+  FlowNetwork network(4);
+  const auto  cheap     = network.addEdge(0, 1, 3, 1);
+  const auto  expensive = network.addEdge(0, 2, 10, 5);
+  network.addEdge(1, 3, 10, 1);
+  network.addEdge(2, 3, 10, 1);
+
+  EXPECT_EQ(network.computeMinCostMaxFlow(0, 3), 13);
+  EXPECT_EQ(network.getFlow(cheap), 3);
+  EXPECT_EQ(network.getFlow(expensive), 10);
+  EXPECT_EQ(network.getTotalCost(), 3 * 2 + 10 * 6);
+}
+
+TEST(FlowNetwork, MinCostReroutesThroughResidualEdges)
+{
+  // The first cheapest path (0-1-2-3) must be partially undone to reach the maximum flow of 2
+  FlowNetwork network(4);
+  network.addEdge(0, 1, 1, 1);
+  network.addEdge(0, 2, 1, 3);
+  network.addEdge(1, 2, 1, 0);
+  network.addEdge(1, 3, 1, 3);
+  network.addEdge(2, 3, 1, 1);
+
+  EXPECT_EQ(network.computeMinCostMaxFlow(0, 3), 2);
+  EXPECT_EQ(network.getTotalCost(), 8);
+}
+
+TEST(FlowNetwork, MinCostMatchesBruteForceAssignment)
+{
+  std::mt19937 generator(99);
+
+  for (size_t i = 0; i < 100; i++)
+  {
+    // A random square assignment problem: source -> runners -> hosts -> sink, all with unit capacity
+    const size_t                                  size = 1 + generator() % 6;
+    std::vector<std::vector<FlowNetwork::cost_t>> costs(size, std::vector<FlowNetwork::cost_t>(size));
+    for (auto &row : costs)
+      for (auto &cost : row) cost = generator() % 100;
+
+    const size_t source = 2 * size, sink = 2 * size + 1;
+    FlowNetwork  network(2 * size + 2);
+    for (size_t r = 0; r < size; r++) network.addEdge(source, r, 1);
+    for (size_t h = 0; h < size; h++) network.addEdge(size + h, sink, 1);
+    for (size_t r = 0; r < size; r++)
+      for (size_t h = 0; h < size; h++) network.addEdge(r, size + h, 1, costs[r][h]);
+
+    // Trying all permutations for the reference minimum cost
+    std::vector<size_t> permutation(size);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    auto bestCost = std::numeric_limits<FlowNetwork::cost_t>::max();
+    do {
+      FlowNetwork::cost_t cost = 0;
+      for (size_t r = 0; r < size; r++) cost += costs[r][permutation[r]];
+      bestCost = std::min(bestCost, cost);
+    } while (std::next_permutation(permutation.begin(), permutation.end()));
+
+    EXPECT_EQ(network.computeMinCostMaxFlow(source, sink), (FlowNetwork::capacity_t)size);
+    EXPECT_EQ(network.getTotalCost(), bestCost);
+  }
+}
+
+TEST(FlowNetwork, RejectsInvalidEdges)
+{
+  FlowNetwork network(2);
+  EXPECT_ANY_THROW(network.addEdge(0, 1, 1, -1));
+  EXPECT_ANY_THROW(network.addEdge(0, 2, 1));
+}
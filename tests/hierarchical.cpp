@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <set>
+#include <deployr/deployr.hpp>
+#include <deployr/local/engine.hpp>
+
+using deployr::DeployR;
+
+// Creates a topology with one NUMA domain holding a processing unit and a RAM memory space of the given size
+HiCR::Topology makeTopology(const size_t memorySpaceSize)
+{
+  const nlohmann::json device = {{"Type", "NUMA Domain"}, {"Compute Resources", {{{"Type", "Processing Unit"}}}}, {"Memory Spaces", {{{"Type", "RAM"}, {"Size", memorySpaceSize}}}}};
+  return HiCR::Topology(nlohmann::json{{"Devices", {device}}});
+}
+
+// The outcome of a hierarchical deployment, as seen by the global coordinator, and the instances each of its runners ran on
+struct hierarchicalResult_t
+{
+  bool                                                                              hasThrown   = false;
+  size_t                                                                            failedCount = 0;
+  std::map<deployr::Runner::runnerId_t, std::vector<HiCR::Instance::instanceId_t>> runnerInstanceIds;
+};
+
+// Deploys runners requesting the given memory space size through partitions of three instances each (a coordinator and two hosts), from the global coordinator (instance 0).
+// The hosts of each partition have the given memory space size
+hierarchicalResult_t deployHierarchically(const std::vector<size_t> &partitionMemorySpaceSizes, const size_t runnerCount, const size_t requestedMemorySpaceSize)
+{
+  std::vector<HiCR::Topology>       topologies = {makeTopology(1024)};
+  std::vector<DeployR::partition_t> partitions;
+  for (const auto size : partitionMemorySpaceSizes)
+  {
+    const auto coordinatorInstanceId = (HiCR::Instance::instanceId_t)topologies.size();
+    partitions.push_back({coordinatorInstanceId, {coordinatorInstanceId + 1, coordinatorInstanceId + 2}});
+    topologies.insert(topologies.end(), {makeTopology(1024), makeTopology(size), makeTopology(size)});
+  }
+
+  deployr::local::Engine engine(topologies);
+  hierarchicalResult_t   result;
+  std::mutex             resultMutex;
+
+  engine.run([&](deployr::local::InstanceManager &instanceManager, deployr::local::RPCEngine &rpcEngine, const HiCR::Topology &topology) {
+    DeployR deployr(&instanceManager, &rpcEngine, topology);
+    deployr.initialize();
+
+    const auto instanceId = instanceManager.getCurrentInstance()->getId();
+    deployr.registerFunction("Run", [&, instanceId]() {
+      std::unique_lock lock(resultMutex);
+      result.runnerInstanceIds[deployr.getRunnerId()].push_back(instanceId);
+    });
+
+    deployr::Deployment deployment;
+    if (instanceId == 0)
+    {
+      const auto topologyIdx = deployment.addTopology(makeTopology(requestedMemorySpaceSize));
+      for (size_t i = 0; i < runnerCount; i++) deployment.emplaceRunner(i, "Run", 0, topologyIdx);
+    }
+
+    // The other instances return once their part is done. Only the global coordinator learns whether the split was feasible
+    try
+    {
+      const auto handle = deployr.deployHierarchical(deployment, 0, partitions);
+      if (instanceId != 0) return;
+      handle->wait();
+      result.failedCount = handle->getFailedCount();
+    }
+    catch (const std::exception &)
+    {
+      if (instanceId != 0) throw;
+      result.hasThrown = true;
+    }
+    deployr.finalize();
+  });
+
+  return result;
+}
+
+TEST(Hierarchical, SplitsRunnersAmongPartitions)
+{
+  const auto result = deployHierarchically({8, 8}, 4, 8);
+
+  EXPECT_FALSE(result.hasThrown);
+  EXPECT_EQ(result.failedCount, 0u);
+  ASSERT_EQ(result.runnerInstanceIds.size(), 4u);
+
+  // Each runner ran once, on its own host
+  std::set<HiCR::Instance::instanceId_t> hostIds;
+  for (const auto &[runnerId, instanceIds] : result.runnerInstanceIds)
+  {
+    ASSERT_EQ(instanceIds.size(), 1u);
+    EXPECT_NE(instanceIds[0] % 3, 1u) << "Runner " << runnerId << " ran on a partition coordinator";
+    hostIds.insert(instanceIds[0]);
+  }
+  EXPECT_EQ(hostIds.size(), 4u);
+}
+
+TEST(Hierarchical, RejectsInfeasibleSplit)
+{
+  // The partitions only have four compatible hosts, and their hosts are released rather than left waiting
+  const auto result = deployHierarchically({8, 8}, 5, 8);
+
+  EXPECT_TRUE(result.hasThrown);
+  EXPECT_TRUE(result.runnerInstanceIds.empty());
+}
+
+TEST(Hierarchical, ReleasesPartitionWithEmptyShare)
+{
+  // Only the hosts of the second partition are large enough, so the first gets an empty share
+  const auto result = deployHierarchically({4, 8}, 2, 8);
+
+  EXPECT_FALSE(result.hasThrown);
+  EXPECT_EQ(result.failedCount, 0u);
+  ASSERT_EQ(result.runnerInstanceIds.size(), 2u);
+
+  std::set<HiCR::Instance::instanceId_t> hostIds;
+  for (const auto &[runnerId, instanceIds] : result.runnerInstanceIds)
+  {
+    ASSERT_EQ(instanceIds.size(), 1u);
+    hostIds.insert(instanceIds[0]);
+  }
+  EXPECT_EQ(hostIds, (std::set<HiCR::Instance::instanceId_t>{5, 6}));
+}
@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+#include <functional>
+#include <random>
+#include <deployr/incrementalMatcher.hpp>
+
+using deployr::IncrementalMatcher;
+
+// Creates a topology with one NUMA domain holding a processing unit and a RAM memory space of the given size. A host is compatible with a runner iff its size is no smaller
+HiCR::Topology makeTopology(const size_t memorySpaceSize)
+{
+  const nlohmann::json device = {{"Type", "NUMA Domain"}, {"Compute Resources", {{{"Type", "Processing Unit"}}}}, {"Memory Spaces", {{{"Type", "RAM"}, {"Size", memorySpaceSize}}}}};
+  return HiCR::Topology(nlohmann::json{{"Devices", {device}}});
+}
+
+std::vector<HiCR::Topology> makeTopologies(const std::vector<size_t> &memorySpaceSizes)
+{
+  std::vector<HiCR::Topology> topologies;
+  for (const auto size : memorySpaceSizes) topologies.push_back(makeTopology(size));
+  return topologies;
+}
+
+// Computes the size of a maximum matching of the runners to the active hosts with the simple augmenting path algorithm (Kuhn's), as reference
+size_t referenceMatchingSize(const std::vector<size_t> &requested, const std::vector<size_t> &given, const std::vector<bool> &isActive)
+{
+  std::vector<size_t>         hostPairs(given.size(), SIZE_MAX);
+  std::vector<bool>           visited;
+  std::function<bool(size_t)> augment = [&](const size_t runnerIdx) {
+    for (size_t hostIdx = 0; hostIdx < given.size(); hostIdx++)
+      if (isActive[hostIdx] && visited[hostIdx] == false && given[hostIdx] >= requested[runnerIdx])
+      {
+        visited[hostIdx] = true;
+        if (hostPairs[hostIdx] == SIZE_MAX || augment(hostPairs[hostIdx]))
+        {
+          hostPairs[hostIdx] = runnerIdx;
+          return true;
+        }
+      }
+    return false;
+  };
+
+  size_t matchCount = 0;
+  for (size_t runnerIdx = 0; runnerIdx < requested.size(); runnerIdx++)
+  {
+    visited.assign(given.size(), false);
+    if (augment(runnerIdx)) matchCount++;
+  }
+  return matchCount;
+}
+
+// Checks that the matching is a maximum one over the active hosts, and that the reported changes are exactly the runners whose host changed
+void checkMatching(const IncrementalMatcher                            &matcher,
+                   const std::vector<size_t>                           &requested,
+                   const std::vector<size_t>                           &given,
+                   const std::vector<size_t>                           &previousMatching,
+                   const std::vector<IncrementalMatcher::assignment_t> &changes)
+{
+  const auto       &matching = matcher.getMatching();
+  std::vector<bool> isActive(given.size());
+  for (size_t hostIdx = 0; hostIdx < given.size(); hostIdx++) isActive[hostIdx] = matcher.isHostActive(hostIdx);
+
+  size_t              matchCount = 0;
+  std::vector<size_t> hostRunnerCounts(given.size(), 0);
+  for (size_t runnerIdx = 0; runnerIdx < matching.size(); runnerIdx++)
+  {
+    if (matching[runnerIdx] == IncrementalMatcher::noHost) continue;
+    matchCount++;
+    ASSERT_LT(matching[runnerIdx], given.size());
+    EXPECT_TRUE(isActive[matching[runnerIdx]]);
+    EXPECT_GE(given[matching[runnerIdx]], requested[runnerIdx]);
+    EXPECT_EQ(++hostRunnerCounts[matching[runnerIdx]], 1u);
+  }
+  EXPECT_EQ(matchCount, referenceMatchingSize(requested, given, isActive));
+  EXPECT_EQ(matcher.isComplete(), matchCount == requested.size());
+
+  // Each runner is reported at most once, with its new host
+  std::vector<bool> isReported(matching.size(), false);
+  for (const auto &change : changes)
+  {
+    ASSERT_LT(change.runnerIdx, matching.size());
+    EXPECT_FALSE(isReported[change.runnerIdx]);
+    isReported[change.runnerIdx] = true;
+    EXPECT_EQ(change.hostIdx, matching[change.runnerIdx]);
+  }
+  for (size_t runnerIdx = 0; runnerIdx < matching.size(); runnerIdx++) EXPECT_EQ(isReported[runnerIdx], matching[runnerIdx] != previousMatching[runnerIdx]);
+}
+
+TEST(IncrementalMatcher, InitialMatchingIsMaximum)
+{
+  // The larger runner only fits on the first host, so the smaller one must take the second
+  const IncrementalMatcher matcher(makeTopologies({4, 8}), makeTopologies({8, 4}), 1);
+  EXPECT_TRUE(matcher.isComplete());
+  EXPECT_EQ(matcher.getMatching(), (std::vector<size_t>{1, 0}));
+  EXPECT_EQ(matcher.getHostCount(), 2u);
+}
+
+TEST(IncrementalMatcher, RemovingUnusedHostChangesNothing)
+{
+  IncrementalMatcher matcher(makeTopologies({4}), makeTopologies({8, 8}), 1);
+  const auto         unusedHostIdx = 1 - matcher.getMatching()[0];
+  const auto         matching      = matcher.getMatching();
+
+  EXPECT_TRUE(matcher.removeHost(unusedHostIdx).empty());
+  EXPECT_FALSE(matcher.isHostActive(unusedHostIdx));
+  EXPECT_EQ(matcher.getMatching(), matching);
+  EXPECT_TRUE(matcher.isComplete());
+}
+
+TEST(IncrementalMatcher, RemovingHostMovesRunnersAlongAugmentingPath)
+{
+  // Hosts 0 and 2 fit both runners, host 1 only the small one. Whichever host the large runner loses, it can only get back one by moving the small runner
+  const std::vector<size_t> requested = {4, 8};
+  const std::vector<size_t> given     = {8, 4, 8};
+  IncrementalMatcher        matcher(makeTopologies(requested), makeTopologies(given), 1);
+  ASSERT_TRUE(matcher.isComplete());
+
+  // Removing the host of the large runner, and then the other large host, if still active
+  auto matching = matcher.getMatching();
+  auto changes  = matcher.removeHost(matching[1]);
+  checkMatching(matcher, requested, given, matching, changes);
+  EXPECT_TRUE(matcher.isComplete());
+
+  matching = matcher.getMatching();
+  changes  = matcher.removeHost(matching[1]);
+  checkMatching(matcher, requested, given, matching, changes);
+  EXPECT_FALSE(matcher.isComplete());
+  EXPECT_EQ(matcher.getMatching()[0], 1u);
+}
+
+TEST(IncrementalMatcher, RemovingLastCompatibleHostReportsNoHost)
+{
+  IncrementalMatcher matcher(makeTopologies({8}), makeTopologies({8, 4}), 1);
+  ASSERT_EQ(matcher.getMatching()[0], 0u);
+
+  const auto changes = matcher.removeHost(0);
+  ASSERT_EQ(changes.size(), 1u);
+  EXPECT_EQ(changes[0].runnerIdx, 0u);
+  EXPECT_EQ(changes[0].hostIdx, IncrementalMatcher::noHost);
+  EXPECT_EQ(matcher.getMatching()[0], IncrementalMatcher::noHost);
+  EXPECT_FALSE(matcher.isComplete());
+}
+
+TEST(IncrementalMatcher, AddingHostAssignsWaitingRunner)
+{
+  IncrementalMatcher matcher(makeTopologies({8}), makeTopologies({4}), 1);
+  EXPECT_FALSE(matcher.isComplete());
+
+  // The added host takes the next index
+  const auto changes = matcher.addHost(makeTopology(8));
+  ASSERT_EQ(changes.size(), 1u);
+  EXPECT_EQ(changes[0].runnerIdx, 0u);
+  EXPECT_EQ(changes[0].hostIdx, 1u);
+  EXPECT_EQ(matcher.getHostCount(), 2u);
+  EXPECT_TRUE(matcher.isComplete());
+
+  // A complete matching is left as is
+  EXPECT_TRUE(matcher.addHost(makeTopology(8)).empty());
+}
+
+TEST(IncrementalMatcher, AddingHostMovesRunnersAlongAugmentingPath)
+{
+  // Both runners compete for the large host. A small host lets the small runner leave it for the large one, if it holds it
+  const std::vector<size_t> requested = {4, 8};
+  std::vector<size_t>       given     = {8};
+  IncrementalMatcher        matcher(makeTopologies(requested), makeTopologies(given), 1);
+  EXPECT_FALSE(matcher.isComplete());
+
+  const auto matching = matcher.getMatching();
+  given.push_back(4);
+  const auto changes = matcher.addHost(makeTopology(4));
+  checkMatching(matcher, requested, given, matching, changes);
+  EXPECT_EQ(matcher.getMatching(), (std::vector<size_t>{1, 0}));
+}
+
+TEST(IncrementalMatcher, RemovedHostsAreNotReused)
+{
+  IncrementalMatcher matcher(makeTopologies({4}), makeTopologies({8}), 1);
+  const auto         changes = matcher.removeHost(0);
+  ASSERT_EQ(changes.size(), 1u);
+  EXPECT_EQ(changes[0].hostIdx, IncrementalMatcher::noHost);
+
+  const auto addChanges = matcher.addHost(makeTopology(8));
+  ASSERT_EQ(addChanges.size(), 1u);
+  EXPECT_EQ(addChanges[0].hostIdx, 1u);
+  EXPECT_FALSE(matcher.isHostActive(0));
+  EXPECT_TRUE(matcher.isHostActive(1));
+}
+
+TEST(IncrementalMatcher, RejectsRemovingInactiveHost)
+{
+  IncrementalMatcher matcher(makeTopologies({4}), makeTopologies({8, 8}), 1);
+  EXPECT_ANY_THROW((void)matcher.removeHost(2));
+
+  (void)matcher.removeHost(0);
+  EXPECT_ANY_THROW((void)matcher.removeHost(0));
+}
+
+TEST(IncrementalMatcher, StaysMaximumUnderRandomChanges)
+{
+  std::mt19937 generator(42);
+  for (size_t trial = 0; trial < 20; trial++)
+  {
+    std::vector<size_t> requested(1 + generator() % 12), given(generator() % 12);
+    for (auto &size : requested) size = 1 + generator() % 8;
+    for (auto &size : given) size = 1 + generator() % 8;
+
+    IncrementalMatcher matcher(makeTopologies(requested), makeTopologies(given), 1);
+    checkMatching(matcher, requested, given, matcher.getMatching(), {});
+    if (HasFailure()) return;
+
+    // Removing a random active host or adding a random one
+    for (size_t step = 0; step < 30; step++)
+    {
+      std::vector<size_t> activeHostIdxs;
+      for (size_t hostIdx = 0; hostIdx < given.size(); hostIdx++)
+        if (matcher.isHostActive(hostIdx)) activeHostIdxs.push_back(hostIdx);
+
+      const auto                                    matching = matcher.getMatching();
+      std::vector<IncrementalMatcher::assignment_t> changes;
+      if (activeHostIdxs.empty() == false && generator() % 2 == 0) changes = matcher.removeHost(activeHostIdxs[generator() % activeHostIdxs.size()]);
+      else
+      {
+        given.push_back(1 + generator() % 8);
+        changes = matcher.addHost(makeTopology(given.back()));
+      }
+
+      // Runners left without a host are reported as such, so they count as changed
+      checkMatching(matcher, requested, given, matching, changes);
+      if (HasFailure()) return;
+    }
+  }
+}
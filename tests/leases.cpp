@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <deployr/deployr.hpp>
+#include <deployr/local/engine.hpp>
+
+// Creates a topology with one NUMA domain holding a processing unit and a RAM memory space
+HiCR::Topology makeTopology()
+{
+  const nlohmann::json device = {{"Type", "NUMA Domain"}, {"Compute Resources", {{{"Type", "Processing Unit"}}}}, {"Memory Spaces", {{{"Type", "RAM"}, {"Size", 1024}}}}};
+  return HiCR::Topology(nlohmann::json{{"Devices", {device}}});
+}
+
+// The number of failed runners of a deployment, the instances each of its runners ran on, and the failed hosts, as seen by the coordinator
+struct crashResult_t
+{
+  size_t                                                                            failedCount = 0;
+  std::map<deployr::Runner::runnerId_t, std::vector<HiCR::Instance::instanceId_t>> runnerInstanceIds;
+  std::unordered_set<HiCR::Instance::instanceId_t>                                  failedInstanceIds;
+};
+
+// Deploys one runner on each of the hosts (instances 1 to hostCount) under leases, from the coordinator (instance 0). The runner on instance 1 crashes its host.
+// The instances after the hosts are spare
+crashResult_t deployAndCrash(const size_t hostCount, const size_t spareHostCount)
+{
+  deployr::local::Engine                    engine(std::vector<HiCR::Topology>(1 + hostCount + spareHostCount, makeTopology()));
+  std::vector<HiCR::Instance::instanceId_t> spareInstanceIds;
+  for (size_t i = 0; i < spareHostCount; i++) spareInstanceIds.push_back(1 + hostCount + i);
+
+  crashResult_t result;
+  std::mutex    resultMutex;
+
+  engine.run([&](deployr::local::InstanceManager &instanceManager, deployr::local::RPCEngine &rpcEngine, const HiCR::Topology &topology) {
+    deployr::DeployR deployr(&instanceManager, &rpcEngine, topology);
+    deployr.initialize();
+
+    const auto instanceId = instanceManager.getCurrentInstance()->getId();
+    deployr.registerFunction("Run", [&, instanceId]() {
+      {
+        std::unique_lock lock(resultMutex);
+        result.runnerInstanceIds[deployr.getRunnerId()].push_back(instanceId);
+      }
+
+      // The host stops answering right away, so that it does not report its runner nor renew its lease
+      if (instanceId == 1) engine.crashInstance(1);
+    });
+
+    // The spare hosts serve until the coordinator is done
+    if (instanceId > hostCount)
+    {
+      deployr.serve(0);
+      return;
+    }
+
+    deployr::Deployment deployment;
+    if (instanceId == 0)
+    {
+      deployr.setLeases(std::chrono::milliseconds(5), std::chrono::milliseconds(200));
+      deployr.addSpareHosts(spareInstanceIds, std::vector<HiCR::Topology>(spareHostCount, makeTopology()));
+      for (size_t i = 1; i <= hostCount; i++) deployment.emplaceRunner(i, "Run", i);
+    }
+
+    const auto handle = deployr.deployAsync(deployment, 0, deployr::DeployR::launchMode_t::batchedLaunch);
+    if (instanceId != 0) return;
+
+    handle->wait();
+    result.failedCount       = handle->getFailedCount();
+    result.failedInstanceIds = deployr.getFailedInstanceIds();
+    deployr.finalize();
+    deployr.shutdownWorkers(spareInstanceIds);
+  });
+
+  return result;
+}
+
+TEST(Leases, RespawnsRunnersOfCrashedHostOnSpareHost)
+{
+  const auto result = deployAndCrash(2, 1);
+
+  EXPECT_EQ(result.failedCount, 0u);
+  EXPECT_EQ(result.failedInstanceIds, (std::unordered_set<HiCR::Instance::instanceId_t>{1}));
+  EXPECT_EQ(result.runnerInstanceIds.at(1), (std::vector<HiCR::Instance::instanceId_t>{1, 3}));
+  EXPECT_EQ(result.runnerInstanceIds.at(2), (std::vector<HiCR::Instance::instanceId_t>{2}));
+}
+
+TEST(Leases, FailsRunnersNoSpareHostCanTake)
+{
+  // Waiting for the deployment does not hang, although the runner of the crashed host can run nowhere else
+  const auto result = deployAndCrash(2, 0);
+
+  EXPECT_EQ(result.failedCount, 1u);
+  EXPECT_EQ(result.failedInstanceIds, (std::unordered_set<HiCR::Instance::instanceId_t>{1}));
+  EXPECT_EQ(result.runnerInstanceIds.at(1), (std::vector<HiCR::Instance::instanceId_t>{1}));
+  EXPECT_EQ(result.runnerInstanceIds.at(2), (std::vector<HiCR::Instance::instanceId_t>{2}));
+}
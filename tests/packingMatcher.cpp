@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <deployr/packingMatcher.hpp>
+
+using deployr::PackingMatcher;
+
+// Creates a topology with one device of the given type, holding the given number of processing units and memory spaces of the given types and sizes
+HiCR::Topology makeTopology(const size_t processingUnitCount, const std::vector<std::pair<std::string, size_t>> &memorySpaces, const std::string &deviceType = "NUMA Domain")
+{
+  auto computeResources = nlohmann::json::array();
+  for (size_t i = 0; i < processingUnitCount; i++) computeResources.push_back({{"Type", "Processing Unit"}});
+  auto memorySpaceList = nlohmann::json::array();
+  for (const auto &[type, size] : memorySpaces) memorySpaceList.push_back({{"Type", type}, {"Size", size}});
+  const nlohmann::json device = {{"Type", deviceType}, {"Compute Resources", computeResources}, {"Memory Spaces", memorySpaceList}};
+  return HiCR::Topology(nlohmann::json{{"Devices", {device}}});
+}
+
+TEST(PackingMatcher, PacksRunnersByComputeResources)
+{
+  PackingMatcher matcher({makeTopology(4, {{"RAM", 64}})});
+
+  const auto partitions = matcher.pack(std::vector<HiCR::Topology>(4, makeTopology(1, {})));
+  ASSERT_EQ(partitions.size(), 4u);
+  for (const auto &partition : partitions)
+  {
+    EXPECT_EQ(partition.hostIdx, 0u);
+    EXPECT_EQ(partition.computeResources.size(), 1u);
+  }
+  EXPECT_EQ(matcher.getFreeComputeResourceCount(0), 0u);
+}
+
+TEST(PackingMatcher, DividesMemorySpacesBySize)
+{
+  PackingMatcher matcher({makeTopology(4, {{"RAM", 10}}), makeTopology(4, {{"RAM", 10}})});
+
+  // Only two of the runners fit in the memory of each host, although its compute resources would fit all of them
+  const auto partitions = matcher.pack(std::vector<HiCR::Topology>(3, makeTopology(1, {{"RAM", 4}})));
+  ASSERT_EQ(partitions.size(), 3u);
+  EXPECT_EQ(partitions[0].hostIdx, 0u);
+  EXPECT_EQ(partitions[1].hostIdx, 0u);
+  EXPECT_EQ(partitions[2].hostIdx, 1u);
+  ASSERT_EQ(partitions[2].memoryShares.size(), 1u);
+  EXPECT_EQ(partitions[2].memoryShares[0].size, 4u);
+}
+
+TEST(PackingMatcher, FailedPackTakesNothing)
+{
+  PackingMatcher matcher({makeTopology(2, {})});
+
+  EXPECT_TRUE(matcher.pack(std::vector<HiCR::Topology>(3, makeTopology(1, {}))).empty());
+  EXPECT_EQ(matcher.getFreeComputeResourceCount(0), 2u);
+  EXPECT_EQ(matcher.pack(std::vector<HiCR::Topology>(2, makeTopology(1, {}))).size(), 2u);
+}
+
+TEST(PackingMatcher, ReleaseGivesResourcesBack)
+{
+  PackingMatcher matcher({makeTopology(2, {{"RAM", 8}})});
+
+  auto partitions = matcher.pack({makeTopology(2, {{"RAM", 8}})});
+  ASSERT_EQ(partitions.size(), 1u);
+  EXPECT_TRUE(matcher.pack({makeTopology(1, {})}).empty());
+
+  // The capacity kept between calls lets a later deployment use what was released
+  matcher.release(partitions[0]);
+  EXPECT_EQ(matcher.getFreeComputeResourceCount(0), 2u);
+  EXPECT_EQ(matcher.pack({makeTopology(2, {{"RAM", 8}})}).size(), 1u);
+}
+
+TEST(PackingMatcher, PlacesLargestRequestsFirst)
+{
+  // Placing the small runners first on the first host would leave no host for the large one
+  PackingMatcher matcher({makeTopology(3, {}), makeTopology(3, {})});
+
+  const auto partitions = matcher.pack({makeTopology(1, {}), makeTopology(1, {}), makeTopology(1, {}), makeTopology(3, {})});
+  ASSERT_EQ(partitions.size(), 4u);
+  EXPECT_EQ(partitions[3].hostIdx, 0u);
+  for (size_t i = 0; i < 3; i++) EXPECT_EQ(partitions[i].hostIdx, 1u);
+}
+
+TEST(PackingMatcher, RejectsResourcesNoHostHas)
+{
+  PackingMatcher matcher({makeTopology(2, {{"RAM", 8}})});
+
+  EXPECT_TRUE(matcher.pack({makeTopology(1, {}, "GPU")}).empty());
+  EXPECT_TRUE(matcher.pack({makeTopology(1, {{"HBM", 4}})}).empty());
+  EXPECT_EQ(matcher.getFreeComputeResourceCount(0), 2u);
+}
+
+TEST(PackingMatcher, EmptyMemorySpaceOfUnknownKindTakesNothing)
+{
+  PackingMatcher matcher({makeTopology(2, {{"RAM", 8}})});
+
+  // A zero-size request of a memory space kind no host has is satisfiable, so it must be placed, alongside the resources that do exist
+  const auto partitions = matcher.pack({makeTopology(1, {{"HBM", 0}, {"RAM", 8}})});
+  ASSERT_EQ(partitions.size(), 1u);
+  EXPECT_EQ(partitions[0].hostIdx, 0u);
+  EXPECT_EQ(partitions[0].computeResources.size(), 1u);
+  ASSERT_EQ(partitions[0].memoryShares.size(), 1u);
+  EXPECT_EQ(partitions[0].memoryShares[0].size, 8u);
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include <deployr/partitionSummary.hpp>
+
+using deployr::PartitionSummary;
+
+// Creates a topology with one NUMA domain holding a processing unit and a RAM memory space of the given size
+HiCR::Topology makeTopology(const size_t memorySpaceSize)
+{
+  const nlohmann::json device = {{"Type", "NUMA Domain"}, {"Compute Resources", {{{"Type", "Processing Unit"}}}}, {"Memory Spaces", {{{"Type", "RAM"}, {"Size", memorySpaceSize}}}}};
+  return HiCR::Topology(nlohmann::json{{"Devices", {device}}});
+}
+
+TEST(PartitionSummary, EmptyPartitionHasNoHosts)
+{
+  const PartitionSummary summary;
+  EXPECT_TRUE(summary.getTopologies().empty());
+  EXPECT_EQ(summary.getHostCount(), 0u);
+
+  // It still round-trips, as sent by a partition without hosts
+  EXPECT_EQ(PartitionSummary(summary.serialize()).getHostCount(), 0u);
+}
+
+TEST(PartitionSummary, CountsHostsOfAllClasses)
+{
+  const PartitionSummary summary({makeTopology(8), makeTopology(16)}, {3, 5});
+  EXPECT_EQ(summary.getTopologies().size(), 2u);
+  EXPECT_EQ(summary.getHostCounts(), (std::vector<size_t>{3, 5}));
+  EXPECT_EQ(summary.getHostCount(), 8u);
+}
+
+TEST(PartitionSummary, RejectsMismatchedHostCounts)
+{
+  EXPECT_ANY_THROW(PartitionSummary({makeTopology(8), makeTopology(16)}, {3}));
+  EXPECT_ANY_THROW(PartitionSummary({makeTopology(8)}, {3, 5}));
+}
+
+TEST(PartitionSummary, SerializationRoundTrips)
+{
+  const PartitionSummary summary({makeTopology(8), makeTopology(16), makeTopology(32)}, {1, 4, 2});
+  const PartitionSummary deserialized(summary.serialize());
+
+  ASSERT_EQ(deserialized.getTopologies().size(), 3u);
+  for (size_t i = 0; i < 3; i++) EXPECT_EQ(deserialized.getTopologies()[i].serialize(), summary.getTopologies()[i].serialize());
+  EXPECT_EQ(deserialized.getHostCounts(), summary.getHostCounts());
+  EXPECT_EQ(deserialized.serialize(), summary.serialize());
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <deployr/resourceSignatures.hpp>
+
+using deployr::ResourceSignatures;
+
+// Creates a topology with one NUMA domain holding a processing unit and the given RAM memory spaces
+HiCR::Topology makeTopology(const std::vector<size_t> &memorySpaceSizes)
+{
+  auto memorySpaces = nlohmann::json::array();
+  for (const auto size : memorySpaceSizes) memorySpaces.push_back({{"Type", "RAM"}, {"Size", size}});
+  const nlohmann::json device = {{"Type", "NUMA Domain"}, {"Compute Resources", {{{"Type", "Processing Unit"}}}}, {"Memory Spaces", memorySpaces}};
+  return HiCR::Topology(nlohmann::json{{"Devices", {device}}});
+}
+
+TEST(ResourceSignatures, MemoryDimensionIsLargestMemorySpace)
+{
+  const ResourceSignatures signatures({makeTopology({1, 4})}, {makeTopology({2, 8, 3})});
+
+  const auto &dimensions      = signatures.getDimensions();
+  const auto  memoryDimension = std::find(dimensions.begin(), dimensions.end(), "Largest Memory Space/NUMA Domain/RAM");
+  ASSERT_NE(memoryDimension, dimensions.end());
+  const size_t d = memoryDimension - dimensions.begin();
+
+  EXPECT_EQ(signatures.getRequestedSignature(0)[d], 4u);
+  EXPECT_EQ(signatures.getGivenSignature(0)[d], 8u);
+}
+
+TEST(ResourceSignatures, MemoryIsNotAddedUp)
+{
+  // The requested memory spaces add up to more than the given one, but each of them fits within it
+  const ResourceSignatures signatures({makeTopology({4, 4})}, {makeTopology({6})});
+  EXPECT_TRUE(signatures.mayContain(0, 0));
+}
+
+TEST(ResourceSignatures, RejectsTooSmallMemorySpace)
+{
+  // The given memory spaces add up to more than the requested one, but none of them is large enough
+  const ResourceSignatures signatures({makeTopology({8})}, {makeTopology({6, 6})});
+  EXPECT_FALSE(signatures.mayContain(0, 0));
+}
+
+TEST(ResourceSignatures, RejectsMissingDevices)
+{
+  const auto               given     = makeTopology({8});
+  const auto               requested = HiCR::Topology(nlohmann::json{{"Devices", {given.serialize()["Devices"][0], given.serialize()["Devices"][0]}}});
+  const ResourceSignatures signatures({requested}, {given});
+  EXPECT_FALSE(signatures.mayContain(0, 0));
+  EXPECT_TRUE(ResourceSignatures({given}, {requested}).mayContain(0, 0));
+}
+
+TEST(ResourceSignatures, IsNecessaryForSubset)
+{
+  // Whenever a given topology contains a requested one, the signatures must agree
+  std::mt19937 generator(42);
+  const auto   makeRandomTopology = [&]() {
+    std::vector<size_t> sizes(generator() % 4);
+    for (auto &size : sizes) size = 1 + generator() % 8;
+    return makeTopology(sizes);
+  };
+
+  for (size_t i = 0; i < 1000; i++)
+  {
+    const auto               requested = makeRandomTopology();
+    const auto               given     = makeRandomTopology();
+    const ResourceSignatures signatures({requested}, {given});
+    if (HiCR::Topology::isSubset(given, requested) == false) continue;
+    EXPECT_TRUE(signatures.mayContain(0, 0));
+  }
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <deployr/topologyCache.hpp>
+
+using deployr::TopologyCache;
+
+// Creates a topology with one NUMA domain holding a processing unit and a RAM memory space of the given size
+HiCR::Topology makeTopology(const size_t memorySpaceSize)
+{
+  const nlohmann::json device = {{"Type", "NUMA Domain"}, {"Compute Resources", {{{"Type", "Processing Unit"}}}}, {"Memory Spaces", {{{"Type", "RAM"}, {"Size", memorySpaceSize}}}}};
+  return HiCR::Topology(nlohmann::json{{"Devices", {device}}});
+}
+
+TEST(TopologyCache, FingerprintDependsOnContentsOnly)
+{
+  EXPECT_EQ(TopologyCache::fingerprint(makeTopology(8)), TopologyCache::fingerprint(makeTopology(8)));
+  EXPECT_NE(TopologyCache::fingerprint(makeTopology(8)), TopologyCache::fingerprint(makeTopology(16)));
+  EXPECT_EQ(TopologyCache::fingerprint(makeTopology(8)), TopologyCache::fingerprint(makeTopology(8).serialize()));
+}
+
+TEST(TopologyCache, FingerprintFitsIn56BitsAndIsNeverEmpty)
+{
+  for (size_t size = 0; size < 1000; size++)
+  {
+    const auto fingerprint = TopologyCache::fingerprint(makeTopology(size));
+    EXPECT_NE(fingerprint, TopologyCache::noFingerprint);
+    EXPECT_EQ(fingerprint >> 56, 0u);
+  }
+}
+
+TEST(TopologyCache, UnknownInstanceHasNoTopology)
+{
+  const TopologyCache cache;
+  EXPECT_EQ(cache.getFingerprint(3), TopologyCache::noFingerprint);
+  EXPECT_ANY_THROW((void)cache.getTopology(3));
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(TopologyCache, UpdateReplacesTopology)
+{
+  TopologyCache cache;
+  cache.update(3, TopologyCache::fingerprint(makeTopology(8)), makeTopology(8));
+  EXPECT_EQ(cache.getFingerprint(3), TopologyCache::fingerprint(makeTopology(8)));
+  EXPECT_EQ(cache.getTopology(3).serialize(), makeTopology(8).serialize());
+
+  cache.update(3, TopologyCache::fingerprint(makeTopology(16)), makeTopology(16));
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.getFingerprint(3), TopologyCache::fingerprint(makeTopology(16)));
+  EXPECT_EQ(cache.getTopology(3).serialize(), makeTopology(16).serialize());
+}
+
+TEST(TopologyCache, EraseAndClearForgetTopologies)
+{
+  TopologyCache cache;
+  cache.update(1, TopologyCache::fingerprint(makeTopology(8)), makeTopology(8));
+  cache.update(2, TopologyCache::fingerprint(makeTopology(16)), makeTopology(16));
+  cache.update(3, TopologyCache::fingerprint(makeTopology(32)), makeTopology(32));
+
+  // Erasing an unknown instance does nothing
+  cache.erase(4);
+  cache.erase(2);
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.getFingerprint(2), TopologyCache::noFingerprint);
+  EXPECT_EQ(cache.getFingerprint(1), TopologyCache::fingerprint(makeTopology(8)));
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(cache.getFingerprint(1), TopologyCache::noFingerprint);
+}
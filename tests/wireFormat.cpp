@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include <deployr/wireFormat.hpp>
+
+using deployr::WireFormat;
+
+// A message shaped like the topologies exchanged among instances
+const nlohmann::json message = {{"Devices", {{{"Type", "NUMA Domain"}, {"Compute Resources", nlohmann::json::array()}, {"Memory Spaces", {{{"Size", 1024}}}}}}}};
+
+TEST(WireFormat, JSONRoundTrip)
+{
+  const auto buffer = WireFormat::encode(message, WireFormat::encoding_t::json);
+  EXPECT_EQ(buffer, message.dump());
+  EXPECT_EQ(WireFormat::decode(buffer.data(), buffer.size(), WireFormat::encoding_t::json), message);
+}
+
+TEST(WireFormat, CBORRoundTrip)
+{
+  const auto buffer = WireFormat::encode(message, WireFormat::encoding_t::cbor);
+  EXPECT_EQ(WireFormat::decode(buffer.data(), buffer.size(), WireFormat::encoding_t::cbor), message);
+}
+
+TEST(WireFormat, JSONTrailingNULIsIgnored)
+{
+  // Previous DeployR versions sent the NUL terminator along with the message
+  const auto buffer = message.dump();
+  EXPECT_EQ(WireFormat::decode(buffer.c_str(), buffer.size() + 1, WireFormat::encoding_t::json), message);
+}
+
+TEST(WireFormat, UnknownEncodingThrows)
+{
+  const auto unknownEncoding = (WireFormat::encoding_t)255;
+  const auto buffer          = message.dump();
+
+  EXPECT_ANY_THROW((void)WireFormat::encode(message, unknownEncoding));
+  EXPECT_ANY_THROW((void)WireFormat::decode(buffer.data(), buffer.size(), unknownEncoding));
+}